@@ -0,0 +1,100 @@
+// Measures the throughput (players per second) of GamepadStateBatch compared to one GamepadStateTracker per player.
+// Usage: benchmark_GamepadStateBatch [playerCount] [frameCount]
+
+#include <input/GamepadStateBatch.hpp>
+
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <random>
+#include <vector>
+
+using namespace input;
+
+namespace
+{
+
+using Clock = std::chrono::steady_clock;
+
+// Random states for a number of frames, so that buttons are pressed and released.
+std::vector<Gamepad::State> makeStates( size_t count )
+{
+    std::mt19937                          rng { 42 };
+    std::uniform_real_distribution<float> axis { -1.0f, 1.0f };
+    std::uniform_real_distribution<float> trigger { 0.0f, 1.0f };
+
+    std::vector<Gamepad::State> states( count );
+    for ( auto& state: states )
+    {
+        state.connected = true;
+        state.packet    = rng();
+        UnpackGamepadButtons( static_cast<uint32_t>( rng() ), state );
+        state.thumbSticks = { axis( rng ), axis( rng ), axis( rng ), axis( rng ) };
+        state.triggers    = { trigger( rng ), trigger( rng ) };
+    }
+
+    return states;
+}
+
+template<typename Func>
+void run( const char* name, size_t playerCount, size_t frameCount, Func&& func )
+{
+    const auto start = Clock::now();
+
+    for ( size_t frame = 0; frame < frameCount; ++frame )
+        func( frame );
+
+    const double seconds = std::chrono::duration<double>( Clock::now() - start ).count();
+    const double players = static_cast<double>( playerCount ) * static_cast<double>( frameCount );
+
+    std::printf( "%-32s %10.3f ms %12.1f M players/s\n", name, seconds * 1000.0, players / seconds / 1e6 );
+}
+
+}  // namespace
+
+int main( int argc, char* argv[] )
+{
+    const size_t playerCount = argc > 1 ? std::strtoull( argv[1], nullptr, 10 ) : 10000;
+    const size_t frameCount  = argc > 2 ? std::strtoull( argv[2], nullptr, 10 ) : 1000;
+
+    // A few frames of input that are cycled through.
+    constexpr size_t            STATE_FRAMES = 4;
+    std::vector<Gamepad::State> states       = makeStates( playerCount * STATE_FRAMES );
+
+    auto frameStates = [&]( size_t frame ) {
+        return std::span<const Gamepad::State> { states.data() + ( frame % STATE_FRAMES ) * playerCount, playerCount };
+    };
+
+    std::printf( "%zu players, %zu frames\n", playerCount, frameCount );
+
+    uint64_t checksum = 0;
+
+    std::vector<GamepadStateTracker> trackers( playerCount );
+    run( "GamepadStateTracker::update", playerCount, frameCount, [&]( size_t frame ) {
+        const auto s = frameStates( frame );
+        for ( size_t i = 0; i < playerCount; ++i )
+            trackers[i].update( s[i] );
+
+        checksum += static_cast<uint64_t>( trackers[frame % playerCount].a );
+    } );
+
+    GamepadStateBatch batch { playerCount };
+    run( "GamepadStateBatch::setStates", playerCount, frameCount, [&]( size_t frame ) {
+        batch.setStates( frameStates( frame ) );
+    } );
+
+    run( "GamepadStateBatch::update", playerCount, frameCount, [&]( size_t frame ) {
+        batch.update();
+        checksum += batch.getPressed( frame % playerCount );
+    } );
+
+    run( "GamepadStateBatch (set + update)", playerCount, frameCount, [&]( size_t frame ) {
+        batch.setStates( frameStates( frame ) );
+        batch.update();
+        checksum += batch.getPressed( frame % playerCount );
+    } );
+
+    std::printf( "checksum: %llu\n", static_cast<unsigned long long>( checksum ) );
+
+    return 0;
+}
@@ -0,0 +1,336 @@
+// Microbenchmarks of the state trackers, the stick dead zones, the name queries, and the update of a frame.
+// The results are written to stdout as JSON (the default) or CSV, so they can be compared across releases.
+// Usage: input_bench [json|csv] [iterationCount]
+//
+// Linked against the Virtual backend, Input::update is measured with 0, 1, and 8 injected gamepads.
+// With the other backends, the same processing is measured with InputContext::update and explicit states.
+
+#include <input/Input.hpp>
+#include <input/InputContext.hpp>
+#include <input/StickProcessor.hpp>
+
+#ifdef INPUT_BENCHMARK_VIRTUAL
+    #include <input/Virtual.hpp>
+#endif
+
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <random>
+#include <string>
+#include <vector>
+
+using namespace input;
+
+namespace
+{
+
+using Clock = std::chrono::steady_clock;
+
+// The number of times each benchmark is repeated. The median and the fastest repetition are reported.
+constexpr size_t REPETITIONS = 5;
+
+// The number of different states that are cycled through, so that the trackers see presses and releases.
+constexpr size_t STATE_FRAMES = 4;
+
+struct Result
+{
+    std::string name;
+    std::string param;
+    size_t      iterations;
+    double      medianTime;  ///< Nanoseconds per iteration.
+    double      minTime;
+};
+
+std::vector<Result> g_Results;
+uint64_t            g_Checksum = 0;
+
+template<typename Func>
+void run( const char* name, std::string param, size_t iterations, Func&& func )
+{
+    // Warm up the caches and the branch predictors.
+    for ( size_t i = 0; i < std::min<size_t>( iterations, 1000 ); ++i )
+        func( i );
+
+    double times[REPETITIONS];
+    for ( auto& time: times )
+    {
+        const auto start = Clock::now();
+
+        for ( size_t i = 0; i < iterations; ++i )
+            func( i );
+
+        time = std::chrono::duration<double, std::nano>( Clock::now() - start ).count() / static_cast<double>( iterations );
+    }
+
+    std::sort( std::begin( times ), std::end( times ) );
+    g_Results.push_back( { name, std::move( param ), iterations, times[REPETITIONS / 2], times[0] } );
+}
+
+Keyboard::State makeKeyboardState( std::mt19937& rng )
+{
+    Keyboard::State state {};
+
+    // A few keys are held in each frame.
+    auto ptr = reinterpret_cast<uint32_t*>( &state );
+    for ( int i = 0; i < 4; ++i )
+    {
+        const uint32_t key = rng() % 256;
+        ptr[key >> 5] |= 1u << ( key & 0x1f );
+    }
+
+    return state;
+}
+
+Mouse::State makeMouseState( std::mt19937& rng )
+{
+    std::uniform_real_distribution<float> position { 0.0f, 1920.0f };
+
+    Mouse::State state {};
+    state.leftButton       = rng() & 1;
+    state.middleButton     = rng() & 1;
+    state.rightButton      = rng() & 1;
+    state.xButton1         = rng() & 1;
+    state.xButton2         = rng() & 1;
+    state.x                = position( rng );
+    state.y                = position( rng );
+    state.scrollWheelValue = static_cast<int64_t>( rng() % 8 ) * 120;
+
+    return state;
+}
+
+Gamepad::State makeGamepadState( std::mt19937& rng )
+{
+    std::uniform_real_distribution<float> axis { -1.0f, 1.0f };
+    std::uniform_real_distribution<float> trigger { 0.0f, 1.0f };
+
+    Gamepad::State state {};
+    state.connected = true;
+    state.packet    = rng();
+    UnpackGamepadButtons( static_cast<uint32_t>( rng() ), state );
+    state.thumbSticks = { axis( rng ), axis( rng ), axis( rng ), axis( rng ) };
+    state.triggers    = { trigger( rng ), trigger( rng ) };
+
+    return state;
+}
+
+// The touches begin in the first frame, move in the following frames, and end in the last frame.
+Touch::State makeTouchState( std::mt19937& rng, size_t touchCount, size_t frame )
+{
+    std::uniform_real_distribution<float> position { 0.0f, 1.0f };
+
+    const Touch::Phase phase = frame == 0 ? Touch::Phase::Began : frame == STATE_FRAMES - 1 ? Touch::Phase::Ended : Touch::Phase::Moved;
+
+    Touch::State state {};
+    for ( size_t i = 0; i < touchCount; ++i )
+        state.touches.push_back( { i + 1, frame * 16'000'000, position( rng ), position( rng ), 1.0f, phase } );
+
+    return state;
+}
+
+void benchmarkTrackers( size_t iterations )
+{
+    std::mt19937 rng { 42 };
+
+    Keyboard::State keyboardStates[STATE_FRAMES];
+    Mouse::State    mouseStates[STATE_FRAMES];
+    Gamepad::State  gamepadStates[STATE_FRAMES];
+    for ( size_t i = 0; i < STATE_FRAMES; ++i )
+    {
+        keyboardStates[i] = makeKeyboardState( rng );
+        mouseStates[i]    = makeMouseState( rng );
+        gamepadStates[i]  = makeGamepadState( rng );
+    }
+
+    KeyboardStateTracker keyboard;
+    run( "KeyboardStateTracker::update", "", iterations, [&]( size_t i ) {
+        keyboard.update( keyboardStates[i % STATE_FRAMES] );
+        g_Checksum += keyboard.pressed.isKeyDown( Keyboard::Key::A );
+    } );
+
+    MouseStateTracker mouse;
+    run( "MouseStateTracker::update", "", iterations, [&]( size_t i ) {
+        mouse.update( mouseStates[i % STATE_FRAMES] );
+        g_Checksum += static_cast<uint64_t>( mouse.leftButton );
+    } );
+
+    GamepadStateTracker gamepad;
+    run( "GamepadStateTracker::update", "", iterations, [&]( size_t i ) {
+        gamepad.update( gamepadStates[i % STATE_FRAMES] );
+        g_Checksum += static_cast<uint64_t>( gamepad.a );
+    } );
+
+    for ( size_t touchCount = 1; touchCount <= Touch::MAX_TOUCH_COUNT; ++touchCount )
+    {
+        Touch::State touchStates[STATE_FRAMES];
+        for ( size_t i = 0; i < STATE_FRAMES; ++i )
+            touchStates[i] = makeTouchState( rng, touchCount, i );
+
+        TouchStateTracker touch;
+        run( "TouchStateTracker::update", "touches=" + std::to_string( touchCount ), iterations, [&]( size_t i ) {
+            touch.update( touchStates[i % STATE_FRAMES] );
+            g_Checksum += touch.getTrackedTouches().size();
+        } );
+    }
+}
+
+void benchmarkDeadZones( size_t iterations )
+{
+    std::mt19937                          rng { 42 };
+    std::uniform_real_distribution<float> axis { -1.0f, 1.0f };
+
+    constexpr size_t STICK_COUNT = 1024;
+
+    std::vector<float> sticks( STICK_COUNT * 2 );
+    for ( auto& value: sticks )
+        value = axis( rng );
+
+    const std::pair<Gamepad::DeadZone, const char*> modes[] = {
+        { Gamepad::DeadZone::IndependentAxis, "IndependentAxis" },
+        { Gamepad::DeadZone::Circular, "Circular" },
+        { Gamepad::DeadZone::Radial, "Radial" },
+        { Gamepad::DeadZone::None, "None" },
+    };
+
+    for ( auto& [mode, modeName]: modes )
+    {
+        run( "ApplyStickDeadZone", std::string( "mode=" ) + modeName, iterations, [&]( size_t i ) {
+            const size_t index = ( i % STICK_COUNT ) * 2;
+
+            float x, y;
+            ApplyStickDeadZone( sticks[index], sticks[index + 1], mode, 1.0f, 0.24f, x, y );
+            g_Checksum += x > y;
+        } );
+    }
+}
+
+void benchmarkQueries( size_t iterations )
+{
+    // Query the frame of the backend.
+    Input::update();
+
+    run( "Input::getAxis", "name=Horizontal", iterations, [&]( size_t ) {
+        g_Checksum += Input::getAxis( "Horizontal" ) > 0.0f;
+    } );
+
+    run( "Input::getButtonDown", "name=Fire1", iterations, [&]( size_t ) {
+        g_Checksum += Input::getButtonDown( "Fire1" );
+    } );
+
+    run( "Input::getKey", "name=space", iterations, [&]( size_t ) {
+        g_Checksum += Input::getKey( "space" );
+    } );
+}
+
+void benchmarkUpdate( size_t iterations )
+{
+    std::mt19937 rng { 42 };
+
+    Keyboard::State keyboardStates[STATE_FRAMES];
+    Mouse::State    mouseStates[STATE_FRAMES];
+    Gamepad::State  gamepadStates[STATE_FRAMES][Gamepad::MAX_PLAYER_COUNT];
+    Touch::State    touchStates[STATE_FRAMES];
+    for ( size_t i = 0; i < STATE_FRAMES; ++i )
+    {
+        keyboardStates[i] = makeKeyboardState( rng );
+        mouseStates[i]    = makeMouseState( rng );
+        touchStates[i]    = makeTouchState( rng, 2, i );
+        for ( auto& state: gamepadStates[i] )
+            state = makeGamepadState( rng );
+    }
+
+#ifdef INPUT_BENCHMARK_VIRTUAL
+    for ( const int gamepadCount: { 0, 1, Gamepad::MAX_PLAYER_COUNT } )
+    {
+        Virtual::reset();
+
+        run( "Input::update", "gamepads=" + std::to_string( gamepadCount ), iterations, [&]( size_t i ) {
+            const size_t frame = i % STATE_FRAMES;
+
+            Virtual::setKeyboardState( keyboardStates[frame] );
+            Virtual::setMouseState( mouseStates[frame] );
+            for ( int player = 0; player < gamepadCount; ++player )
+                Virtual::setGamepadState( player, gamepadStates[frame][player] );
+
+            Input::update();
+            g_Checksum += Input::getButton( "Fire1" );
+        } );
+    }
+
+    Virtual::reset();
+#else
+    // The update of the default context with the states of the backend.
+    run( "Input::update", "backend", iterations, [&]( size_t ) {
+        Input::update();
+        g_Checksum += Input::getButton( "Fire1" );
+    } );
+
+    // The same processing as Input::update, with the given number of connected gamepads.
+    for ( const int gamepadCount: { 0, 1, Gamepad::MAX_PLAYER_COUNT } )
+    {
+        InputContext   context;
+        StickProcessor processor;
+
+        run( "InputContext::update", "gamepads=" + std::to_string( gamepadCount ), iterations, [&]( size_t i ) {
+            const size_t frame = i % STATE_FRAMES;
+
+            Gamepad::State states[Gamepad::MAX_PLAYER_COUNT] {};
+            std::copy_n( gamepadStates[frame], gamepadCount, states );
+            processor.process( states );
+
+            context.update( states, keyboardStates[frame], mouseStates[frame], touchStates[frame] );
+            g_Checksum += context.getButton( "Fire1" );
+        } );
+    }
+#endif
+}
+
+void writeJson()
+{
+    std::printf( "{\n  \"benchmarks\": [\n" );
+    for ( size_t i = 0; i < g_Results.size(); ++i )
+    {
+        const Result& r = g_Results[i];
+        std::printf( "    { \"name\": \"%s\", \"param\": \"%s\", \"iterations\": %zu, \"ns_per_op\": %.3f, \"min_ns_per_op\": %.3f }%s\n", r.name.c_str(), r.param.c_str(), r.iterations, r.medianTime, r.minTime,
+                     i + 1 < g_Results.size() ? "," : "" );
+    }
+    std::printf( "  ],\n  \"checksum\": %llu\n}\n", static_cast<unsigned long long>( g_Checksum ) );
+}
+
+void writeCsv()
+{
+    std::printf( "name,param,iterations,ns_per_op,min_ns_per_op\n" );
+    for ( const Result& r: g_Results )
+        std::printf( "%s,%s,%zu,%.3f,%.3f\n", r.name.c_str(), r.param.c_str(), r.iterations, r.medianTime, r.minTime );
+
+    // The checksum keeps the compiler from removing the benchmarked code. It is not part of the table.
+    std::fprintf( stderr, "checksum: %llu\n", static_cast<unsigned long long>( g_Checksum ) );
+}
+
+}  // namespace
+
+int main( int argc, char* argv[] )
+{
+    const bool   csv        = argc > 1 && std::strcmp( argv[1], "csv" ) == 0;
+    const size_t iterations = argc > 2 ? std::max<size_t>( std::strtoull( argv[2], nullptr, 10 ), 1 ) : 100000;
+
+    if ( argc > 1 && !csv && std::strcmp( argv[1], "json" ) != 0 )
+    {
+        std::fprintf( stderr, "Usage: input_bench [json|csv] [iterationCount]\n" );
+        return 1;
+    }
+
+    benchmarkTrackers( iterations );
+    benchmarkDeadZones( iterations );
+    benchmarkQueries( iterations );
+    benchmarkUpdate( std::max<size_t>( iterations / 10, 1 ) );
+
+    if ( csv )
+        writeCsv();
+    else
+        writeJson();
+
+    return 0;
+}
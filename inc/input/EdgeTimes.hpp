@@ -0,0 +1,99 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+
+namespace input
+{
+
+/// <summary>
+/// The timestamps of the presses and releases that a state tracker received since its previous update.
+/// </summary>
+/// <remarks>
+/// Only the inputs with an edge in the frame have a timestamp, so the size does not depend on the number of
+/// inputs (a keyboard has 256 keys, but only a few of them change in a frame). If more than Capacity inputs
+/// change in a frame, the timestamps of the inputs that do not fit are not recorded.
+///
+/// The state trackers call add from addEvents (before their update) and endFrame from update, so the
+/// timestamps of a frame are kept until the events of the next frame are added. The type is trivial, so it is
+/// cleared with the memset in the reset function of the state trackers (a zeroed object is empty).
+/// </remarks>
+template<size_t Capacity>
+class EdgeTimes
+{
+public:
+    /// <summary>
+    /// Record the time of a press or release. A later edge of the same input overwrites the earlier one.
+    /// </summary>
+    void add( uint32_t input, bool pressed, uint64_t timestamp ) noexcept
+    {
+        // The first event after an update starts a new frame.
+        if ( !m_Open )
+        {
+            m_Count = 0;
+            m_Open  = true;
+        }
+
+        const uint16_t key = makeKey( input, pressed );
+        for ( uint32_t i = 0; i < m_Count; ++i )
+        {
+            if ( m_Keys[i] == key )
+            {
+                m_Times[i] = timestamp;
+                return;
+            }
+        }
+
+        if ( m_Count < Capacity )
+        {
+            m_Keys[m_Count]  = key;
+            m_Times[m_Count] = timestamp;
+            ++m_Count;
+        }
+    }
+
+    /// <summary>
+    /// Close the frame. The timestamps of a frame without events are cleared.
+    /// </summary>
+    void endFrame() noexcept
+    {
+        if ( !m_Open )
+            m_Count = 0;
+
+        m_Open = false;
+    }
+
+    /// <summary>
+    /// Get the time of the latest press or release of an input in the frame (zero if it was not recorded).
+    /// </summary>
+    uint64_t get( uint32_t input, bool pressed ) const noexcept
+    {
+        const uint16_t key = makeKey( input, pressed );
+        for ( uint32_t i = 0; i < m_Count; ++i )
+        {
+            if ( m_Keys[i] == key )
+                return m_Times[i];
+        }
+
+        return 0;
+    }
+
+    void clear() noexcept
+    {
+        m_Count = 0;
+        m_Open  = false;
+    }
+
+private:
+    static uint16_t makeKey( uint32_t input, bool pressed ) noexcept
+    {
+        return static_cast<uint16_t>( input << 1 | ( pressed ? 1 : 0 ) );
+    }
+
+    uint64_t m_Times[Capacity];
+    uint16_t m_Keys[Capacity];  ///< The input index << 1 | 1 for a press.
+    uint16_t m_Count;
+    bool     m_Open;  ///< Edges were added since the last call to endFrame.
+};
+
+}  // namespace input
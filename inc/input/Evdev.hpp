@@ -0,0 +1,117 @@
+#pragma once
+
+#include <linux/input.h>
+
+#include <array>
+#include <cstdint>
+#include <span>
+#include <string>
+#include <string_view>
+
+namespace input
+{
+
+/// <summary>
+/// The device API of the Linux evdev backend (the input::Evdev CMake target).
+/// </summary>
+/// <remarks>
+/// The Evdev backend reads the `input_event` records of the devices in `/dev/input` directly, without a window
+/// or an event pump. The file descriptors are non-blocking and are read by a background thread that waits on
+/// them with epoll, so the events are timestamped by the kernel (CLOCK_MONOTONIC) and pushed to the event queue
+/// as soon as they arrive. Devices that are added to or removed from the directory are found with inotify.
+///
+/// Keyboards, relative mice (the raw motion counts without pointer acceleration), gamepads, and touchscreens
+/// that use the multi-touch protocol B are supported. Reading `/dev/input/event*` usually requires the user to
+/// be in the `input` group; devices that cannot be opened are skipped.
+///
+/// The source of the file descriptors is pluggable: addDevice accepts any file descriptor that delivers
+/// `input_event` records, such as the read end of a pipe that replays a recorded stream, and setDeviceDirectory
+/// changes (or disables) the directory that is scanned.
+/// </remarks>
+namespace Evdev
+{
+
+/// <summary>
+/// The number of absolute axes of a device (the ABS_* codes).
+/// </summary>
+constexpr int ABS_AXIS_COUNT = ABS_CNT;
+
+struct AbsRange
+{
+    int32_t minimum = 0;
+    int32_t maximum = 0;
+};
+
+/// <summary>
+/// The description of a device that determines how its events are interpreted.
+/// </summary>
+struct DeviceInfo
+{
+    std::string name;
+
+    bool keyboard = false;  ///< Has the letter keys (KEY_A...KEY_Z).
+    bool mouse    = false;  ///< Has relative X and Y axes and a left button.
+    bool gamepad  = false;  ///< Has the gamepad buttons (BTN_GAMEPAD).
+    bool touch    = false;  ///< A direct (touchscreen) device with the multi-touch protocol B.
+
+    /// <summary>
+    /// The ranges of the absolute axes, indexed by the ABS_* code. Used to normalize the thumbsticks, the triggers,
+    /// and the touch positions.
+    /// </summary>
+    std::array<AbsRange, ABS_AXIS_COUNT> absRanges {};
+};
+
+/// <summary>
+/// Query the description of an evdev device node with ioctl.
+/// </summary>
+/// <returns>`false` if the file descriptor is not an evdev device.</returns>
+bool queryDevice( int fd, DeviceInfo& info );
+
+/// <summary>
+/// Add a file descriptor that delivers `input_event` records.
+/// </summary>
+/// <remarks>
+/// The backend takes ownership of the file descriptor, makes it non-blocking, and closes it when the device is
+/// removed. The device is removed when the end of the stream is reached (for example, when the write end of a
+/// pipe is closed), when the device is unplugged, or with removeDevice.
+/// </remarks>
+/// <returns>The identifier of the device, or -1 if the file descriptor could not be added.</returns>
+int addDevice( int fd, const DeviceInfo& info );
+
+/// <summary>
+/// Remove a device that was added with addDevice or found in the device directory.
+/// </summary>
+void removeDevice( int device );
+
+/// <summary>
+/// Change the directory that is scanned for `event*` device nodes (`/dev/input` by default).
+/// </summary>
+/// <remarks>
+/// The devices of the previous directory are removed. An empty directory disables the scanning and the
+/// hotplugging, so only the devices that are added with addDevice are read (for example, to replay recorded
+/// streams without picking up the devices of the machine). Call this function before the first query of the
+/// Keyboard, Mouse, Gamepad, or Touch state to prevent the default directory from being opened.
+/// </remarks>
+void setDeviceDirectory( std::string_view directory );
+
+namespace detail
+{
+void startReader();                                                                     ///< Defined in DeviceEvdev.cpp
+void connectKeyboard( int device );                                                     ///< Defined in KeyboardEvdev.cpp
+void disconnectKeyboard( int device );                                                  ///< Defined in KeyboardEvdev.cpp
+void applyKeyboardEvents( int device, std::span<const input_event> events ) noexcept;    ///< Defined in KeyboardEvdev.cpp
+void connectMouse( int device );                                                        ///< Defined in MouseEvdev.cpp
+void disconnectMouse( int device );                                                     ///< Defined in MouseEvdev.cpp
+void applyMouseEvents( int device, std::span<const input_event> events ) noexcept;       ///< Defined in MouseEvdev.cpp
+void connectGamepad( int device, int fd, const DeviceInfo& info );                      ///< Defined in GamepadEvdev.cpp
+void disconnectGamepad( int device );                                                   ///< Defined in GamepadEvdev.cpp
+void applyGamepadEvents( int device, std::span<const input_event> events ) noexcept;    ///< Defined in GamepadEvdev.cpp
+void connectTouch( int device, int fd, const DeviceInfo& info );                        ///< Defined in TouchEvdev.cpp
+void disconnectTouch( int device );                                                     ///< Defined in TouchEvdev.cpp
+void applyTouchEvents( int device, std::span<const input_event> events ) noexcept;      ///< Defined in TouchEvdev.cpp
+uint64_t toTimestamp( const input_event& event ) noexcept;                              ///< Defined in DeviceEvdev.cpp
+}  // namespace detail
+
+}  // namespace Evdev
+
+}  // namespace input
@@ -0,0 +1,196 @@
+#pragma once
+
+#include "Gamepad.hpp"
+#include "Keyboard.hpp"
+#include "Mouse.hpp"
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <span>
+
+namespace input
+{
+
+enum class EventType : uint8_t
+{
+    KeyDown,
+    KeyUp,
+    MouseButtonDown,
+    MouseButtonUp,
+    MouseMotion,
+    MouseWheel,
+    GamepadButtonDown,
+    GamepadButtonUp,
+    GamepadAxis,
+    TouchDown,
+    TouchMotion,
+    TouchUp,
+};
+
+/// <summary>
+/// The analog axes of a gamepad that are reported by GamepadAxis events.
+/// </summary>
+enum class GamepadAxis : uint8_t
+{
+    LeftX,
+    LeftY,
+    RightX,
+    RightY,
+    LeftTrigger,
+    RightTrigger,
+};
+
+/// <summary>
+/// An input event that was received by a backend.
+/// </summary>
+/// <remarks>
+/// The member of the union that is valid depends on the type of the event.
+/// </remarks>
+struct Event
+{
+    struct KeyEvent
+    {
+        Keyboard::Key key;
+    };
+
+    struct MouseButtonEvent
+    {
+        Mouse::Button button;
+        float         x;  ///< The position of the mouse cursor in the window.
+        float         y;
+    };
+
+    struct MouseMotionEvent
+    {
+        float x;  ///< The position of the mouse cursor in the window.
+        float y;
+        float deltaX;  ///< The motion since the previous event.
+        float deltaY;
+    };
+
+    struct MouseWheelEvent
+    {
+        int32_t delta;  ///< 120 for each notch of the scroll wheel (the same as Mouse::State::scrollWheelValue).
+    };
+
+    struct GamepadButtonEvent
+    {
+        int             player;
+        Gamepad::Button button;
+    };
+
+    struct GamepadAxisEvent
+    {
+        int         player;
+        GamepadAxis axis;
+        float       value;  ///< [-1...1] for the thumbsticks and [0...1] for the triggers.
+    };
+
+    struct TouchEvent
+    {
+        int64_t id;
+        float   x;  ///< Normalized touch coordinates (the same as Touch::TouchPoint).
+        float   y;
+        float   pressure;
+    };
+
+    EventType type;
+
+    /// <summary>
+    /// The time of the event in nanoseconds. The clock depends on the backend, so only the
+    /// difference between two events is meaningful.
+    /// </summary>
+    uint64_t timestamp;
+
+#ifdef INPUT_ENABLE_LATENCY_PROBE
+    /// <summary>
+    /// The time that the event was pushed to the queue (in the clock of the timestamp).
+    /// </summary>
+    uint64_t queueTime;
+#endif
+
+    union
+    {
+        KeyEvent           key;
+        MouseButtonEvent   mouseButton;
+        MouseMotionEvent   mouseMotion;
+        MouseWheelEvent    mouseWheel;
+        GamepadButtonEvent gamepadButton;
+        GamepadAxisEvent   gamepadAxis;
+        TouchEvent         touch;
+    };
+};
+
+/// <summary>
+/// Get the current time of the clock that is used for Event::timestamp in nanoseconds.
+/// </summary>
+uint64_t getEventTime() noexcept;  ///< Defined by the backend.
+
+/// <summary>
+/// Start a new frame of the backend. Called by Input::update before the mouse motion of the frame is completed
+/// and before the events are drained.
+/// </summary>
+/// <remarks>
+/// The Replay backend reads the next recorded frame and pushes its events. The other backends do nothing.
+/// </remarks>
+void beginFrame() noexcept;  ///< Defined by the backend.
+
+/// <summary>
+/// A lock-free single-producer/single-consumer ring buffer of events.
+/// </summary>
+/// <remarks>
+/// The backends push the events they receive (from the SDL event watches and the GLFW callbacks) to the queue
+/// that is returned by EventQueue::get. The producer is the thread that pumps the window events, the consumer is
+/// the thread that calls Input::update, which drains the queue each frame (see Input::getEvents).
+///
+/// If the queue is full, new events are dropped and counted (see takeDroppedCount).
+/// </remarks>
+class EventQueue
+{
+public:
+    /// <summary>
+    /// The maximum number of events in the queue (a power of two).
+    /// </summary>
+    static constexpr uint32_t CAPACITY = 1024;
+
+    static_assert( ( CAPACITY & ( CAPACITY - 1 ) ) == 0, "The capacity must be a power of two." );
+
+    /// <summary>
+    /// The queue that the backends push their events to.
+    /// </summary>
+    static EventQueue& get() noexcept;
+
+    /// <summary>
+    /// Add an event to the queue (only call from the producer thread).
+    /// </summary>
+    /// <returns>`false` if the queue is full and the event was dropped.</returns>
+    bool push( const Event& event ) noexcept;
+
+    /// <summary>
+    /// Remove the oldest events from the queue (only call from the consumer thread).
+    /// </summary>
+    /// <param name="events">Receives the events (oldest first).</param>
+    /// <returns>The number of events that were removed (at most events.size()).</returns>
+    size_t pop( std::span<Event> events ) noexcept;
+
+    /// <summary>
+    /// Get the number of events that were dropped since the last call and reset the count.
+    /// </summary>
+    uint32_t takeDroppedCount() noexcept;
+
+    /// <summary>
+    /// The number of events in the queue. The value may be out of date if the queue is modified by another thread.
+    /// </summary>
+    size_t size() const noexcept;
+
+private:
+    // The read and write positions are on separate cache lines so that the producer and the consumer do not contend.
+    alignas( 64 ) std::atomic<uint32_t> m_Read { 0 };
+    alignas( 64 ) std::atomic<uint32_t> m_Write { 0 };
+    std::atomic<uint32_t>               m_Dropped { 0 };
+
+    Event m_Events[CAPACITY] {};
+};
+
+}  // namespace input
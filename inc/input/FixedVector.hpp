@@ -0,0 +1,172 @@
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <cassert>
+#include <cstddef>
+#include <span>
+
+namespace input
+{
+
+/// <summary>
+/// A vector with a fixed capacity that stores its elements inline (it never allocates).
+/// </summary>
+/// <remarks>
+/// Only the first size() elements are valid. Adding an element to a full vector is ignored
+/// (push_back returns false). T must be default constructible and trivially copyable.
+/// </remarks>
+template<typename T, size_t Capacity>
+class FixedVector
+{
+public:
+    using value_type      = T;
+    using size_type       = size_t;
+    using reference       = T&;
+    using const_reference = const T&;
+    using iterator        = T*;
+    using const_iterator  = const T*;
+
+    static constexpr size_t capacity() noexcept
+    {
+        return Capacity;
+    }
+
+    size_t size() const noexcept
+    {
+        return m_Size;
+    }
+
+    bool empty() const noexcept
+    {
+        return m_Size == 0;
+    }
+
+    bool full() const noexcept
+    {
+        return m_Size == Capacity;
+    }
+
+    T* data() noexcept
+    {
+        return m_Data.data();
+    }
+
+    const T* data() const noexcept
+    {
+        return m_Data.data();
+    }
+
+    iterator begin() noexcept
+    {
+        return m_Data.data();
+    }
+
+    iterator end() noexcept
+    {
+        return m_Data.data() + m_Size;
+    }
+
+    const_iterator begin() const noexcept
+    {
+        return m_Data.data();
+    }
+
+    const_iterator end() const noexcept
+    {
+        return m_Data.data() + m_Size;
+    }
+
+    T& operator[]( size_t index ) noexcept
+    {
+        assert( index < m_Size );
+        return m_Data[index];
+    }
+
+    const T& operator[]( size_t index ) const noexcept
+    {
+        assert( index < m_Size );
+        return m_Data[index];
+    }
+
+    /// <summary>
+    /// Add an element to the end of the vector.
+    /// </summary>
+    /// <returns>`false` if the vector is full and the element was not added.</returns>
+    bool push_back( const T& value ) noexcept
+    {
+        if ( m_Size == Capacity )
+            return false;
+
+        m_Data[m_Size++] = value;
+        return true;
+    }
+
+    void pop_back() noexcept
+    {
+        assert( m_Size > 0 );
+        --m_Size;
+    }
+
+    /// <summary>
+    /// Remove an element. The order of the remaining elements is preserved.
+    /// </summary>
+    iterator erase( const_iterator pos ) noexcept
+    {
+        const auto it = begin() + ( pos - begin() );
+        std::copy( it + 1, end(), it );
+        --m_Size;
+
+        return it;
+    }
+
+    void clear() noexcept
+    {
+        m_Size = 0;
+    }
+
+    operator std::span<T>() noexcept
+    {
+        return { data(), m_Size };
+    }
+
+    operator std::span<const T>() const noexcept
+    {
+        return { data(), m_Size };
+    }
+
+    /// <summary>
+    /// Compares the valid elements of both vectors.
+    /// </summary>
+    bool operator==( const FixedVector& other ) const noexcept
+    {
+        return std::equal( begin(), end(), other.begin(), other.end() );
+    }
+
+    bool operator!=( const FixedVector& other ) const noexcept
+    {
+        return !( *this == other );
+    }
+
+private:
+    std::array<T, Capacity> m_Data {};
+    size_t                  m_Size = 0;
+};
+
+/// <summary>
+/// Remove all elements that satisfy the predicate (the same as std::erase_if).
+/// </summary>
+/// <returns>The number of removed elements.</returns>
+template<typename T, size_t Capacity, typename Predicate>
+size_t erase_if( FixedVector<T, Capacity>& vector, Predicate predicate )
+{
+    const auto it    = std::remove_if( vector.begin(), vector.end(), predicate );
+    const auto count = static_cast<size_t>( vector.end() - it );
+
+    for ( size_t i = 0; i < count; ++i )
+        vector.pop_back();
+
+    return count;
+}
+
+}  // namespace input
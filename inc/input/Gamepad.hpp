@@ -1,6 +1,10 @@
 #pragma once
 
 #include "ButtonState.hpp"
+#include "EdgeTimes.hpp"
+
+#include <cstdint>
+#include <span>
 
 namespace input
 {
@@ -15,9 +19,54 @@ struct Gamepad
     /// </summary>
     enum class DeadZone
     {
-        IndependentAxis = 0,
-        Circular,
-        None,
+        IndependentAxis = 0,        ///< Apply the dead zone to the X and Y axis independently.
+        Circular,                   ///< Apply the dead zone to the length of the stick and rescale the remaining range.
+        ScaledRadial = Circular,
+        None,                       ///< Only clamp the axes to the [-1...1] range.
+        Radial,                     ///< Apply the dead zone to the length of the stick without rescaling the remaining range.
+        Hybrid,                     ///< Scaled radial, followed by an axial dead zone that grows with the other axis.
+    };
+
+    /// <summary>
+    /// Identifies a gamepad button.
+    /// </summary>
+    /// <remarks>
+    /// Includes the "virtual" buttons that are emulated by applying a threshold to the thumbsticks and triggers.
+    /// The order of the buttons matches the order of the fields in the GamepadStateTracker.
+    /// </remarks>
+    enum class Button : uint8_t
+    {
+        A = 0,
+        Cross = A,
+        B,
+        Circle = B,
+        X,
+        Square = X,
+        Y,
+        Triangle = Y,
+        LeftStick,
+        RightStick,
+        LeftShoulder,
+        RightShoulder,
+        Back,
+        View = Back,
+        Start,
+        Menu = Start,
+        DPadUp,
+        DPadDown,
+        DPadLeft,
+        DPadRight,
+        LeftStickUp,
+        LeftStickDown,
+        LeftStickLeft,
+        LeftStickRight,
+        RightStickUp,
+        RightStickDown,
+        RightStickLeft,
+        RightStickRight,
+        LeftTrigger,
+        RightTrigger,
+        Count
     };
 
     struct Buttons
@@ -249,6 +298,8 @@ private:
     int playerIndex = MOST_RECENT_PLAYER;
 };
 
+struct Event;
+
 class GamepadStateTracker
 {
 public:
@@ -310,6 +361,24 @@ public:
     ButtonState leftTrigger;
     ButtonState rightTrigger;
 
+    /// <summary>
+    /// The packed button states (bit n is Gamepad::Button n, see PackGamepadButtons).
+    /// The ButtonState fields above are expanded from these bitmasks in update.
+    /// </summary>
+    uint32_t down;      ///< The buttons that are held down.
+    uint32_t pressed;   ///< The buttons that were pressed this frame.
+    uint32_t released;  ///< The buttons that were released this frame.
+
+    /// <summary>
+    /// The maximum number of buttons with a recorded press or release time in a frame.
+    /// </summary>
+    static constexpr size_t MAX_EDGE_TIMES = 16;
+
+    /// <summary>
+    /// The timestamps of the button presses and releases of the last frame in nanoseconds (see getPressTime).
+    /// </summary>
+    EdgeTimes<MAX_EDGE_TIMES> edgeTimes;
+
     GamepadStateTracker() noexcept
     {
         reset();
@@ -317,8 +386,56 @@ public:
 
     void update( const Gamepad::State& state );
 
+    /// <summary>
+    /// Record the timestamps of the button events of a player (other events are ignored).
+    /// </summary>
+    /// <remarks>
+    /// The virtual threshold buttons do not have events, so their timestamps are not recorded.
+    /// </remarks>
+    void addEvents( std::span<const Event> events, int player ) noexcept;
+
     void reset() noexcept;
 
+    /// <summary>
+    /// Get the state of a button by its Gamepad::Button identifier.
+    /// </summary>
+    /// <param name="button">The button to query.</param>
+    /// <returns>The up/held/pressed/released state of the button.</returns>
+    ButtonState getButtonState( Gamepad::Button button ) const noexcept;
+
+    bool isButtonDown( Gamepad::Button button ) const noexcept
+    {
+        return ( down >> static_cast<uint32_t>( button ) & 1 ) != 0;
+    }
+
+    bool isButtonPressed( Gamepad::Button button ) const noexcept
+    {
+        return ( pressed >> static_cast<uint32_t>( button ) & 1 ) != 0;
+    }
+
+    bool isButtonReleased( Gamepad::Button button ) const noexcept
+    {
+        return ( released >> static_cast<uint32_t>( button ) & 1 ) != 0;
+    }
+
+    /// <summary>
+    /// Get the time of the latest press of a button in the last frame in nanoseconds.
+    /// Zero if no press event was received for the button in the last frame.
+    /// </summary>
+    uint64_t getPressTime( Gamepad::Button button ) const noexcept
+    {
+        return edgeTimes.get( static_cast<uint32_t>( button ), true );
+    }
+
+    /// <summary>
+    /// Get the time of the latest release of a button in the last frame in nanoseconds.
+    /// Zero if no release event was received for the button in the last frame.
+    /// </summary>
+    uint64_t getReleaseTime( Gamepad::Button button ) const noexcept
+    {
+        return edgeTimes.get( static_cast<uint32_t>( button ), false );
+    }
+
     Gamepad::State getLastState() const noexcept
     {
         return lastState;
@@ -331,6 +448,22 @@ private:
 float ApplyLinearDeadZone( float value, float maxValue, float deadZoneSize ) noexcept;                                                                      ///< Defined in Gamepad.cpp
 void  ApplyStickDeadZone( float x, float y, Gamepad::DeadZone deadZoneMode, float maxValue, float deadZoneSize, float& resultX, float& resultY ) noexcept;  ///< Defined in Gamepad.cpp
 
+/// <summary>
+/// Pack the buttons of a gamepad state into a bitmask (bit n is Gamepad::Button n).
+/// </summary>
+/// <remarks>
+/// Includes the virtual buttons that are emulated by applying a threshold to the thumbsticks and triggers.
+/// </remarks>
+uint32_t PackGamepadButtons( const Gamepad::State& state ) noexcept;  ///< Defined in Gamepad.cpp
+
+/// <summary>
+/// Unpack the digital buttons and the d-pad of a bitmask that was returned by PackGamepadButtons.
+/// </summary>
+/// <remarks>
+/// The virtual threshold buttons are ignored, the thumbsticks and triggers of the state are not modified.
+/// </remarks>
+void UnpackGamepadButtons( uint32_t buttons, Gamepad::State& state ) noexcept;  ///< Defined in Gamepad.cpp
+
 }  // namespace input
 
 inline bool operator==( const input::Gamepad::Buttons& lhs, const input::Gamepad::Buttons& rhs )
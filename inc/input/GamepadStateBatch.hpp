@@ -0,0 +1,134 @@
+#pragma once
+
+#include "Gamepad.hpp"
+
+#include <cstddef>
+#include <cstdint>
+#include <span>
+#include <vector>
+
+namespace input
+{
+
+/// <summary>
+/// Tracks the button states of many gamepads at once.
+/// </summary>
+/// <remarks>
+/// The state of each player is stored in structure-of-arrays form: one bitmask of digital buttons per player
+/// (bit n is Gamepad::Button n) and one float lane for each thumbstick axis and trigger.
+/// GamepadStateBatch::update computes the held, pressed and released buttons of all players with a few bitwise
+/// operations and vectorized threshold compares (AVX2, SSE2 or NEON when the target supports it).
+///
+/// This is intended for simulating a large number of players (for example, on a server).
+/// Use GamepadStateTracker to track the state of a single local gamepad.
+/// </remarks>
+class GamepadStateBatch
+{
+public:
+    GamepadStateBatch() = default;
+
+    /// <summary>
+    /// Create a batch for a number of players. All players start disconnected with no buttons held.
+    /// </summary>
+    explicit GamepadStateBatch( size_t playerCount );
+
+    /// <summary>
+    /// Set the number of players. New players start disconnected with no buttons held.
+    /// </summary>
+    void resize( size_t playerCount );
+
+    size_t size() const noexcept
+    {
+        return m_Buttons.size();
+    }
+
+    /// <summary>
+    /// Clear the state of all players.
+    /// </summary>
+    void reset() noexcept;
+
+    /// <summary>
+    /// Set the state of a player for the next call to update.
+    /// </summary>
+    void setState( size_t playerIndex, const Gamepad::State& state ) noexcept;
+
+    /// <summary>
+    /// Set the state of the players [0...states.size()) for the next call to update.
+    /// </summary>
+    void setStates( std::span<const Gamepad::State> states ) noexcept;
+
+    /// <summary>
+    /// Get the state of a player that was last set with setState.
+    /// </summary>
+    Gamepad::State getState( size_t playerIndex ) const noexcept;
+
+    /// <summary>
+    /// Update the button states of all players. Should be called once per frame, after the states are set.
+    /// </summary>
+    void update() noexcept;
+
+    /// <summary>
+    /// Get the state of a button of a player, the same as GamepadStateTracker::getButtonState.
+    /// </summary>
+    ButtonState getButtonState( size_t playerIndex, Gamepad::Button button ) const noexcept;
+
+    /// <summary>
+    /// The buttons that are held down (bit n is Gamepad::Button n).
+    /// </summary>
+    uint32_t getButtons( size_t playerIndex ) const noexcept
+    {
+        return m_Buttons[playerIndex];
+    }
+
+    /// <summary>
+    /// The buttons that were pressed this frame.
+    /// </summary>
+    uint32_t getPressed( size_t playerIndex ) const noexcept
+    {
+        return m_Pressed[playerIndex];
+    }
+
+    /// <summary>
+    /// The buttons that were released this frame.
+    /// </summary>
+    uint32_t getReleased( size_t playerIndex ) const noexcept
+    {
+        return m_Released[playerIndex];
+    }
+
+    std::span<const uint32_t> getButtons() const noexcept
+    {
+        return m_Buttons;
+    }
+
+    std::span<const uint32_t> getPressed() const noexcept
+    {
+        return m_Pressed;
+    }
+
+    std::span<const uint32_t> getReleased() const noexcept
+    {
+        return m_Released;
+    }
+
+private:
+    // The digital buttons and d-pad of each player (without the threshold buttons).
+    std::vector<uint32_t> m_Digital;
+
+    std::vector<float> m_LeftX;
+    std::vector<float> m_LeftY;
+    std::vector<float> m_RightX;
+    std::vector<float> m_RightY;
+    std::vector<float> m_LeftTrigger;
+    std::vector<float> m_RightTrigger;
+
+    std::vector<uint8_t>  m_Connected;
+    std::vector<uint64_t> m_Packet;
+
+    // The result of the last update.
+    std::vector<uint32_t> m_Buttons;
+    std::vector<uint32_t> m_Pressed;
+    std::vector<uint32_t> m_Released;
+};
+
+}  // namespace input
@@ -0,0 +1,243 @@
+#pragma once
+
+#include "FixedVector.hpp"
+#include "Touch.hpp"
+
+#include <cstddef>
+#include <cstdint>
+#include <span>
+
+namespace input
+{
+
+/// <summary>
+/// The type of a touch gesture.
+/// </summary>
+enum class GestureType : uint8_t
+{
+    Tap,        ///< A finger was released quickly without moving.
+    DoubleTap,  ///< A second tap close to the previous tap (the second tap also reports a Tap).
+    LongPress,  ///< A finger was held down without moving (reported once, while the finger is still down).
+    Swipe,      ///< A finger was released after moving quickly.
+    Pinch,      ///< The distance between two fingers changed (continuous).
+    Rotate,     ///< The angle between two fingers changed (continuous).
+};
+
+/// <summary>
+/// The phase of a gesture. Discrete gestures (Tap, DoubleTap, LongPress, and Swipe) are only reported
+/// with the Ended phase. Continuous gestures (Pinch and Rotate) are reported each frame while the gesture is active.
+/// </summary>
+enum class GesturePhase : uint8_t
+{
+    Began,    ///< The gesture was recognized this frame.
+    Changed,  ///< The gesture is still active.
+    Ended,    ///< The gesture ended this frame.
+};
+
+/// <summary>
+/// A gesture that was recognized by the GestureRecognizer.
+/// </summary>
+struct GestureEvent
+{
+    GestureType  type;
+    GesturePhase phase;
+
+    /// <summary>
+    /// The ID of the touch point. For two finger gestures, the ID of the first finger.
+    /// </summary>
+    int64_t id;
+
+    /// <summary>
+    /// The position of the gesture in normalized touch coordinates. For two finger gestures, the point between the fingers.
+    /// </summary>
+    float x;
+    float y;
+
+    /// <summary>
+    /// Swipe: the distance the finger moved since it was pressed.
+    /// </summary>
+    float deltaX;
+    float deltaY;
+
+    /// <summary>
+    /// Swipe: the velocity of the finger when it was released, in normalized units per second.
+    /// </summary>
+    float velocityX;
+    float velocityY;
+
+    /// <summary>
+    /// Pinch: the distance between the fingers relative to the distance when the fingers were placed (1 is unchanged).
+    /// </summary>
+    float scale;
+
+    /// <summary>
+    /// Rotate: the rotation of the fingers since they were placed, in radians (clockwise in touch coordinates is positive).
+    /// </summary>
+    float rotation;
+};
+
+/// <summary>
+/// The thresholds that are used to recognize gestures.
+/// Distances are in normalized touch coordinates and durations are in seconds.
+/// </summary>
+struct GestureSettings
+{
+    float tapMaxDistance       = 0.02f;  ///< A finger that moves further is not a tap (or long press).
+    float tapMaxDuration       = 0.25f;  ///< A finger that is held longer is not a tap.
+    float doubleTapMaxInterval = 0.3f;   ///< The maximum time between the release of the first tap and the release of the second tap.
+    float doubleTapMaxDistance = 0.05f;  ///< The maximum distance between the first and the second tap.
+    float longPressDuration    = 0.5f;   ///< The time a finger must be held down without moving.
+    float swipeMinDistance     = 0.1f;   ///< The minimum distance a finger must move.
+    float swipeMinVelocity     = 0.5f;   ///< The minimum velocity of a finger when it is released (units per second).
+    float pinchMinDistance     = 0.02f;  ///< The change in distance between two fingers before a pinch is recognized.
+    float rotateMinAngle       = 0.1f;   ///< The change in angle (in radians) between two fingers before a rotation is recognized.
+};
+
+/// <summary>
+/// Recognizes tap, double tap, long press, swipe, pinch, and rotate gestures from the tracked touches of a TouchStateTracker.
+/// </summary>
+/// <remarks>
+/// Call update after TouchStateTracker::update each frame. The recognizer keeps a small amount of state for
+/// each active touch point (including a ring buffer of recent movement to estimate the velocity), so it uses a
+/// fixed amount of memory and the cost of an update is linear in the number of tracked touches.
+///
+/// The gestures that were recognized in the last update are returned by getEvents. The state of the
+/// continuous gestures can also be queried with isPinching, getPinchScale, isRotating, and getRotation.
+///
+/// InputContext updates a GestureRecognizer with the touch state (see InputFrame::gestures).
+/// </remarks>
+class GestureRecognizer
+{
+public:
+    /// <summary>
+    /// The number of movement samples that are used to estimate the velocity of a touch point.
+    /// </summary>
+    static constexpr size_t VELOCITY_SAMPLE_COUNT = 8;
+
+    /// <summary>
+    /// The maximum number of gestures that are reported in a single update.
+    /// </summary>
+    static constexpr size_t MAX_EVENT_COUNT = Touch::MAX_TOUCH_COUNT * 2 + 4;
+
+    using Events = FixedVector<GestureEvent, MAX_EVENT_COUNT>;
+
+    void                   setSettings( const GestureSettings& settings ) noexcept;
+    const GestureSettings& getSettings() const noexcept;
+
+    /// <summary>
+    /// Update the recognizer with the tracked touches.
+    /// </summary>
+    /// <param name="touches">A touch state tracker that was updated this frame.</param>
+    /// <param name="timestamp">The time of the update in nanoseconds (must not decrease).</param>
+    void update( const TouchStateTracker& touches, uint64_t timestamp ) noexcept;
+
+    /// <summary>
+    /// Forget all touch points and gestures (the settings are not changed).
+    /// </summary>
+    void reset() noexcept;
+
+    /// <summary>
+    /// Get the gestures that were recognized in the last update.
+    /// </summary>
+    std::span<const GestureEvent> getEvents() const noexcept
+    {
+        return m_Events;
+    }
+
+    /// <summary>
+    /// Get the estimated velocity of an active touch point in normalized units per second.
+    /// </summary>
+    /// <returns>`false` if the touch point is not active.</returns>
+    bool getVelocity( int64_t id, float& velocityX, float& velocityY ) const noexcept;
+
+    bool isPinching() const noexcept
+    {
+        return m_Pair.pinching;
+    }
+
+    /// <summary>
+    /// The current scale of the pinch gesture, or 1 if there is no pinch gesture.
+    /// </summary>
+    float getPinchScale() const noexcept
+    {
+        return m_Pair.pinching ? m_Pair.scale : 1.0f;
+    }
+
+    bool isRotating() const noexcept
+    {
+        return m_Pair.rotating;
+    }
+
+    /// <summary>
+    /// The current rotation of the rotate gesture in radians, or 0 if there is no rotate gesture.
+    /// </summary>
+    float getRotation() const noexcept
+    {
+        return m_Pair.rotating ? m_Pair.rotation : 0.0f;
+    }
+
+private:
+    struct Finger
+    {
+        int64_t  id;
+        uint64_t startTime;
+        uint64_t lastTime;
+        float    startX;
+        float    startY;
+        float    x;
+        float    y;
+
+        // The movement of the last few updates (a ring buffer).
+        float    sampleX[VELOCITY_SAMPLE_COUNT];
+        float    sampleY[VELOCITY_SAMPLE_COUNT];
+        float    sampleTime[VELOCITY_SAMPLE_COUNT];
+        uint32_t sampleCount;
+        uint32_t nextSample;
+
+        bool active;
+        bool moved;       ///< Moved further than the tap distance.
+        bool longPress;   ///< The long press was reported.
+        bool multiTouch;  ///< Part of a gesture with more than one finger.
+    };
+
+    // Two fingers that are pinched or rotated.
+    struct Pair
+    {
+        int64_t first  = -1;
+        int64_t second = -1;
+        float   startDistance;
+        float   lastAngle;
+        float   scale;
+        float   rotation;
+        float   x;
+        float   y;
+        bool    pinching = false;
+        bool    rotating = false;
+    };
+
+    Finger*       findFinger( int64_t id ) noexcept;
+    const Finger* findFinger( int64_t id ) const noexcept;
+
+    static void estimateVelocity( const Finger& finger, float& velocityX, float& velocityY ) noexcept;
+
+    void pressed( const TouchStateTracker::TrackedTouch& touch, uint64_t timestamp ) noexcept;
+    void moved( Finger& finger, const TouchStateTracker::TrackedTouch& touch, uint64_t timestamp ) noexcept;
+    void released( Finger& finger, uint64_t timestamp ) noexcept;
+    void updatePair() noexcept;
+    void endPair() noexcept;
+
+    GestureSettings m_Settings;
+    Finger          m_Fingers[Touch::MAX_TOUCH_COUNT] {};
+    uint32_t        m_ActiveCount = 0;
+    Pair            m_Pair;
+
+    // The last tap (for double taps).
+    uint64_t m_LastTapTime  = 0;
+    float    m_LastTapX     = 0.0f;
+    float    m_LastTapY     = 0.0f;
+    bool     m_LastTapValid = false;
+
+    Events m_Events;
+};
+
+}  // namespace input
@@ -1,17 +1,23 @@
 #pragma once
 
+#include "EventQueue.hpp"
 #include "Gamepad.hpp"
 #include "Keyboard.hpp"
 #include "Mouse.hpp"
 #include "Touch.hpp"
 
+#include <cstdint>
 #include <functional>
+#include <iosfwd>
 #include <span>
 #include <string_view>
 
 namespace input
 {
 
+struct LatencyStats;  ///< Defined in LatencyProbe.hpp
+struct ProfileStats;  ///< Defined in Profiler.hpp
+
 /// <summary>
 /// An AxisCallback function takes a GamePadStateTracker (for each connected GamePad),
 /// a KeyboardStateTracker, and a MouseStateTracker and returns the value of the axis
@@ -25,13 +31,135 @@ using AxisCallback = std::function<float( std::span<const GamepadStateTracker>,
 /// </summary>
 using ButtonCallback = std::function<bool( std::span<const GamepadStateTracker>, const KeyboardStateTracker&, const MouseStateTracker& )>;
 
+/// <summary>
+/// Determines how often an AxisCallback or ButtonCallback function is evaluated.
+/// </summary>
+enum class CallbackCaching : uint8_t
+{
+    PerFrame,  ///< The callback is evaluated at most once per frame. Repeated queries in the same frame return the cached result.
+    None,      ///< The callback is evaluated every time the action is queried. Use this for callbacks that are intentionally impure.
+};
+
+struct InputFrame;
+struct TouchRect;
+class InputContext;
+class StickProcessor;
+
 namespace Input
 {
+/// <summary>
+/// A pre-resolved handle to a named input action (axis or button).
+/// </summary>
+/// <remarks>
+/// Use Input::getActionHandle to resolve the name of an action once (for example, when loading a level)
+/// and query the action by handle every frame. Querying an action by handle does not hash the action name
+/// and does not allocate memory.
+/// The handle remains valid if the callback functions that are mapped to the action are replaced.
+/// </remarks>
+struct ActionHandle
+{
+    static constexpr uint32_t INVALID_INDEX = UINT32_MAX;
+
+    uint32_t index = INVALID_INDEX;
+
+    bool isValid() const noexcept
+    {
+        return index != INVALID_INDEX;
+    }
+
+    bool operator==( const ActionHandle& ) const = default;
+    bool operator!=( const ActionHandle& ) const = default;
+};
+
 /// <summary>
 /// Update the input state. Should only be called once per frame.
 /// </summary>
+/// <remarks>
+/// At the end of the update, a snapshot of the input state is published (see Input::getFrame).
+/// </remarks>
 void update();
 
+/// <summary>
+/// Get the most recently published snapshot of the input state.
+/// </summary>
+/// <remarks>
+/// The snapshot can be queried from any thread without locking. It remains valid (and unchanged) until
+/// Input::update has been called two more times: the third call overwrites it, so a thread must not hold a
+/// snapshot for longer than the frame in which it was acquired.
+/// </remarks>
+/// <returns>The input snapshot that was published by the last call to Input::update.</returns>
+const InputFrame& getFrame();
+
+/// <summary>
+/// Get the default input context.
+/// </summary>
+/// <remarks>
+/// The functions in the Input namespace forward to the default context, which is updated from the local backend by Input::update.
+/// </remarks>
+/// <returns>The default input context.</returns>
+InputContext& getDefaultContext();
+
+/// <summary>
+/// Get the stick processor that applies the dead zones and response curves to the gamepads in Input::update.
+/// </summary>
+/// <remarks>
+/// Use StickProcessor::setSettings to configure the dead zones and response curves of each player.
+/// The default settings match Gamepad::getState with the IndependentAxis dead zone mode.
+/// This only affects the gamepad states that are used by Input::update, not Gamepad::getState.
+/// </remarks>
+/// <returns>The stick processor of the default context.</returns>
+StickProcessor& getStickProcessor();
+
+/// <summary>
+/// Resolve the name of an action to a handle that can be used to query the action.
+/// </summary>
+/// <remarks>
+/// If no action with the given name exists yet, an (unmapped) action is reserved for that name.
+/// Callback functions that are added for that name later will be used by the handle.
+/// </remarks>
+/// <param name="actionName">The name of the axis or button to resolve.</param>
+/// <returns>The handle to the action.</returns>
+ActionHandle getActionHandle( std::string_view actionName );
+
+/// <summary>
+/// Returns the value of the axis identified by the action handle.
+/// </summary>
+/// <param name="action">The handle of the axis to read.</param>
+/// <returns>A value in the range [-1...1] that represents the value of the axis.</returns>
+float getAxis( ActionHandle action );
+
+/// <summary>
+/// Returns the value of the button identified by the action handle.
+/// </summary>
+/// <param name="action">The handle of the button to query.</param>
+/// <returns>`true` if the button is pressed, `false` otherwise.</returns>
+bool getButton( ActionHandle action );
+
+/// <summary>
+/// Returns `true` in the frame that the button identified by the action handle is pressed.
+/// </summary>
+/// <param name="action">The handle of the button to query.</param>
+/// <returns>`true` if the button was pressed this frame, `false` otherwise.</returns>
+bool getButtonDown( ActionHandle action );
+
+/// <summary>
+/// Returns `true` in the frame that the button identified by the action handle is released.
+/// </summary>
+/// <param name="action">The handle of the button to query.</param>
+/// <returns>`true` if the button was released this frame, `false` otherwise.</returns>
+bool getButtonUp( ActionHandle action );
+
+/// <summary>
+/// Returns the number of times the button identified by the action handle was pressed this frame.
+/// </summary>
+/// <remarks>
+/// Presses are counted from the input events, so a button that is pressed and released (or pressed several times)
+/// between two updates is reported.
+/// </remarks>
+/// <param name="action">The handle of the button to query.</param>
+/// <returns>The number of presses this frame.</returns>
+uint32_t getPressCount( ActionHandle action );
+
 /// <summary>
 /// Returns the value of the axis identified by axisName.
 /// </summary>
@@ -53,6 +181,13 @@ bool getButton( std::string_view buttonName );
 /// <returns>`true` if the button was pressed this frame, `false` otherwise.</returns>
 bool getButtonDown( std::string_view buttonName );
 
+/// <summary>
+/// Returns the number of times the button was pressed this frame.
+/// </summary>
+/// <param name="buttonName">The name of the button (or key) to query.</param>
+/// <returns>The number of presses this frame.</returns>
+uint32_t getPressCount( std::string_view buttonName );
+
 /// <summary>
 /// Returns `true` in the frame that the button is released.
 /// </summary>
@@ -95,6 +230,13 @@ bool getKey( Keyboard::Key key );
 /// <returns>`true` if the key is pressed this frame, `false` otherwise.</returns>
 bool getKeyDown( Keyboard::Key key );
 
+/// <summary>
+/// Returns the number of times the key was pressed this frame.
+/// </summary>
+/// <param name="key">The key to query.</param>
+/// <returns>The number of presses this frame.</returns>
+uint32_t getPressCount( Keyboard::Key key );
+
 /// <summary>
 /// Returns `true` in the frame that the key is released.
 /// </summary>
@@ -116,6 +258,13 @@ bool getMouseButton( Mouse::Button button );
 /// <returns>`true` if the mouse button is pressed this frame, `false` otherwise.</returns>
 bool getMouseButtonDown( Mouse::Button button );
 
+/// <summary>
+/// Returns the number of times the mouse button was pressed this frame.
+/// </summary>
+/// <param name="button">The mouse button to query.</param>
+/// <returns>The number of presses this frame.</returns>
+uint32_t getPressCount( Mouse::Button button );
+
 /// <summary>
 /// Returns true when the give mouse button is released this frame.
 /// </summary>
@@ -147,19 +296,120 @@ float getMouseMoveX();
 /// <returns>The change in the mouse's Y position.</returns>
 float getMouseMoveY();
 
+/// <summary>
+/// Retrieves the mouse motion events that were received during the last frame (oldest first).
+/// </summary>
+/// <remarks>
+/// The samples are valid until the next call to Input::update.
+/// </remarks>
+/// <returns>The motion samples of the last frame.</returns>
+std::span<const Mouse::MotionSample> getMouseMotion();
+
+/// <summary>
+/// An input event (see EventQueue).
+/// </summary>
+using Event = input::Event;
+
+/// <summary>
+/// Retrieves the input events that were received before the last call to Input::update, in the order they were received.
+/// </summary>
+/// <remarks>
+/// Input::update drains the event queue of the backends each frame. The events are valid until the next call to Input::update.
+/// Unlike the button states, the events report every key and button press, even if it is released in the same frame.
+/// </remarks>
+/// <returns>The events of the last frame.</returns>
+std::span<const Event> getEvents();
+
+/// <summary>
+/// Retrieves the number of events that were dropped in the last frame because the event queue was full.
+/// </summary>
+uint32_t getDroppedEventCount();
+
+/// <summary>
+/// Mark the end of the frame that reacted to the input (for example, after the rendering commands are submitted).
+/// </summary>
+/// <remarks>
+/// Completes the latency samples of the presses that were observed this frame (see getLatencyStats).
+/// Does nothing unless the library is built with INPUT_ENABLE_LATENCY_PROBE.
+/// </remarks>
+void markFrameSubmitted();
+
+/// <summary>
+/// Retrieves the latency of the input events for each device class and stage since the last reset.
+/// </summary>
+/// <remarks>
+/// The statistics are only recorded if the library is built with INPUT_ENABLE_LATENCY_PROBE (see LatencyProbe).
+/// Otherwise all counts are zero. Include LatencyProbe.hpp to call this function.
+/// </remarks>
+LatencyStats getLatencyStats();
+
+/// <summary>
+/// Clear the latency histograms of all device classes and stages, and discard the presses that were observed
+/// but not yet completed with markFrameSubmitted.
+/// </summary>
+void resetLatencyStats();
+
+using Stats = ProfileStats;
+
+/// <summary>
+/// Retrieves the profiling counters and the times of the instrumented scopes since the last reset.
+/// </summary>
+/// <remarks>
+/// The statistics are only recorded if the library is built with INPUT_ENABLE_PROFILING (see Profiler).
+/// Otherwise all counts are zero. Include Profiler.hpp to call this function.
+/// </remarks>
+Stats getStats();
+
+/// <summary>
+/// Clear the times of the instrumented scopes, the counters, and the trace buffer that writeTrace writes.
+/// </summary>
+void resetStats();
+
+/// <summary>
+/// Write the most recent instrumented scopes and the counters as a Chrome trace (JSON) that can be opened in Perfetto.
+/// </summary>
+void writeTrace( std::ostream& out );
+
+/// <summary>
+/// Record the input of each following call to Input::update to a file.
+/// </summary>
+/// <remarks>
+/// The raw device states and the events of each frame are recorded (see RecordingWriter). Open the file with
+/// Replay::open (in an application that is linked against the Replay backend) to replay the frames.
+/// A recording that is in progress is closed first.
+/// </remarks>
+/// <param name="path">The file to create.</param>
+/// <param name="keyframeInterval">The number of frames between two keyframes of the seek index
+/// (0 for RecordingWriter::DEFAULT_KEYFRAME_INTERVAL).</param>
+/// <returns>`false` if the file could not be created.</returns>
+bool startRecording( std::string_view path, uint32_t keyframeInterval = 0 );
+
+/// <summary>
+/// Write the seek index and close the recording.
+/// </summary>
+void stopRecording();
+
+/// <summary>
+/// Check whether a recording that was started with startRecording is in progress.
+/// </summary>
+/// <returns>`false` if no recording was started, or the last one was stopped with stopRecording.</returns>
+bool isRecording() noexcept;
+
 /// <summary>
 /// Map an axis name to an axis callback function.
 /// </summary>
 /// <param name="axisName">The name of the axis to map.</param>
 /// <param name="callback">The callback function to use to return the value of the axis.</param>
-void addAxisCallback( std::string_view axisName, AxisCallback callback );
+/// <param name="caching">Whether the result of the callback function is cached for the rest of the frame.</param>
+void addAxisCallback( std::string_view axisName, AxisCallback callback, CallbackCaching caching = CallbackCaching::PerFrame );
 
 /// <summary>
 /// Map a button name to a button callback function.
 /// </summary>
 /// <param name="buttonName">The name of the button or action to map to the callback function.</param>
 /// <param name="callback">The callback function used to return the value of the button.</param>
-void addButtonCallback( std::string_view buttonName, ButtonCallback callback );
+/// <param name="caching">Whether the result of the callback function is cached for the rest of the frame.</param>
+void addButtonCallback( std::string_view buttonName, ButtonCallback callback, CallbackCaching caching = CallbackCaching::PerFrame );
 
 /// <summary>
 /// Map a button name to a button callback function.
@@ -169,7 +419,8 @@ void addButtonCallback( std::string_view buttonName, ButtonCallback callback );
 /// </remarks>
 /// <param name="buttonName">The button name to map to the callback function.</param>
 /// <param name="callback">The callback function to evaluate the state of the button.</param>
-void addButtonDownCallback( std::string_view buttonName, ButtonCallback callback );
+/// <param name="caching">Whether the result of the callback function is cached for the rest of the frame.</param>
+void addButtonDownCallback( std::string_view buttonName, ButtonCallback callback, CallbackCaching caching = CallbackCaching::PerFrame );
 
 /// <summary>
 /// Map a button name to a button callback function.
@@ -179,7 +430,53 @@ void addButtonDownCallback( std::string_view buttonName, ButtonCallback callback
 /// </remarks>
 /// <param name="buttonName">The button name to map to the callback function.</param>
 /// <param name="callback">The callback function to evaluate the state of the button.</param>
-void addButtonUpCallback( std::string_view buttonName, ButtonCallback callback );
+/// <param name="caching">Whether the result of the callback function is cached for the rest of the frame.</param>
+void addButtonUpCallback( std::string_view buttonName, ButtonCallback callback, CallbackCaching caching = CallbackCaching::PerFrame );
+
+/// <summary>
+/// Bind a key to a digital action.
+/// </summary>
+/// <remarks>
+/// Digital bindings are evaluated for all actions at once in Input::update, so querying a bound action
+/// with getButton, getButtonDown, or getButtonUp is a single bit test.
+/// Multiple keys, mouse buttons, and gamepad buttons can be bound to the same action. The action is held
+/// if any of its bound inputs are held.
+/// Callback functions that are added with addButtonCallback, addButtonDownCallback, or addButtonUpCallback
+/// take precedence over the bindings.
+/// Bindings can be added to up to 256 actions per context. Bindings of further actions are ignored.
+/// </remarks>
+/// <param name="buttonName">The name of the action.</param>
+/// <param name="key">The key to bind to the action.</param>
+void addButtonBinding( std::string_view buttonName, Keyboard::Key key );
+
+/// <summary>
+/// Bind a mouse button to a digital action.
+/// </summary>
+/// <param name="buttonName">The name of the action.</param>
+/// <param name="button">The mouse button to bind to the action.</param>
+void addButtonBinding( std::string_view buttonName, Mouse::Button button );
+
+/// <summary>
+/// Bind a gamepad button to a digital action.
+/// </summary>
+/// <param name="buttonName">The name of the action.</param>
+/// <param name="button">The gamepad button to bind to the action.</param>
+/// <param name="playerIndex">The player index of the gamepad, or -1 to bind the button of all gamepads.</param>
+void addButtonBinding( std::string_view buttonName, Gamepad::Button button, int playerIndex = -1 );
+
+/// <summary>
+/// Add an on-screen touch region and bind it to the button with the same name.
+/// </summary>
+/// <remarks>
+/// A touch point that is placed on the region captures it until the touch point is released, so the
+/// button is held even if the touch point moves outside of the region. The regions are hit tested
+/// with a uniform grid in Input::update. Use InputContext::getTouchRegions (of Input::getDefaultContext)
+/// to move, enable, or query the regions.
+/// </remarks>
+/// <param name="buttonName">The name of the button.</param>
+/// <param name="rect">The rectangle of the region in normalized touch coordinates ([0...1]).</param>
+/// <returns>The index of the region, or UINT32_MAX if the maximum number of regions was reached.</returns>
+uint32_t addTouchRegion( std::string_view buttonName, const TouchRect& rect );
 }  // namespace Input
 
 }  // namespace input
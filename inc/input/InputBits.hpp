@@ -0,0 +1,172 @@
+#pragma once
+
+#include "EventQueue.hpp"
+#include "Gamepad.hpp"
+#include "Keyboard.hpp"
+#include "Mouse.hpp"
+
+#include <cstddef>
+#include <cstdint>
+#include <span>
+
+namespace input
+{
+
+/// <summary>
+/// A unified bit vector of all digital inputs.
+/// </summary>
+/// <remarks>
+/// The layout of the bit vector is:
+///  - Bits [0...256): The keyboard keys (bit n is Keyboard::Key n, the same layout as Keyboard::State).
+///  - Bits [256...512): The gamepad buttons, 32 bits for each player (bit n is Gamepad::Button n).
+///  - Bits [512...576): The mouse buttons (bit n is Mouse::Button n). The remaining bits are reserved.
+///  - Bits [576...768): The touch regions (bit n is region n of the TouchRegionMap of the context).
+///
+/// An InputBits can be used both as the state of the inputs and as a mask that selects a set of inputs
+/// (for example, all of the inputs that are bound to an action).
+/// </remarks>
+struct alignas( 32 ) InputBits
+{
+    static constexpr size_t KEYBOARD_OFFSET     = 0;
+    static constexpr size_t GAMEPAD_OFFSET      = 256;
+    static constexpr size_t GAMEPAD_STRIDE      = 32;
+    static constexpr size_t MOUSE_OFFSET        = 512;
+    static constexpr size_t TOUCH_REGION_OFFSET = 576;
+    static constexpr size_t TOUCH_REGION_COUNT  = 192;
+    static constexpr size_t BIT_COUNT           = 768;
+    static constexpr size_t WORD_COUNT          = BIT_COUNT / 64;
+
+    static_assert( static_cast<size_t>( Gamepad::Button::Count ) <= GAMEPAD_STRIDE );
+    static_assert( GAMEPAD_OFFSET + Gamepad::MAX_PLAYER_COUNT * GAMEPAD_STRIDE <= MOUSE_OFFSET );
+    static_assert( TOUCH_REGION_OFFSET % 64 == 0 && TOUCH_REGION_OFFSET + TOUCH_REGION_COUNT == BIT_COUNT );
+
+    uint64_t words[WORD_COUNT] {};
+
+    static constexpr size_t keyBit( Keyboard::Key key ) noexcept
+    {
+        return KEYBOARD_OFFSET + static_cast<size_t>( key );
+    }
+
+    static constexpr size_t gamepadBit( Gamepad::Button button, int playerIndex ) noexcept
+    {
+        return GAMEPAD_OFFSET + static_cast<size_t>( playerIndex ) * GAMEPAD_STRIDE + static_cast<size_t>( button );
+    }
+
+    static constexpr size_t mouseBit( Mouse::Button button ) noexcept
+    {
+        return MOUSE_OFFSET + static_cast<size_t>( button );
+    }
+
+    static constexpr size_t touchRegionBit( uint32_t region ) noexcept
+    {
+        return TOUCH_REGION_OFFSET + region;
+    }
+
+    constexpr void set( size_t bit ) noexcept
+    {
+        words[bit / 64] |= uint64_t { 1 } << ( bit % 64 );
+    }
+
+    constexpr void reset( size_t bit ) noexcept
+    {
+        words[bit / 64] &= ~( uint64_t { 1 } << ( bit % 64 ) );
+    }
+
+    constexpr bool test( size_t bit ) const noexcept
+    {
+        return ( words[bit / 64] >> ( bit % 64 ) & 1 ) != 0;
+    }
+
+    /// <summary>
+    /// Check if any of the bits in the mask are also set in this bit vector.
+    /// </summary>
+    constexpr bool any( const InputBits& mask ) const noexcept
+    {
+        uint64_t result = 0;
+        for ( size_t i = 0; i < WORD_COUNT; ++i )
+            result |= words[i] & mask.words[i];
+
+        return result != 0;
+    }
+
+    /// <summary>
+    /// Set the 32 gamepad bits for a player.
+    /// </summary>
+    constexpr void setGamepadButtons( int playerIndex, uint32_t buttons ) noexcept
+    {
+        const size_t bit   = gamepadBit( Gamepad::Button::A, playerIndex );
+        uint64_t&    word  = words[bit / 64];
+        const size_t shift = bit % 64;
+
+        word = ( word & ~( uint64_t { 0xffffffff } << shift ) ) | ( uint64_t { buttons } << shift );
+    }
+
+    /// <summary>
+    /// Set the touch region bits (one bit per region, TOUCH_REGION_COUNT bits).
+    /// </summary>
+    constexpr void setTouchRegions( std::span<const uint64_t, TOUCH_REGION_COUNT / 64> regions ) noexcept
+    {
+        for ( size_t i = 0; i < regions.size(); ++i )
+            words[TOUCH_REGION_OFFSET / 64 + i] = regions[i];
+    }
+
+    bool operator==( const InputBits& ) const = default;
+    bool operator!=( const InputBits& ) const = default;
+};
+
+/// <summary>
+/// The down, pressed, and released edges of all digital inputs for a single frame.
+/// </summary>
+struct InputEdges
+{
+    InputBits down;      ///< The inputs that are held down.
+    InputBits pressed;   ///< The inputs that were pressed this frame.
+    InputBits released;  ///< The inputs that were released this frame.
+};
+
+/// <summary>
+/// The number of times each keyboard key, gamepad button, and mouse button was pressed and released
+/// between two updates, counted from the input events.
+/// </summary>
+/// <remarks>
+/// The state of the inputs is only sampled once per update, so a button that is pressed and released between
+/// two updates does not change the state. The counts preserve these presses. They are indexed by the bit of
+/// the input in InputBits and saturate at 255. The pressed and released bit vectors have a bit set for each input
+/// with a nonzero press or release count.
+/// </remarks>
+struct InputCounts
+{
+    /// <summary>
+    /// The number of counted bits (the keyboard, gamepad, and mouse bits of InputBits).
+    /// </summary>
+    static constexpr size_t COUNT = InputBits::TOUCH_REGION_OFFSET;
+
+    InputBits pressed;
+    InputBits released;
+    uint8_t   presses[COUNT] {};
+    uint8_t   releases[COUNT] {};
+
+    /// <summary>
+    /// Count the key, mouse button, and gamepad button events (other events are ignored).
+    /// </summary>
+    void add( std::span<const Event> events ) noexcept;
+
+    void clear() noexcept;
+};
+
+/// <summary>
+/// Evaluate a set of masks against the input edges.
+/// </summary>
+/// <remarks>
+/// Bit i of each of the result bitsets is set if any of the bits in masks[i] are set in the corresponding edge.
+/// Each of the result spans must contain at least (masks.size() + 63) / 64 words.
+/// Uses AVX2, SSE2 or NEON when the target supports it.
+/// </remarks>
+/// <param name="masks">The masks to evaluate.</param>
+/// <param name="edges">The input edges to test the masks against.</param>
+/// <param name="down">Receives the bitset of masks that match a held input.</param>
+/// <param name="pressed">Receives the bitset of masks that match an input that was pressed this frame.</param>
+/// <param name="released">Receives the bitset of masks that match an input that was released this frame.</param>
+void evaluateMasks( std::span<const InputBits> masks, const InputEdges& edges, std::span<uint64_t> down, std::span<uint64_t> pressed, std::span<uint64_t> released ) noexcept;
+
+}  // namespace input
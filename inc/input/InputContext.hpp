@@ -0,0 +1,154 @@
+#pragma once
+
+#include "Input.hpp"
+
+#include <memory>
+#include <span>
+#include <string_view>
+
+namespace input
+{
+
+struct InputFrame;
+struct GestureSettings;
+struct TouchRect;
+class TouchRegionMap;
+class VirtualGamepad;
+
+namespace detail
+{
+struct InputContextData;
+}
+
+/// <summary>
+/// An InputContext owns a set of state trackers and action maps.
+/// </summary>
+/// <remarks>
+/// The functions in the Input namespace use a default context that is updated from the local backend
+/// (see Input::getDefaultContext). Additional contexts can be created to simulate remote players or bots,
+/// and are updated with explicit gamepad, keyboard, and mouse states (for example, received over the network).
+///
+/// Updating a context does not allocate memory (unless bindings were added since the last update).
+/// Handles to built-in actions (such as "Horizontal" or "Jump") are valid in all contexts. Handles to actions
+/// that are added to a context are only valid in that context.
+/// </remarks>
+class InputContext
+{
+public:
+    InputContext();
+    ~InputContext();
+
+    InputContext( const InputContext& )            = delete;
+    InputContext& operator=( const InputContext& ) = delete;
+
+    InputContext( InputContext&& ) noexcept;
+    InputContext& operator=( InputContext&& ) noexcept;
+
+    /// <summary>
+    /// Update the state of the context. Should only be called once per frame.
+    /// </summary>
+    /// <param name="gamepadStates">The state of each gamepad (up to Gamepad::MAX_PLAYER_COUNT). Missing gamepads are disconnected.</param>
+    /// <param name="keyboardState">The state of the keyboard.</param>
+    /// <param name="mouseState">The state of the mouse.</param>
+    void update( std::span<const Gamepad::State> gamepadStates, const Keyboard::State& keyboardState, const Mouse::State& mouseState );
+
+    /// <summary>
+    /// Update the state of the context, including touch input. Should only be called once per frame.
+    /// </summary>
+    /// <remarks>
+    /// The gestures are timed with the clock of the backend (see getEventTime), so they follow the virtual clock of the
+    /// Virtual backend and the recorded clock of the Replay backend.
+    /// </remarks>
+    void update( std::span<const Gamepad::State> gamepadStates, const Keyboard::State& keyboardState, const Mouse::State& mouseState, const Touch::State& touchState );
+
+    /// <summary>
+    /// Update the state of the context, including touch input, at an explicit time. Should only be called once per frame.
+    /// </summary>
+    /// <param name="timestamp">The time of the update in nanoseconds, on the clock of the touch timestamps (must not decrease).
+    /// It is used to time the gestures (see InputFrame::gestures).</param>
+    void update( std::span<const Gamepad::State> gamepadStates, const Keyboard::State& keyboardState, const Mouse::State& mouseState, const Touch::State& touchState,
+                 uint64_t timestamp );
+
+    /// <summary>
+    /// Set the thresholds that are used to recognize touch gestures (see InputFrame::gestures).
+    /// </summary>
+    void setGestureSettings( const GestureSettings& settings ) noexcept;
+
+    /// <summary>
+    /// Count the key, mouse button, and gamepad button events that were received since the last update.
+    /// </summary>
+    /// <remarks>
+    /// The states that are passed to update are only sampled once per frame, so a button that is pressed and released
+    /// between two updates is missed. The counted presses and releases are merged into the edges of the next update
+    /// (so getButtonDown and getButtonUp report them) and are reported by getPressCount. The timestamps of the events
+    /// are recorded in the state trackers (see KeyboardStateTracker::getPressTime). Input::update adds the events
+    /// of the backend to the default context.
+    /// </remarks>
+    void addEvents( std::span<const Event> events ) noexcept;
+
+    /// <summary>
+    /// Get the current state of the context.
+    /// </summary>
+    /// <remarks>
+    /// The returned frame is modified by the next call to update, so it should only be accessed on the thread that updates the context.
+    /// Use the frame to query keys, mouse buttons, or the state trackers of the context.
+    /// </remarks>
+    const InputFrame& getFrame() const noexcept;
+
+    /// <summary>
+    /// Resolve the name of an action to a handle that can be used to query the action.
+    /// </summary>
+    Input::ActionHandle getActionHandle( std::string_view actionName );
+
+    float getAxis( std::string_view axisName ) const;
+    float getAxis( Input::ActionHandle action ) const;
+
+    bool getButton( std::string_view buttonName ) const;
+    bool getButton( Input::ActionHandle action ) const;
+
+    bool getButtonDown( std::string_view buttonName ) const;
+    bool getButtonDown( Input::ActionHandle action ) const;
+
+    bool getButtonUp( std::string_view buttonName ) const;
+    bool getButtonUp( Input::ActionHandle action ) const;
+
+    uint32_t getPressCount( std::string_view buttonName ) const;
+    uint32_t getPressCount( Input::ActionHandle action ) const;
+
+    void addAxisCallback( std::string_view axisName, AxisCallback callback, CallbackCaching caching = CallbackCaching::PerFrame );
+    void addButtonCallback( std::string_view buttonName, ButtonCallback callback, CallbackCaching caching = CallbackCaching::PerFrame );
+    void addButtonDownCallback( std::string_view buttonName, ButtonCallback callback, CallbackCaching caching = CallbackCaching::PerFrame );
+    void addButtonUpCallback( std::string_view buttonName, ButtonCallback callback, CallbackCaching caching = CallbackCaching::PerFrame );
+
+    void addButtonBinding( std::string_view buttonName, Keyboard::Key key );
+    void addButtonBinding( std::string_view buttonName, Mouse::Button button );
+    void addButtonBinding( std::string_view buttonName, Gamepad::Button button, int playerIndex = -1 );
+
+    /// <summary>
+    /// Add an on-screen touch region and bind it to the action with the same name (see TouchRegionMap).
+    /// </summary>
+    /// <param name="buttonName">The name of the region and the action.</param>
+    /// <param name="rect">The rectangle of the region in normalized touch coordinates.</param>
+    /// <returns>The index of the region in the touch region map, or TouchRegionMap::INVALID_REGION if the map is full.</returns>
+    uint32_t addTouchRegion( std::string_view buttonName, const TouchRect& rect );
+
+    /// <summary>
+    /// Get the touch regions of the context (to move, enable, or query regions).
+    /// </summary>
+    TouchRegionMap&       getTouchRegions() noexcept;
+    const TouchRegionMap& getTouchRegions() const noexcept;
+
+    /// <summary>
+    /// Get the gamepad that is emulated with the touch regions of the context.
+    /// </summary>
+    /// <remarks>
+    /// The virtual gamepad is disabled until a player index is set with VirtualGamepad::setPlayerIndex.
+    /// It is merged into the gamepad states when the context is updated with touch input.
+    /// </remarks>
+    VirtualGamepad& getVirtualGamepad() noexcept;
+
+private:
+    std::unique_ptr<detail::InputContextData> m_Data;
+};
+
+}  // namespace input
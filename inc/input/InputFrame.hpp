@@ -0,0 +1,138 @@
+#pragma once
+
+#include "GestureRecognizer.hpp"
+#include "Input.hpp"
+#include "InputBits.hpp"
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <string_view>
+
+namespace input
+{
+
+namespace detail
+{
+struct ActionTable;
+struct InputContextData;
+}
+
+/// <summary>
+/// The input state of an InputContext for a single frame.
+/// </summary>
+/// <remarks>
+/// Input::update publishes a new snapshot at the end of each update. Use Input::getFrame to get the
+/// most recently published snapshot. A snapshot can be queried from any thread without locking.
+///
+/// The snapshots are triple-buffered: the snapshot that is returned by Input::getFrame is overwritten by the
+/// third call to Input::update after it was published. A worker thread that acquires the snapshot during a frame
+/// can keep using it for the rest of that frame, even while the main thread calls Input::update, but it must not
+/// keep it for longer.
+///
+/// A frame is trivially copyable, so publishing a snapshot does not allocate or free memory. The actions, callbacks,
+/// and button masks are not copied: each snapshot points to the action table of the context that it was evaluated
+/// with. The context does not modify a table that may have been published. Adding an action, callback, or binding
+/// replaces the table, and the previous table is freed after the snapshots that point to it have been overwritten.
+/// Callback functions are evaluated on the thread that queries the snapshot, so they must not modify shared state.
+/// Results queried from a snapshot are not cached.
+/// </remarks>
+struct alignas( 64 ) InputFrame
+{
+    /// <summary>
+    /// The number of times Input::update was called when this snapshot was published.
+    /// </summary>
+    uint64_t frameNumber = 0;
+
+    GamepadStateTracker  gamepadStates[Gamepad::MAX_PLAYER_COUNT];
+    KeyboardStateTracker keyboardState;
+    MouseStateTracker    mouseState;
+    TouchStateTracker    touchState;
+
+    /// <summary>
+    /// The gestures that were recognized from the touch state (only updated if the context is updated with touch input).
+    /// </summary>
+    GestureRecognizer gestures;
+
+    /// <summary>
+    /// The down, pressed, and released edges of all digital inputs.
+    /// </summary>
+    InputEdges edges;
+
+    /// <summary>
+    /// The number of times each input was pressed and released since the previous update (see InputContext::addEvents).
+    /// The edges include the inputs that were pressed or released according to the counts.
+    /// </summary>
+    InputCounts counts;
+
+    /// <summary>
+    /// The number of 64-bit words of button mask results. The built-in masks and the masks of the context share the
+    /// results, which limits the number of actions with bindings that can be added to a context.
+    /// </summary>
+    static constexpr size_t MAX_BUTTON_MASK_WORDS = 6;
+
+    /// <summary>
+    /// The result of evaluating the digital action masks (one bit per mask).
+    /// </summary>
+    std::array<uint64_t, MAX_BUTTON_MASK_WORDS> buttonMasksDown {};
+    std::array<uint64_t, MAX_BUTTON_MASK_WORDS> buttonMasksPressed {};
+    std::array<uint64_t, MAX_BUTTON_MASK_WORDS> buttonMasksReleased {};
+
+    /// <summary>
+    /// The actions, callbacks, and button masks that are used to query actions (null if the frame does not belong to a context).
+    /// The table is shared with the published snapshots, and replaced (not modified) when an action is added or changed.
+    /// </summary>
+    const detail::ActionTable* actions = nullptr;
+
+    /// <summary>
+    /// The context that owns the frame. Only the frame of the context caches the results of queries.
+    /// </summary>
+    const detail::InputContextData* context = nullptr;
+
+    uint64_t getFrameNumber() const noexcept
+    {
+        return frameNumber;
+    }
+
+    float getAxis( std::string_view axisName ) const;
+    float getAxis( Input::ActionHandle action ) const;
+
+    bool getButton( std::string_view buttonName ) const;
+    bool getButton( Input::ActionHandle action ) const;
+
+    bool getButtonDown( std::string_view buttonName ) const;
+    bool getButtonDown( Input::ActionHandle action ) const;
+
+    bool getButtonUp( std::string_view buttonName ) const;
+    bool getButtonUp( Input::ActionHandle action ) const;
+
+    /// <summary>
+    /// The number of times the inputs that are bound to the button were pressed this frame (for example, to detect
+    /// double taps within a single frame). An input that was pressed without a counted event is counted once.
+    /// </summary>
+    uint32_t getPressCount( std::string_view buttonName ) const;
+    uint32_t getPressCount( Input::ActionHandle action ) const;
+    uint32_t getPressCount( Keyboard::Key key ) const noexcept;
+    uint32_t getPressCount( Mouse::Button button ) const noexcept;
+    uint32_t getPressCount( Gamepad::Button button, int playerIndex ) const noexcept;
+
+    bool getKey( std::string_view keyName ) const;
+    bool getKey( Keyboard::Key key ) const noexcept;
+
+    bool getKeyDown( std::string_view keyName ) const;
+    bool getKeyDown( Keyboard::Key key ) const noexcept;
+
+    bool getKeyUp( std::string_view keyName ) const;
+    bool getKeyUp( Keyboard::Key key ) const noexcept;
+
+    bool getMouseButton( Mouse::Button button ) const noexcept;
+    bool getMouseButtonDown( Mouse::Button button ) const noexcept;
+    bool getMouseButtonUp( Mouse::Button button ) const noexcept;
+
+    float getMouseX() const noexcept;
+    float getMouseY() const noexcept;
+    float getMouseMoveX() const noexcept;
+    float getMouseMoveY() const noexcept;
+};
+
+}  // namespace input
@@ -0,0 +1,223 @@
+#pragma once
+
+#include "Keyboard.hpp"
+
+#include <algorithm>
+#include <cstddef>
+#include <string_view>
+
+namespace input
+{
+namespace Keyboard
+{
+/// <summary>
+/// Maps a (lower-case) key name to a Keyboard::Key.
+/// </summary>
+struct KeyName
+{
+    std::string_view name;
+    Key              key;
+};
+
+namespace detail
+{
+/// <summary>
+/// Convert an ASCII character to lower-case.
+/// </summary>
+constexpr char toLower( char c ) noexcept
+{
+    return ( c >= 'A' && c <= 'Z' ) ? static_cast<char>( c - 'A' + 'a' ) : c;
+}
+
+/// <summary>
+/// Case-insensitive, lexicographical comparison of two key names.
+/// </summary>
+/// <returns>A negative value if lhs is ordered before rhs, 0 if they are equal, and a positive value otherwise.</returns>
+constexpr int compareKeyNames( std::string_view lhs, std::string_view rhs ) noexcept
+{
+    const size_t count = std::min( lhs.size(), rhs.size() );
+    for ( size_t i = 0; i < count; ++i )
+    {
+        const auto l = static_cast<unsigned char>( toLower( lhs[i] ) );
+        const auto r = static_cast<unsigned char>( toLower( rhs[i] ) );
+        if ( l != r )
+            return l < r ? -1 : 1;
+    }
+
+    return lhs.size() < rhs.size() ? -1 : ( lhs.size() > rhs.size() ? 1 : 0 );
+}
+}  // namespace detail
+
+// clang-format off
+/// <summary>
+/// The key names that can be used with Input::getKey, Input::getKeyDown, and Input::getKeyUp.
+/// </summary>
+/// <remarks>
+/// This table must be sorted by name (in lower-case) so that it can be searched with a binary search.
+/// </remarks>
+inline constexpr KeyName KEY_NAMES[] = {
+    { "\"", Key::OemQuotes },
+    { "'", Key::OemQuotes },
+    { "+", Key::OemPlus },
+    { ",", Key::OemComma },
+    { "-", Key::OemMinus },
+    { ".", Key::OemPeriod },
+    { "0", Key::D0 },
+    { "1", Key::D1 },
+    { "2", Key::D2 },
+    { "3", Key::D3 },
+    { "4", Key::D4 },
+    { "5", Key::D5 },
+    { "6", Key::D6 },
+    { "7", Key::D7 },
+    { "8", Key::D8 },
+    { "9", Key::D9 },
+    { ";", Key::OemSemicolon },
+    { "?", Key::OemQuestion },
+    { "[", Key::OemOpenBrackets },
+    { "[*]", Key::Multiply },
+    { "[+]", Key::Add },
+    { "[-]", Key::Subtract },
+    { "[/]", Key::Divide },
+    { "[0]", Key::NumPad0 },
+    { "[1]", Key::NumPad1 },
+    { "[2]", Key::NumPad2 },
+    { "[3]", Key::NumPad3 },
+    { "[4]", Key::NumPad4 },
+    { "[5]", Key::NumPad5 },
+    { "[6]", Key::NumPad6 },
+    { "[7]", Key::NumPad7 },
+    { "[8]", Key::NumPad8 },
+    { "[9]", Key::NumPad9 },
+    { "[=]", Key::Separator },
+    { "\\", Key::OemPipe },
+    { "]", Key::OemCloseBrackets },
+    { "`", Key::OemTilde },
+    { "a", Key::A },
+    { "alt", Key::AltKey },
+    { "b", Key::B },
+    { "backspace", Key::Back },
+    { "c", Key::C },
+    { "caps", Key::CapsLock },
+    { "capslock", Key::CapsLock },
+    { "ctrl", Key::ControlKey },
+    { "d", Key::D },
+    { "delete", Key::Delete },
+    { "down", Key::Down },
+    { "e", Key::E },
+    { "end", Key::End },
+    { "enter", Key::Enter },
+    { "esc", Key::Escape },
+    { "escape", Key::Escape },
+    { "f", Key::F },
+    { "f1", Key::F1 },
+    { "f10", Key::F10 },
+    { "f11", Key::F11 },
+    { "f12", Key::F12 },
+    { "f2", Key::F2 },
+    { "f3", Key::F3 },
+    { "f4", Key::F4 },
+    { "f5", Key::F5 },
+    { "f6", Key::F6 },
+    { "f7", Key::F7 },
+    { "f8", Key::F8 },
+    { "f9", Key::F9 },
+    { "g", Key::G },
+    { "h", Key::H },
+    { "home", Key::Home },
+    { "i", Key::I },
+    { "ins", Key::Insert },
+    { "insert", Key::Insert },
+    { "j", Key::J },
+    { "k", Key::K },
+    { "l", Key::L },
+    { "left", Key::Left },
+    { "left alt", Key::LeftAlt },
+    { "left ctrl", Key::LeftControl },
+    { "left shift", Key::LeftShift },
+    { "left super", Key::LeftSuper },
+    { "left win", Key::LeftSuper },
+    { "m", Key::M },
+    { "n", Key::N },
+    { "o", Key::O },
+    { "p", Key::P },
+    { "page down", Key::PageDown },
+    { "page up", Key::PageUp },
+    { "pgdn", Key::PageDown },
+    { "pgup", Key::PageUp },
+    { "q", Key::Q },
+    { "r", Key::R },
+    { "return", Key::Enter },
+    { "right", Key::Right },
+    { "right alt", Key::RightAlt },
+    { "right ctrl", Key::RightControl },
+    { "right shift", Key::RightShift },
+    { "right super", Key::RightSuper },
+    { "right win", Key::RightSuper },
+    { "s", Key::S },
+    { "shift", Key::ShiftKey },
+    { "space", Key::Space },
+    { "t", Key::T },
+    { "tab", Key::Tab },
+    { "u", Key::U },
+    { "up", Key::Up },
+    { "v", Key::V },
+    { "w", Key::W },
+    { "x", Key::X },
+    { "y", Key::Y },
+    { "z", Key::Z },
+    { "{", Key::OemOpenBrackets },
+    { "|", Key::OemPipe },
+    { "}", Key::OemCloseBrackets },
+    { "~", Key::OemTilde },
+};
+// clang-format on
+
+static_assert( std::adjacent_find( std::begin( KEY_NAMES ), std::end( KEY_NAMES ), []( const KeyName& lhs, const KeyName& rhs ) {
+                   return detail::compareKeyNames( lhs.name, rhs.name ) >= 0;
+               } ) == std::end( KEY_NAMES ),
+               "KEY_NAMES must be sorted and must not contain duplicate names." );
+
+/// <summary>
+/// Find the key with the given name.
+/// </summary>
+/// <remarks>
+/// The key name is case-insensitive. This function does not allocate memory and can be evaluated at compile time.
+/// </remarks>
+/// <param name="keyName">The name of the key (see KEY_NAMES).</param>
+/// <returns>The key with the given name, or Key::None if there is no key with that name.</returns>
+constexpr Key keyFromName( std::string_view keyName ) noexcept
+{
+    const auto iter = std::lower_bound( std::begin( KEY_NAMES ), std::end( KEY_NAMES ), keyName, []( const KeyName& entry, std::string_view name ) {
+        return detail::compareKeyNames( entry.name, name ) < 0;
+    } );
+
+    if ( iter != std::end( KEY_NAMES ) && detail::compareKeyNames( iter->name, keyName ) == 0 )
+        return iter->key;
+
+    return Key::None;
+}
+}  // namespace Keyboard
+
+namespace literals
+{
+/// <summary>
+/// Resolve a key name to a Keyboard::Key at compile time.
+/// </summary>
+/// <remarks>
+/// An unknown key name results in a compile error.
+/// <code>
+/// using namespace input::literals;
+/// if ( Input::getKeyDown( "left shift"_key ) ) ...
+/// </code>
+/// </remarks>
+consteval Keyboard::Key operator""_key( const char* keyName, size_t length )
+{
+    const Keyboard::Key key = Keyboard::keyFromName( { keyName, length } );
+    if ( key == Keyboard::Key::None )
+        throw "Unknown key name.";  // Not a constant expression: unknown key names fail to compile.
+
+    return key;
+}
+}  // namespace literals
+}  // namespace input
@@ -1,6 +1,9 @@
 #pragma once
 
+#include "EdgeTimes.hpp"
+
 #include <cstdint>
+#include <span>
 
 namespace input
 {
@@ -462,6 +465,8 @@ void reset();
 bool isConnected();
 };  // namespace Keyboard
 
+struct Event;
+
 class KeyboardStateTracker
 {
 public:
@@ -469,6 +474,16 @@ public:
     Keyboard::State released;
     Keyboard::State lastState;
 
+    /// <summary>
+    /// The maximum number of keys with a recorded press or release time in a frame.
+    /// </summary>
+    static constexpr size_t MAX_EDGE_TIMES = 16;
+
+    /// <summary>
+    /// The timestamps of the key presses and releases of the last frame in nanoseconds (see getPressTime).
+    /// </summary>
+    EdgeTimes<MAX_EDGE_TIMES> edgeTimes;
+
     KeyboardStateTracker()
     {
         reset();
@@ -476,6 +491,15 @@ public:
 
     void update( const Keyboard::State& state );
 
+    /// <summary>
+    /// Record the timestamps of the key events (other events are ignored).
+    /// </summary>
+    /// <remarks>
+    /// Events carry the time that the backend received them, so the timestamps are more precise than the frame
+    /// in which the key is reported as pressed or released. The clock depends on the backend (see Event::timestamp).
+    /// </remarks>
+    void addEvents( std::span<const Event> events ) noexcept;
+
     void reset();
 
     bool isKeyPressed( Keyboard::Key key ) const noexcept
@@ -488,6 +512,24 @@ public:
         return released.isKeyDown( key );
     }
 
+    /// <summary>
+    /// Get the time of the latest press of a key in the last frame in nanoseconds.
+    /// Zero if no press event was received for the key in the last frame.
+    /// </summary>
+    uint64_t getPressTime( Keyboard::Key key ) const noexcept
+    {
+        return edgeTimes.get( static_cast<uint8_t>( key ), true );
+    }
+
+    /// <summary>
+    /// Get the time of the latest release of a key in the last frame in nanoseconds.
+    /// Zero if no release event was received for the key in the last frame.
+    /// </summary>
+    uint64_t getReleaseTime( Keyboard::Key key ) const noexcept
+    {
+        return edgeTimes.get( static_cast<uint8_t>( key ), false );
+    }
+
     Keyboard::State getLastState() const noexcept
     {
         return lastState;
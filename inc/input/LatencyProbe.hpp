@@ -0,0 +1,151 @@
+#pragma once
+
+#include "InputBits.hpp"
+
+#include <cstddef>
+#include <cstdint>
+#include <span>
+
+namespace input
+{
+
+struct Event;
+
+enum class DeviceClass : uint8_t
+{
+    Keyboard,
+    Mouse,
+    Gamepad,
+    Touch,
+    Count
+};
+
+/// <summary>
+/// The stages of the path of an input event from the OS to the frame that reacts to it.
+/// </summary>
+enum class LatencyStage : uint8_t
+{
+    Receive,  ///< From the timestamp of the event to the backend event watch (or callback) that queued it.
+    Queue,    ///< From the event watch to the Input::update that drained the event.
+    Consume,  ///< From Input::update to the first query that observed the press (for example, Input::getButtonDown).
+    Submit,   ///< From the query to Input::markFrameSubmitted.
+    Total,    ///< From the timestamp of the event to Input::markFrameSubmitted.
+    Count
+};
+
+/// <summary>
+/// The distribution of the latency of a stage in nanoseconds.
+/// </summary>
+struct LatencyPercentiles
+{
+    uint64_t count = 0;  ///< The number of recorded samples.
+    uint64_t p50   = 0;
+    uint64_t p95   = 0;
+    uint64_t p99   = 0;
+    uint64_t max   = 0;
+};
+
+struct LatencyStats
+{
+    LatencyPercentiles stages[static_cast<size_t>( DeviceClass::Count )][static_cast<size_t>( LatencyStage::Count )] {};
+
+    const LatencyPercentiles& get( DeviceClass device, LatencyStage stage ) const noexcept
+    {
+        return stages[static_cast<size_t>( device )][static_cast<size_t>( stage )];
+    }
+};
+
+/// <summary>
+/// A log-linear histogram of durations in nanoseconds.
+/// </summary>
+/// <remarks>
+/// Each power of two is divided into SUB_BUCKET_COUNT buckets, so a percentile is accurate to within 12.5%.
+/// Durations that are longer than about 9 minutes are counted in the last bucket.
+/// Adding a value does not allocate memory.
+/// </remarks>
+class LatencyHistogram
+{
+public:
+    static constexpr size_t SUB_BUCKET_BITS  = 3;
+    static constexpr size_t SUB_BUCKET_COUNT = size_t { 1 } << SUB_BUCKET_BITS;
+    static constexpr size_t BUCKET_COUNT     = SUB_BUCKET_COUNT * 37;
+
+    void add( uint64_t value ) noexcept;
+
+    void reset() noexcept;
+
+    /// <summary>
+    /// Get the smallest value that is greater than or equal to the given fraction of the values.
+    /// </summary>
+    /// <param name="fraction">The percentile in the range [0...1] (for example, 0.95 for the 95th percentile).</param>
+    /// <returns>The estimated percentile (the midpoint of its bucket), or 0 if the histogram is empty.</returns>
+    uint64_t getPercentile( double fraction ) const noexcept;
+
+    LatencyPercentiles getPercentiles() const noexcept;
+
+    uint64_t getCount() const noexcept
+    {
+        return m_Count;
+    }
+
+    uint64_t getMax() const noexcept
+    {
+        return m_Max;
+    }
+
+private:
+    static size_t   getBucket( uint64_t value ) noexcept;
+    static uint64_t getBucketStart( size_t bucket ) noexcept;
+
+    uint32_t m_Buckets[BUCKET_COUNT] {};
+    uint64_t m_Count = 0;
+    uint64_t m_Max   = 0;
+};
+
+/// <summary>
+/// Measures the latency of the input events (see Input::getLatencyStats).
+/// </summary>
+/// <remarks>
+/// The probe is only compiled in if INPUT_ENABLE_LATENCY_PROBE is defined (the CMake option of the same name).
+/// Otherwise the library does not call these functions, and getStats returns empty statistics.
+///
+/// Every event that is drained by Input::update records its Receive and Queue stages. The presses of keys,
+/// mouse buttons, and gamepad buttons are also sampled (at most MAX_SAMPLES per frame) until they are observed
+/// by a query of the default context and the frame is submitted, which records the Consume, Submit, and Total
+/// stages. Samples that are not observed before the next update are discarded.
+///
+/// All stages are measured with the clock of the backend (see getEventTime). The functions, except for stamp,
+/// must be called from the thread that calls Input::update.
+/// </remarks>
+namespace LatencyProbe
+{
+constexpr size_t MAX_SAMPLES = 32;
+
+/// <summary>
+/// Record the time that an event is pushed to the event queue (called by EventQueue::push).
+/// </summary>
+void stamp( Event& event ) noexcept;
+
+/// <summary>
+/// Record the events that were drained by Input::update and start sampling the presses.
+/// </summary>
+void update( std::span<const Event> events ) noexcept;
+
+/// <summary>
+/// Record the sampled presses of the inputs in the mask, if they have not been observed yet.
+/// </summary>
+void consume( const InputBits& mask ) noexcept;
+
+void consume( size_t bit ) noexcept;
+
+/// <summary>
+/// Record the submit time of the observed samples (see Input::markFrameSubmitted).
+/// </summary>
+void submit() noexcept;
+
+LatencyStats getStats() noexcept;
+
+void reset() noexcept;
+}  // namespace LatencyProbe
+
+}  // namespace input
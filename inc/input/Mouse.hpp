@@ -1,6 +1,11 @@
 #pragma once
 
 #include "ButtonState.hpp"
+#include "EdgeTimes.hpp"
+
+#include <cstddef>
+#include <cstdint>
+#include <span>
 
 namespace input
 {
@@ -126,8 +131,108 @@ bool isVisible() noexcept;
 void setVisible( bool visible );
 
 void setWindow( void* window );
+
+/// <summary>
+/// A single mouse motion event.
+/// </summary>
+struct MotionSample
+{
+    /// <summary>
+    /// The time of the event in nanoseconds. The clock depends on the backend, so only the
+    /// difference between two samples is meaningful.
+    /// </summary>
+    uint64_t timestamp;
+
+    /// <summary>
+    /// The position of the mouse cursor relative to the top-left corner of the window.
+    /// </summary>
+    float x;
+    float y;
+
+    /// <summary>
+    /// The motion since the previous event. In relative mode, this is the raw relative motion.
+    /// </summary>
+    float deltaX;
+    float deltaY;
+
+    /// <summary>
+    /// The buttons that were held during the motion (bit n is Button n).
+    /// </summary>
+    uint8_t buttons;
+
+    bool operator==( const MotionSample& ) const = default;
+    bool operator!=( const MotionSample& ) const = default;
+};
+
+/// <summary>
+/// The maximum number of motion samples that are recorded in a frame.
+/// </summary>
+constexpr size_t MAX_MOTION_SAMPLES = 256;
+
+/// <summary>
+/// Get the motion events that were received during the last frame (oldest first).
+/// </summary>
+/// <remarks>
+/// The frame ends when resetRelativeMotion is called (Input::update calls it each frame). The samples are
+/// valid until the next call to resetRelativeMotion. Mouse::State only reports the position at the end of the
+/// frame, the motion history can be used to draw strokes or smooth aiming with every motion event.
+/// </remarks>
+std::span<const MotionSample> getMotionHistory() noexcept;
+
+/// <summary>
+/// Get the number of motion samples that were dropped during the last frame because more than
+/// MAX_MOTION_SAMPLES motion events were received (the oldest samples are dropped).
+/// </summary>
+uint32_t getDroppedMotionSamples() noexcept;
+
+/// <summary>
+/// Records the motion samples of a frame in a preallocated ring buffer. Used by the backends to implement
+/// getMotionHistory.
+/// </summary>
+/// <remarks>
+/// The backend adds a sample for each motion event and calls endFrame in resetRelativeMotion. endFrame copies the
+/// ring buffer (oldest first) so that the samples of the last frame are contiguous while the next frame is recorded.
+/// The class does not lock, the backend must protect it with its own mutex if events are received on another thread.
+/// </remarks>
+class MotionHistory
+{
+public:
+    /// <summary>
+    /// Add a sample to the current frame. If the ring buffer is full, the oldest sample is dropped.
+    /// </summary>
+    void add( const MotionSample& sample ) noexcept;
+
+    /// <summary>
+    /// End the current frame. The samples of the frame are returned by getSamples until the next call to endFrame.
+    /// </summary>
+    void endFrame() noexcept;
+
+    std::span<const MotionSample> getSamples() const noexcept
+    {
+        return { m_Frame, m_FrameCount };
+    }
+
+    uint32_t getDroppedCount() const noexcept
+    {
+        return m_FrameDropped;
+    }
+
+private:
+    // The samples of the current frame.
+    MotionSample m_Ring[MAX_MOTION_SAMPLES] {};
+    uint32_t     m_Head    = 0;  ///< The index of the oldest sample.
+    uint32_t     m_Count   = 0;
+    uint32_t     m_Dropped = 0;
+
+    // The samples of the last frame.
+    MotionSample m_Frame[MAX_MOTION_SAMPLES] {};
+    uint32_t     m_FrameCount   = 0;
+    uint32_t     m_FrameDropped = 0;
+};
 }  // namespace Mouse
 
+struct Event;
+
 class MouseStateTracker
 {
 public:
@@ -142,6 +247,13 @@ public:
 
     int64_t scrollWheelDelta;
 
+    static constexpr size_t BUTTON_COUNT = 5;
+
+    /// <summary>
+    /// The timestamps of the button presses and releases of the last frame in nanoseconds (see getPressTime).
+    /// </summary>
+    EdgeTimes<BUTTON_COUNT * 2> edgeTimes;
+
     MouseStateTracker() noexcept
     {
         reset();
@@ -149,8 +261,31 @@ public:
 
     void update( const Mouse::State& state ) noexcept;
 
+    /// <summary>
+    /// Record the timestamps of the mouse button events (other events are ignored).
+    /// </summary>
+    void addEvents( std::span<const Event> events ) noexcept;
+
     void reset() noexcept;
 
+    /// <summary>
+    /// Get the time of the latest press of a button in the last frame in nanoseconds.
+    /// Zero if no press event was received for the button in the last frame.
+    /// </summary>
+    uint64_t getPressTime( Mouse::Button button ) const noexcept
+    {
+        return edgeTimes.get( static_cast<uint32_t>( button ), true );
+    }
+
+    /// <summary>
+    /// Get the time of the latest release of a button in the last frame in nanoseconds.
+    /// Zero if no release event was received for the button in the last frame.
+    /// </summary>
+    uint64_t getReleaseTime( Mouse::Button button ) const noexcept
+    {
+        return edgeTimes.get( static_cast<uint32_t>( button ), false );
+    }
+
     Mouse::State getLastState() const noexcept
     {
         return lastState;
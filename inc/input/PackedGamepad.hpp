@@ -0,0 +1,75 @@
+#pragma once
+
+#include "Gamepad.hpp"
+
+#include <cstdint>
+#include <span>
+
+namespace input
+{
+
+/// <summary>
+/// A compact 16-byte representation of Gamepad::State for storing replays and sending over the network.
+/// </summary>
+/// <remarks>
+/// The digital buttons and the d-pad are stored losslessly in a 16-bit mask (bit n is Gamepad::Button n,
+/// the same layout as PackGamepadButtons). The analog values are quantized:
+///  - Thumbsticks are clamped to [-1...1] and stored as int16 in steps of 1/32766.
+///  - Triggers are clamped to [0...1] and stored as uint8 in steps of 1/254.
+///
+/// Values are rounded away from zero, so the error of an analog value is less than one step. Because the
+/// thresholds of the virtual buttons (0.5) fall exactly on a step, the virtual threshold buttons
+/// (Gamepad::Button::LeftStickUp, Gamepad::Button::LeftTrigger, etc.) of an unpacked state are the same as
+/// those of the original state. Analog values must be finite.
+///
+/// Only the low 32 bits of Gamepad::State::packet are stored (as the sequence number).
+/// </remarks>
+struct PackedGamepadState
+{
+    static constexpr float    STICK_SCALE    = 32766.0f;
+    static constexpr float    TRIGGER_SCALE  = 254.0f;
+    static constexpr uint16_t BUTTON_MASK    = 0x3fff;  ///< The bits of the digital buttons and the d-pad.
+    static constexpr uint16_t CONNECTED_FLAG = 0x8000;  ///< Set if the gamepad is connected.
+
+    uint16_t buttons;       ///< The digital buttons, the d-pad, and the connected flag.
+    uint8_t  leftTrigger;   ///< The left trigger in the range [0...254].
+    uint8_t  rightTrigger;  ///< The right trigger in the range [0...254].
+    int16_t  leftX;         ///< The left thumbstick in the range [-32766...32766].
+    int16_t  leftY;
+    int16_t  rightX;        ///< The right thumbstick in the range [-32766...32766].
+    int16_t  rightY;
+    uint32_t sequence;      ///< The low 32 bits of Gamepad::State::packet.
+
+    bool operator==( const PackedGamepadState& ) const = default;
+    bool operator!=( const PackedGamepadState& ) const = default;
+};
+
+static_assert( sizeof( PackedGamepadState ) == 16 );
+
+/// <summary>
+/// Pack a gamepad state into the compact representation.
+/// </summary>
+PackedGamepadState PackGamepadState( const Gamepad::State& state ) noexcept;
+
+/// <summary>
+/// Unpack a gamepad state from the compact representation.
+/// </summary>
+Gamepad::State UnpackGamepadState( const PackedGamepadState& packed ) noexcept;
+
+/// <summary>
+/// Pack an array of gamepad states. Uses SSE2 or NEON when the target supports it.
+/// The result is the same as calling PackGamepadState for each state.
+/// </summary>
+/// <param name="states">The states to pack.</param>
+/// <param name="packed">Receives the packed states. Must be at least as large as states.</param>
+void PackGamepadStates( std::span<const Gamepad::State> states, std::span<PackedGamepadState> packed ) noexcept;
+
+/// <summary>
+/// Unpack an array of gamepad states. Uses SSE2 or NEON when the target supports it.
+/// The result is the same as calling UnpackGamepadState for each state.
+/// </summary>
+/// <param name="packed">The states to unpack.</param>
+/// <param name="states">Receives the unpacked states. Must be at least as large as packed.</param>
+void UnpackGamepadStates( std::span<const PackedGamepadState> packed, std::span<Gamepad::State> states ) noexcept;
+
+}  // namespace input
@@ -0,0 +1,176 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <iosfwd>
+#include <mutex>
+
+namespace input
+{
+
+/// <summary>
+/// The scopes that are timed by the profiler.
+/// </summary>
+enum class ProfileTimer : uint8_t
+{
+    Update,                 ///< Input::update.
+    KeyboardGetState,       ///< Keyboard::getState of the backend.
+    MouseGetState,          ///< Mouse::getState of the backend.
+    GamepadGetState,        ///< Gamepad::getState of the backend.
+    TouchGetState,          ///< Touch::getState of the backend.
+    KeyboardTrackerUpdate,  ///< KeyboardStateTracker::update.
+    MouseTrackerUpdate,     ///< MouseStateTracker::update.
+    GamepadTrackerUpdate,   ///< GamepadStateTracker::update.
+    TouchTrackerUpdate,     ///< TouchStateTracker::update.
+    Count
+};
+
+enum class ProfileCounter : uint8_t
+{
+    BuiltinActionHits,    ///< Action names that were found in the map of built-in actions.
+    UserActionHits,       ///< Action names that were found in the map of the actions of a context.
+    ActionMisses,         ///< Action names that were not found in either map.
+    CallbackInvocations,  ///< Axis and button callbacks that were evaluated (cached results are not counted).
+    MutexLocks,           ///< Locks of the mutexes of the backends.
+    MutexContentions,     ///< Locks that had to wait because the mutex was held by another thread.
+    KeyboardWatchEvents,  ///< Events that were processed by the keyboard event watch of the SDL backends.
+    MouseWatchEvents,
+    GamepadWatchEvents,
+    TouchWatchEvents,
+    Count
+};
+
+struct ProfileStats
+{
+    struct Timer
+    {
+        uint64_t count     = 0;  ///< The number of times the scope was entered.
+        uint64_t totalTime = 0;  ///< The total time in the scope in nanoseconds.
+        uint64_t maxTime   = 0;  ///< The longest time in the scope in nanoseconds.
+    };
+
+    Timer    timers[static_cast<size_t>( ProfileTimer::Count )] {};
+    uint64_t counters[static_cast<size_t>( ProfileCounter::Count )] {};
+
+    const Timer& get( ProfileTimer timer ) const noexcept
+    {
+        return timers[static_cast<size_t>( timer )];
+    }
+
+    uint64_t get( ProfileCounter counter ) const noexcept
+    {
+        return counters[static_cast<size_t>( counter )];
+    }
+};
+
+/// <summary>
+/// Counts and times the work of the library (see Input::getStats and Input::writeTrace).
+/// </summary>
+/// <remarks>
+/// The library is only instrumented if INPUT_ENABLE_PROFILING is defined (the CMake option of the same name).
+/// Otherwise the INPUT_PROFILE_SCOPE and INPUT_PROFILE_COUNT macros expand to nothing, Mutex is a std::mutex,
+/// and the statistics and the trace are empty.
+///
+/// The functions can be called from any thread. The last TRACE_CAPACITY timed scopes are kept for the trace.
+/// </remarks>
+namespace Profiler
+{
+constexpr size_t TRACE_CAPACITY = 16384;
+
+/// <summary>
+/// The time of the profiler clock in nanoseconds.
+/// </summary>
+uint64_t now() noexcept;
+
+void addTime( ProfileTimer timer, uint64_t start, uint64_t end ) noexcept;
+
+void count( ProfileCounter counter, uint64_t value = 1 ) noexcept;
+
+ProfileStats getStats() noexcept;
+
+/// <summary>
+/// Write the timed scopes and the counters in the Chrome trace event format (JSON). The output can be
+/// opened in Perfetto (https://ui.perfetto.dev) or chrome://tracing.
+/// </summary>
+void writeTrace( std::ostream& out );
+
+void reset() noexcept;
+
+const char* getName( ProfileTimer timer ) noexcept;
+const char* getName( ProfileCounter counter ) noexcept;
+
+/// <summary>
+/// Times the scope that it is declared in.
+/// </summary>
+class ScopedTimer
+{
+public:
+    explicit ScopedTimer( ProfileTimer timer ) noexcept
+    : m_Timer( timer )
+    , m_Start( now() )
+    {}
+
+    ~ScopedTimer()
+    {
+        addTime( m_Timer, m_Start, now() );
+    }
+
+    ScopedTimer( const ScopedTimer& )            = delete;
+    ScopedTimer& operator=( const ScopedTimer& ) = delete;
+
+private:
+    ProfileTimer m_Timer;
+    uint64_t     m_Start;
+};
+}  // namespace Profiler
+
+#ifdef INPUT_ENABLE_PROFILING
+
+/// <summary>
+/// A mutex that counts how often it is locked and how often a lock has to wait.
+/// </summary>
+class Mutex
+{
+public:
+    void lock()
+    {
+        if ( !m_Mutex.try_lock() )
+        {
+            Profiler::count( ProfileCounter::MutexContentions );
+            m_Mutex.lock();
+        }
+
+        Profiler::count( ProfileCounter::MutexLocks );
+    }
+
+    bool try_lock()
+    {
+        const bool locked = m_Mutex.try_lock();
+        if ( locked )
+            Profiler::count( ProfileCounter::MutexLocks );
+
+        return locked;
+    }
+
+    void unlock()
+    {
+        m_Mutex.unlock();
+    }
+
+private:
+    std::mutex m_Mutex;
+};
+
+#define INPUT_PROFILE_SCOPE( timer ) const ::input::Profiler::ScopedTimer inputProfileScope { ::input::ProfileTimer::timer }
+#define INPUT_PROFILE_COUNT( counter ) ::input::Profiler::count( ::input::ProfileCounter::counter )
+
+#else
+
+using Mutex = std::mutex;
+
+#define INPUT_PROFILE_SCOPE( timer )
+#define INPUT_PROFILE_COUNT( counter )
+
+#endif
+
+}  // namespace input
@@ -0,0 +1,156 @@
+#pragma once
+
+#include "EventQueue.hpp"
+#include "Gamepad.hpp"
+#include "Keyboard.hpp"
+#include "Mouse.hpp"
+#include "Touch.hpp"
+
+#include <cstddef>
+#include <cstdint>
+#include <fstream>
+#include <string>
+#include <vector>
+
+namespace input
+{
+
+/// <summary>
+/// The input of a frame of Input::update: the device states and the events that are passed to the default context.
+/// </summary>
+struct RecordedFrame
+{
+    Keyboard::State    keyboard {};
+    Mouse::State       mouse {};
+    Gamepad::State     gamepads[Gamepad::MAX_PLAYER_COUNT] {};  ///< The raw states (Gamepad::DeadZone::None).
+    Touch::State       touch {};
+    std::vector<Event> events;
+    uint64_t           timestamp = 0;  ///< The time of the frame in nanoseconds, on the clock of the backend (see getEventTime).
+};
+
+/// <summary>
+/// Writes the frames of an input recording to a file.
+/// </summary>
+/// <remarks>
+/// The device states of each frame are delta-encoded against the previous frame. Every keyframeInterval frames,
+/// the states are written in full, and the offsets of the keyframes are written to a seek index when the file is
+/// closed. The values are stored bit for bit, so a replay of the recording produces the same frames.
+///
+/// Use Input::startRecording to record the frames of Input::update.
+/// </remarks>
+class RecordingWriter
+{
+public:
+    static constexpr uint32_t DEFAULT_KEYFRAME_INTERVAL = 300;
+
+    RecordingWriter() = default;
+    ~RecordingWriter();
+
+    RecordingWriter( const RecordingWriter& )            = delete;
+    RecordingWriter( RecordingWriter&& )                 = delete;
+    RecordingWriter& operator=( const RecordingWriter& ) = delete;
+    RecordingWriter& operator=( RecordingWriter&& )      = delete;
+
+    /// <summary>
+    /// Create (or replace) a recording file.
+    /// </summary>
+    /// <returns>`false` if the file could not be created.</returns>
+    bool open( const std::string& path, uint32_t keyframeInterval = DEFAULT_KEYFRAME_INTERVAL );
+
+    /// <summary>
+    /// Write the seek index and close the file.
+    /// </summary>
+    void close();
+
+    bool isOpen() const noexcept
+    {
+        return m_File.is_open();
+    }
+
+    void write( const RecordedFrame& frame );
+
+    uint64_t getFrameCount() const noexcept
+    {
+        return m_FrameCount;
+    }
+
+private:
+    struct Keyframe
+    {
+        uint64_t frame;
+        uint64_t offset;
+    };
+
+    std::ofstream         m_File;
+    uint32_t              m_KeyframeInterval = DEFAULT_KEYFRAME_INTERVAL;
+    uint64_t              m_FrameCount       = 0;
+    uint64_t              m_Offset           = 0;
+    uint64_t              m_Timestamp        = 0;  ///< The timestamp of the previous frame.
+    std::vector<uint8_t>  m_States;      ///< The encoded device states of the previous frame.
+    std::vector<uint8_t>  m_NextStates;  ///< The encoded device states of the frame that is written.
+    std::vector<uint8_t>  m_Buffer;
+    std::vector<Keyframe> m_Index;
+};
+
+/// <summary>
+/// Reads the frames of an input recording from a memory-mapped file.
+/// </summary>
+/// <remarks>
+/// Reading the frames in order decodes each frame once. Reading any other frame decodes the frames from the
+/// nearest keyframe, so a long recording can be sought without reading the frames before it. If the recording
+/// was not closed (for example, because the application crashed), the frames are scanned to rebuild the index.
+/// </remarks>
+class RecordingReader
+{
+public:
+    RecordingReader() = default;
+    ~RecordingReader();
+
+    RecordingReader( const RecordingReader& )            = delete;
+    RecordingReader( RecordingReader&& )                 = delete;
+    RecordingReader& operator=( const RecordingReader& ) = delete;
+    RecordingReader& operator=( RecordingReader&& )      = delete;
+
+    /// <returns>`false` if the file could not be mapped or is not a recording.</returns>
+    bool open( const std::string& path );
+
+    void close();
+
+    bool isOpen() const noexcept
+    {
+        return m_Data != nullptr;
+    }
+
+    uint64_t getFrameCount() const noexcept
+    {
+        return m_FrameCount;
+    }
+
+    /// <summary>
+    /// Decode a frame of the recording.
+    /// </summary>
+    /// <returns>`false` if the index is out of range or the file is corrupt.</returns>
+    bool read( uint64_t index, RecordedFrame& frame );
+
+private:
+    struct Keyframe
+    {
+        uint64_t frame;
+        uint64_t offset;
+    };
+
+    bool decode( RecordedFrame& frame );
+    bool buildIndex();
+
+    const uint8_t*        m_Data       = nullptr;
+    size_t                m_Size       = 0;
+    void*                 m_Mapping    = nullptr;  ///< The file mapping object on Windows.
+    uint64_t              m_FrameCount = 0;
+    uint64_t              m_NextFrame  = 0;  ///< The frame at m_Offset.
+    size_t                m_Offset     = 0;
+    uint64_t              m_Timestamp  = 0;  ///< The timestamp of the previous frame.
+    std::vector<uint8_t>  m_States;  ///< The encoded device states of the previous frame.
+    std::vector<Keyframe> m_Index;
+};
+
+}  // namespace input
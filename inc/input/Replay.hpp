@@ -0,0 +1,78 @@
+#pragma once
+
+#include "EventQueue.hpp"
+#include "Gamepad.hpp"
+#include "Keyboard.hpp"
+#include "Mouse.hpp"
+#include "Touch.hpp"
+
+#include <cstdint>
+#include <string>
+
+namespace input
+{
+
+/// <summary>
+/// The playback API of the Replay backend (the input::Replay CMake target).
+/// </summary>
+/// <remarks>
+/// The Replay backend does not read any OS input. The Keyboard, Mouse, Gamepad, and Touch functions report
+/// the device states of a recording that was made with Input::startRecording, one frame for each call to
+/// Input::update (the frame advances in beginFrame, which Input::update calls first). The events of the frame
+/// are added to the event queue, so Input::update passes the same states and events to the default context as in
+/// the recorded run, and the state trackers, actions, and Input::getEvents return the same values. The clock of the
+/// backend (see getEventTime) is the recorded time of the replayed frame, so the gestures are timed the same as well.
+///
+/// A replay from frame 0 is bit-identical. After seek, the device states and the events are the recorded
+/// ones, but the state that Input::update keeps between frames (the stick processor and the trackers) continues
+/// from the frame before the seek, so the first frames after a seek can differ (for example, a key that is
+/// held at the seek target is reported as pressed in that frame).
+///
+/// The player of Gamepad::MOST_RECENT_PLAYER is not recorded. It is the last gamepad that was connected or
+/// changed in the replayed frames, which can differ from the recorded run if several gamepads changed in a frame.
+///
+/// The functions must be called from the thread that calls Input::update. After the last frame (or if no
+/// recording is open), all devices are released and disconnected.
+/// </remarks>
+namespace Replay
+{
+
+/// <summary>
+/// Open a recording and start the replay at frame 0. A recording that is open is closed first.
+/// </summary>
+/// <returns>`false` if the file is not a recording.</returns>
+bool open( const std::string& path );
+
+void close();
+
+uint64_t getFrameCount();
+
+/// <summary>
+/// Get the index of the frame that is replayed by the next call to Input::update.
+/// </summary>
+uint64_t getFrameIndex();
+
+/// <summary>
+/// Set the frame that is replayed by the next call to Input::update.
+/// </summary>
+/// <returns>`false` if the frame is out of range.</returns>
+bool seek( uint64_t frame );
+
+/// <summary>
+/// Check if all frames of the recording were replayed.
+/// </summary>
+bool isFinished();
+
+namespace detail
+{
+Keyboard::State getKeyboardState() noexcept;                                    ///< Defined in PlayerReplay.cpp
+Mouse::State    getMouseState() noexcept;                                       ///< Defined in PlayerReplay.cpp
+Gamepad::State  getGamepadState( int player ) noexcept;                         ///< Defined in PlayerReplay.cpp
+Touch::State    getTouchState() noexcept;                                       ///< Defined in PlayerReplay.cpp
+bool            isPlaying() noexcept;                                           ///< Defined in PlayerReplay.cpp
+void            addMotionSample( const Mouse::MotionSample& sample ) noexcept;  ///< Defined in MouseReplay.cpp
+}  // namespace detail
+
+}  // namespace Replay
+
+}  // namespace input
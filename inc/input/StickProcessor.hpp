@@ -0,0 +1,142 @@
+#pragma once
+
+#include "Gamepad.hpp"
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <span>
+
+namespace input
+{
+
+/// <summary>
+/// A response curve that is applied to a thumbstick after the dead zone.
+/// </summary>
+/// <remarks>
+/// The curve maps the range [0...1] to [0...1] and is stored as a lookup table of evenly spaced points that is
+/// linearly interpolated. The default curve is linear (the value is not changed).
+/// </remarks>
+class ResponseCurve
+{
+public:
+    static constexpr size_t SEGMENT_COUNT = 64;
+
+    ResponseCurve() noexcept;
+
+    /// <summary>
+    /// The value is not changed.
+    /// </summary>
+    static ResponseCurve linear() noexcept;
+
+    /// <summary>
+    /// The value is raised to the power of the exponent (values greater than 1 give more precision near the center).
+    /// </summary>
+    static ResponseCurve exponential( float exponent ) noexcept;
+
+    /// <summary>
+    /// A custom curve through evenly spaced points. The first point is the output for 0, the last point is the output for 1.
+    /// </summary>
+    /// <param name="points">At least two points. If fewer points are given, the curve is linear.</param>
+    static ResponseCurve table( std::span<const float> points ) noexcept;
+
+    bool isLinear() const noexcept
+    {
+        return m_Linear;
+    }
+
+    /// <summary>
+    /// Evaluate the curve. The value is clamped to the range [0...1].
+    /// </summary>
+    float evaluate( float value ) const noexcept;
+
+    const std::array<float, SEGMENT_COUNT + 1>& getPoints() const noexcept
+    {
+        return m_Points;
+    }
+
+private:
+    std::array<float, SEGMENT_COUNT + 1> m_Points;
+    bool                                 m_Linear = true;
+};
+
+/// <summary>
+/// The dead zone and response curve settings of the thumbsticks of a gamepad.
+/// </summary>
+/// <remarks>
+/// The default settings match the state that is returned by Gamepad::getState with the IndependentAxis dead zone mode.
+/// </remarks>
+struct StickSettings
+{
+    Gamepad::DeadZone deadZoneMode  = Gamepad::DeadZone::IndependentAxis;
+    float             innerDeadZone = 0.24f;  ///< Values inside the inner dead zone are zero (ignored in the None mode).
+    float             outerDeadZone = 1.0f;   ///< Values outside the outer dead zone are one.
+
+    /// <summary>
+    /// Applied to each axis in the IndependentAxis and None modes, and to the length of the stick in the other modes.
+    /// </summary>
+    ResponseCurve responseCurve;
+};
+
+/// <summary>
+/// Apply the stick settings to a single thumbstick.
+/// </summary>
+/// <param name="settings">The dead zone and response curve settings.</param>
+/// <param name="x">The raw X axis of the thumbstick.</param>
+/// <param name="y">The raw Y axis of the thumbstick.</param>
+/// <param name="resultX">Receives the processed X axis.</param>
+/// <param name="resultY">Receives the processed Y axis.</param>
+void ApplyStickSettings( const StickSettings& settings, float x, float y, float& resultX, float& resultY ) noexcept;
+
+/// <summary>
+/// Applies per-player dead zones and response curves to the thumbsticks of all gamepads at once.
+/// </summary>
+/// <remarks>
+/// Input::update reads the raw gamepad states (with DeadZone::None) and processes all of the thumbsticks
+/// of all players with the stick processor that is returned by Input::getStickProcessor.
+/// The thumbsticks are processed in one pass using SSE2 or NEON when the target supports it. The results
+/// are the same as ApplyStickSettings.
+/// </remarks>
+class StickProcessor
+{
+public:
+    StickProcessor() noexcept;
+
+    /// <summary>
+    /// Set the stick settings of a player.
+    /// </summary>
+    /// <param name="playerIndex">The index of the player, or -1 to set the settings of all players.</param>
+    /// <param name="settings">The new settings.</param>
+    void setSettings( int playerIndex, const StickSettings& settings ) noexcept;
+
+    const StickSettings& getSettings( int playerIndex ) const noexcept;
+
+    /// <summary>
+    /// Apply the stick settings to the thumbsticks of the gamepad states (states[i] uses the settings of player i).
+    /// </summary>
+    /// <param name="states">The raw gamepad states (up to Gamepad::MAX_PLAYER_COUNT).</param>
+    void process( std::span<Gamepad::State> states ) const noexcept;
+
+private:
+    // Two thumbsticks per player. Stick n is the left (even n) or right (odd n) thumbstick of player n / 2.
+    static constexpr size_t STICK_COUNT = Gamepad::MAX_PLAYER_COUNT * 2;
+
+    void updateLanes( int playerIndex ) noexcept;
+
+    StickSettings m_Settings[Gamepad::MAX_PLAYER_COUNT];
+
+    // The settings of each stick in structure-of-arrays form (the masks are 0 or ~0).
+    struct alignas( 16 ) Lanes
+    {
+        float    innerDeadZone[STICK_COUNT];
+        float    outerDeadZone[STICK_COUNT];
+        uint32_t axial[STICK_COUNT];   ///< IndependentAxis or None.
+        uint32_t radial[STICK_COUNT];  ///< Radial.
+        uint32_t hybrid[STICK_COUNT];  ///< Hybrid.
+        uint32_t curved[STICK_COUNT];  ///< The response curve is not linear.
+    } m_Lanes;
+
+    bool m_Curved = false;  ///< The response curve of any player is not linear.
+};
+
+}  // namespace input
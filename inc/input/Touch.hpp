@@ -1,9 +1,10 @@
 #pragma once
 
 #include "ButtonState.hpp"
+#include "FixedVector.hpp"
 
+#include <cstddef>
 #include <cstdint>
-#include <vector>
 
 namespace input
 {
@@ -87,6 +88,12 @@ struct TouchPoint
     bool operator!=( const TouchPoint& ) const = default;
 };
 
+/// <summary>
+/// The active touch points. The touch points are stored inline, touch points that are added when
+/// the list is full (more than MAX_TOUCH_COUNT) are ignored.
+/// </summary>
+using TouchList = FixedVector<TouchPoint, MAX_TOUCH_COUNT>;
+
 /// <summary>
 /// The state of all touch input.
 /// Use Touch::getState() to query the current state of touch input.
@@ -96,7 +103,7 @@ struct State
     /// <summary>
     /// The collection of active touch points.
     /// </summary>
-    std::vector<TouchPoint> touches;
+    TouchList touches;
 
     /// <summary>
     /// Used to check if this State is equivalent to another.
@@ -161,6 +168,12 @@ public:
         float       pressure;
     };
 
+    /// <summary>
+    /// The touches that are pressed or held (at most Touch::MAX_TOUCH_COUNT), followed by the touches
+    /// that were released since the last update (at most Touch::MAX_TOUCH_COUNT).
+    /// </summary>
+    using TrackedTouches = FixedVector<TrackedTouch, Touch::MAX_TOUCH_COUNT * 2>;
+
     TouchStateTracker() noexcept
     {
         reset();
@@ -181,7 +194,7 @@ public:
     /// Get the last recorded touch state.
     /// </summary>
     /// <returns>The last touch state.</returns>
-    Touch::State getLastState() const noexcept
+    const Touch::State& getLastState() const noexcept
     {
         return lastState;
     }
@@ -189,15 +202,15 @@ public:
     /// <summary>
     /// Get the collection of tracked touches.
     /// </summary>
-    /// <returns>Vector of tracked touch points.</returns>
-    const std::vector<TrackedTouch>& getTrackedTouches() const noexcept
+    /// <returns>The tracked touch points.</returns>
+    const TrackedTouches& getTrackedTouches() const noexcept
     {
         return trackedTouches;
     }
 
 private:
-    Touch::State             lastState;
-    std::vector<TrackedTouch> trackedTouches;
+    Touch::State   lastState;
+    TrackedTouches trackedTouches;
 };
 
 }  // namespace input
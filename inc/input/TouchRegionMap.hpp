@@ -0,0 +1,197 @@
+#pragma once
+
+#include "InputBits.hpp"
+#include "Touch.hpp"
+
+#include <cstddef>
+#include <cstdint>
+#include <span>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace input
+{
+
+/// <summary>
+/// A rectangle in normalized touch coordinates ([0...1], the same space as Touch::TouchPoint).
+/// </summary>
+struct TouchRect
+{
+    float left   = 0.0f;
+    float top    = 0.0f;
+    float right  = 0.0f;
+    float bottom = 0.0f;
+
+    constexpr bool contains( float x, float y ) const noexcept
+    {
+        return x >= left && x < right && y >= top && y < bottom;
+    }
+
+    bool operator==( const TouchRect& ) const = default;
+    bool operator!=( const TouchRect& ) const = default;
+};
+
+/// <summary>
+/// A set of named regions of the touch surface (for example, on-screen buttons) that are hit tested with a uniform grid.
+/// </summary>
+/// <remarks>
+/// A touch point captures the top-most region under the point where it was placed (regions that are added
+/// later are on top). The region keeps the touch point until it is released, even if it moves outside of the
+/// region. A region is held while at least one touch point has captured it. Regions that a touch point
+/// moves into without capturing them are reported as entered for one frame.
+///
+/// The cost of an update is linear in the number of tracked touches (each hit test only checks the regions
+/// that overlap one grid cell). Memory is only allocated when regions are added.
+///
+/// InputContext::addTouchRegion adds a region to the map of a context and binds it to the action with the same
+/// name, so the region can be queried with Input::getButton, Input::getButtonDown, and Input::getButtonUp.
+/// </remarks>
+class TouchRegionMap
+{
+public:
+    static constexpr uint32_t MAX_REGION_COUNT = InputBits::TOUCH_REGION_COUNT;
+    static constexpr uint32_t INVALID_REGION   = UINT32_MAX;
+    static constexpr size_t   WORD_COUNT       = MAX_REGION_COUNT / 64;
+
+    /// <summary>
+    /// The number of grid cells in each direction.
+    /// </summary>
+    static constexpr size_t GRID_SIZE = 16;
+
+    using RegionBits = std::span<const uint64_t, WORD_COUNT>;
+
+    /// <summary>
+    /// Add a region. If a region with the same name already exists, its rectangle is changed instead.
+    /// </summary>
+    /// <param name="name">The name of the region.</param>
+    /// <param name="rect">The rectangle of the region in normalized touch coordinates.</param>
+    /// <returns>The index of the region, or INVALID_REGION if the map is full.</returns>
+    uint32_t addRegion( std::string_view name, const TouchRect& rect );
+
+    /// <summary>
+    /// Move or resize a region. Touch points that have captured the region keep it.
+    /// </summary>
+    void setRect( uint32_t region, const TouchRect& rect ) noexcept;
+
+    /// <summary>
+    /// Disabled regions are not hit tested. Touch points that have captured the region keep it.
+    /// </summary>
+    void setEnabled( uint32_t region, bool enabled ) noexcept;
+
+    /// <summary>
+    /// Find a region by name.
+    /// </summary>
+    /// <returns>The index of the region, or INVALID_REGION if there is no region with that name.</returns>
+    uint32_t findRegion( std::string_view name ) const noexcept;
+
+    uint32_t getRegionCount() const noexcept
+    {
+        return static_cast<uint32_t>( m_Regions.size() );
+    }
+
+    std::string_view getName( uint32_t region ) const noexcept;
+    TouchRect        getRect( uint32_t region ) const noexcept;
+    bool             isEnabled( uint32_t region ) const noexcept;
+
+    /// <summary>
+    /// Find the top-most enabled region that contains a point.
+    /// </summary>
+    /// <returns>The index of the region, or INVALID_REGION if no region contains the point.</returns>
+    uint32_t hitTest( float x, float y ) const noexcept;
+
+    /// <summary>
+    /// Update the regions with the tracked touches. Should be called once per frame after TouchStateTracker::update.
+    /// </summary>
+    void update( const TouchStateTracker& touches ) noexcept;
+
+    /// <summary>
+    /// Release all touch points (without reporting the regions as released).
+    /// </summary>
+    void reset() noexcept;
+
+    /// <summary>
+    /// Get the state of a region: Pressed in the frame that the first touch point captures the region,
+    /// Held while it is captured, and Released in the frame that the last touch point releases it.
+    /// </summary>
+    ButtonState getState( uint32_t region ) const noexcept;
+
+    /// <summary>
+    /// Returns `true` in the frame that a touch point (that has not captured the region) moves into the region.
+    /// </summary>
+    bool isEntered( uint32_t region ) const noexcept;
+
+    /// <summary>
+    /// Get the position of the (first) touch point that has captured the region.
+    /// </summary>
+    /// <returns>`false` if the region is not held.</returns>
+    bool getTouchPosition( uint32_t region, float& x, float& y ) const noexcept;
+
+    /// <summary>
+    /// Get the ID of the (first) touch point that has captured the region, or -1 if the region is not held.
+    /// </summary>
+    int64_t getTouchId( uint32_t region ) const noexcept;
+
+    /// <summary>
+    /// The regions that are held, pressed, released, or entered this frame (bit n is region n).
+    /// </summary>
+    RegionBits getDown() const noexcept
+    {
+        return RegionBits { m_Down, WORD_COUNT };
+    }
+
+    RegionBits getPressed() const noexcept
+    {
+        return RegionBits { m_Pressed, WORD_COUNT };
+    }
+
+    RegionBits getReleased() const noexcept
+    {
+        return RegionBits { m_Released, WORD_COUNT };
+    }
+
+    RegionBits getEntered() const noexcept
+    {
+        return RegionBits { m_Entered, WORD_COUNT };
+    }
+
+private:
+    struct Region
+    {
+        TouchRect rect;
+        bool      enabled = true;
+    };
+
+    struct Finger
+    {
+        int64_t  id;
+        float    x;
+        float    y;
+        uint32_t captured;  ///< The region that was captured when the touch point was placed.
+        uint32_t hovered;   ///< The region under the touch point.
+        bool     active;
+    };
+
+    Finger*       findFinger( int64_t id ) noexcept;
+    Finger*       findFreeFinger() noexcept;
+    const Finger* findCapture( uint32_t region ) const noexcept;
+
+    void updateGrid( uint32_t region ) noexcept;
+
+    static size_t cell( float value ) noexcept;
+
+    std::vector<Region>      m_Regions;
+    std::vector<std::string> m_Names;
+
+    // A bit for each region that overlaps a grid cell.
+    uint64_t m_Grid[GRID_SIZE * GRID_SIZE][WORD_COUNT] {};
+
+    uint64_t m_Down[WORD_COUNT] {};
+    uint64_t m_Pressed[WORD_COUNT] {};
+    uint64_t m_Released[WORD_COUNT] {};
+    uint64_t m_Entered[WORD_COUNT] {};
+
+    Finger m_Fingers[Touch::MAX_TOUCH_COUNT] {};
+};
+
+}  // namespace input
@@ -0,0 +1,125 @@
+#pragma once
+
+#include "EventQueue.hpp"
+#include "Gamepad.hpp"
+#include "Keyboard.hpp"
+#include "Mouse.hpp"
+
+#include <cstdint>
+
+namespace input
+{
+
+/// <summary>
+/// The injection API of the headless Virtual backend (the input::Virtual CMake target).
+/// </summary>
+/// <remarks>
+/// The Virtual backend does not read any OS input. The Keyboard, Mouse, Gamepad, and Touch functions report
+/// the state of virtual devices that is set with these functions, so Input::update and the state trackers
+/// can run on servers without a display (for example, for benchmarks, bots, and deterministic tests).
+///
+/// pushEvent applies an event to the state of its virtual device and adds it to the event queue, the same
+/// as a backend that receives the event from the OS. The other functions that change a single key, button,
+/// axis, or touch point push the matching event with the current time of the virtual clock. The functions
+/// that set a whole state (setKeyboardState, setMouseState, and setGamepadState) do not push events.
+///
+/// The virtual clock (see getEventTime) only advances with setTime and advanceTime, so the timestamps of the
+/// events are the same in every run. The functions can be called from any thread, but the events must be
+/// pushed from a single thread (the event queue has a single producer).
+/// </remarks>
+namespace Virtual
+{
+
+/// <summary>
+/// Apply an event to the state of its virtual device and add it to the event queue.
+/// </summary>
+/// <remarks>
+/// Gamepad events of players that are not connected are ignored.
+/// </remarks>
+/// <returns>`false` if the event was ignored or the event queue is full (the state is still applied).</returns>
+bool pushEvent( const Event& event ) noexcept;
+
+void setKey( Keyboard::Key key, bool down ) noexcept;
+
+/// <summary>
+/// Set the state of all keys without pushing events.
+/// </summary>
+void setKeyboardState( const Keyboard::State& state ) noexcept;
+
+void setMouseButton( Mouse::Button button, bool down ) noexcept;
+
+/// <summary>
+/// Move the mouse cursor to a position in the window. In relative mode, the motion is accumulated.
+/// </summary>
+void moveMouse( float x, float y ) noexcept;
+
+/// <summary>
+/// Scroll the mouse wheel (120 for each notch).
+/// </summary>
+void scrollMouse( int32_t delta ) noexcept;
+
+/// <summary>
+/// Set the buttons, the position, and the scroll wheel value of the mouse without pushing events.
+/// </summary>
+void setMouseState( const Mouse::State& state ) noexcept;
+
+/// <summary>
+/// Attach a gamepad to a player slot. The buttons are released and the axes are centered.
+/// </summary>
+void connectGamepad( int player ) noexcept;
+
+/// <summary>
+/// Detach the gamepad of a player slot.
+/// </summary>
+void disconnectGamepad( int player ) noexcept;
+
+void setGamepadButton( int player, Gamepad::Button button, bool down ) noexcept;
+
+/// <summary>
+/// Set an axis of a gamepad.
+/// </summary>
+/// <param name="value">The raw value, [-1...1] for the thumbsticks and [0...1] for the triggers. The dead zone
+/// that is requested with Gamepad::getState is applied to the thumbsticks.</param>
+void setGamepadAxis( int player, GamepadAxis axis, float value ) noexcept;
+
+/// <summary>
+/// Set the state of a gamepad without pushing events. The gamepad is connected if state.connected is `true`,
+/// otherwise it is disconnected.
+/// </summary>
+void setGamepadState( int player, const Gamepad::State& state ) noexcept;
+
+/// <summary>
+/// Place a touch point (in normalized touch coordinates).
+/// </summary>
+void touchDown( int64_t id, float x, float y, float pressure = 1.0f ) noexcept;
+
+void touchMove( int64_t id, float x, float y, float pressure = 1.0f ) noexcept;
+
+void touchUp( int64_t id, float x, float y ) noexcept;
+
+/// <summary>
+/// Set the time of the virtual clock in nanoseconds.
+/// </summary>
+void setTime( uint64_t time ) noexcept;
+
+void advanceTime( uint64_t duration ) noexcept;
+
+/// <summary>
+/// Release all keys and buttons, disconnect all gamepads, remove all touch points, and set the virtual clock to 0.
+/// </summary>
+void reset() noexcept;
+
+namespace detail
+{
+void applyKeyboardEvent( const Event& event ) noexcept;  ///< Defined in KeyboardVirtual.cpp
+void applyMouseEvent( const Event& event ) noexcept;     ///< Defined in MouseVirtual.cpp
+bool applyGamepadEvent( const Event& event ) noexcept;   ///< Defined in GamepadVirtual.cpp
+void applyTouchEvent( const Event& event ) noexcept;     ///< Defined in TouchVirtual.cpp
+void resetMouse() noexcept;                              ///< Defined in MouseVirtual.cpp
+void resetGamepads() noexcept;                           ///< Defined in GamepadVirtual.cpp
+void resetTouches() noexcept;                            ///< Defined in TouchVirtual.cpp
+}  // namespace detail
+
+}  // namespace Virtual
+
+}  // namespace input
@@ -0,0 +1,126 @@
+#pragma once
+
+#include "Gamepad.hpp"
+
+#include <cstdint>
+#include <span>
+
+namespace input
+{
+
+class TouchRegionMap;
+
+/// <summary>
+/// Emulates a gamepad with on-screen thumbsticks and buttons.
+/// </summary>
+/// <remarks>
+/// The controls of the virtual gamepad are touch regions of a TouchRegionMap (see InputContext::addTouchRegion).
+/// Each update, the state of the regions is converted to a Gamepad::State that is merged into the gamepad
+/// state of a player slot before the gamepad state trackers are updated. Bindings and axes that read that
+/// gamepad (for example, the built-in "Horizontal", "Vertical", and "Jump" actions) work unchanged with touch input.
+///
+/// Thumbstick positions are measured in normalized touch coordinates. The Y axis is flipped, so moving a
+/// touch point up the screen gives a positive Y value (the same as a physical thumbstick).
+/// </remarks>
+class VirtualGamepad
+{
+public:
+    static constexpr uint32_t INVALID_REGION = UINT32_MAX;
+
+    enum class Stick : uint8_t
+    {
+        Left,
+        Right,
+    };
+
+    enum class StickMode : uint8_t
+    {
+        Fixed,     ///< The center of the thumbstick is the center of the region.
+        Floating,  ///< The center of the thumbstick is the point where the touch point was placed.
+    };
+
+    struct VirtualStick
+    {
+        uint32_t  region   = INVALID_REGION;  ///< The touch region of the thumbstick.
+        StickMode mode     = StickMode::Floating;
+        float     radius   = 0.1f;  ///< The distance from the center that gives a full deflection.
+        float     deadZone = 0.1f;  ///< The radial dead zone, relative to the radius.
+    };
+
+    VirtualGamepad() noexcept;
+
+    /// <summary>
+    /// Set the player slot that the virtual gamepad is merged into, or -1 to disable the virtual gamepad (the default).
+    /// </summary>
+    void setPlayerIndex( int playerIndex ) noexcept;
+
+    int getPlayerIndex() const noexcept
+    {
+        return m_PlayerIndex;
+    }
+
+    /// <summary>
+    /// Set the touch region and the behavior of a virtual thumbstick.
+    /// </summary>
+    void setStick( Stick stick, const VirtualStick& settings ) noexcept;
+
+    const VirtualStick& getStick( Stick stick ) const noexcept;
+
+    /// <summary>
+    /// Map a touch region to a gamepad button (or INVALID_REGION to remove the mapping).
+    /// </summary>
+    /// <remarks>
+    /// The threshold buttons are emulated by setting the axis: LeftTrigger and RightTrigger fully press the trigger,
+    /// and LeftStickUp, LeftStickDown, etc. fully deflect the thumbstick.
+    /// </remarks>
+    void setButton( Gamepad::Button button, uint32_t region ) noexcept;
+
+    uint32_t getButton( Gamepad::Button button ) const noexcept;
+
+    /// <summary>
+    /// Remove all thumbsticks and buttons (the player index is not changed).
+    /// </summary>
+    void clear() noexcept;
+
+    /// <summary>
+    /// Update the state of the virtual gamepad from the touch regions.
+    /// </summary>
+    /// <param name="regions">A touch region map that was updated this frame.</param>
+    void update( const TouchRegionMap& regions ) noexcept;
+
+    /// <summary>
+    /// Get the state of the virtual gamepad that was computed by the last update.
+    /// </summary>
+    const Gamepad::State& getState() const noexcept
+    {
+        return m_State;
+    }
+
+    /// <summary>
+    /// Merge the virtual gamepad into the gamepad state of its player slot (does nothing if the player index is -1).
+    /// </summary>
+    /// <remarks>
+    /// The buttons are combined with the buttons of the physical gamepad. A deflected virtual thumbstick replaces
+    /// the physical thumbstick, and the larger trigger value is used. The merged gamepad is always connected.
+    /// </remarks>
+    /// <param name="states">The gamepad states (indexed by player).</param>
+    void apply( std::span<Gamepad::State> states ) const noexcept;
+
+private:
+    struct StickState
+    {
+        VirtualStick settings;
+        float        centerX = 0.0f;
+        float        centerY = 0.0f;
+        bool         active  = false;  ///< The region is held (the center is valid).
+    };
+
+    void updateStick( StickState& stick, const TouchRegionMap& regions, float& x, float& y ) noexcept;
+
+    int            m_PlayerIndex = -1;
+    StickState     m_Sticks[2];
+    uint32_t       m_Buttons[static_cast<size_t>( Gamepad::Button::Count )];
+    Gamepad::State m_State {};
+};
+
+}  // namespace input
@@ -0,0 +1,63 @@
+#include <input/EventQueue.hpp>
+#include <input/LatencyProbe.hpp>
+
+#include <algorithm>
+
+using namespace input;
+
+EventQueue& EventQueue::get() noexcept
+{
+    static EventQueue queue;
+    return queue;
+}
+
+bool EventQueue::push( const Event& event ) noexcept
+{
+    // The positions are not wrapped, so they can be compared after they overflow.
+    const uint32_t write = m_Write.load( std::memory_order_relaxed );
+    const uint32_t read  = m_Read.load( std::memory_order_acquire );
+
+    if ( write - read == CAPACITY )
+    {
+        m_Dropped.fetch_add( 1, std::memory_order_relaxed );
+        return false;
+    }
+
+    m_Events[write & ( CAPACITY - 1 )] = event;
+
+#ifdef INPUT_ENABLE_LATENCY_PROBE
+    LatencyProbe::stamp( m_Events[write & ( CAPACITY - 1 )] );
+#endif
+    m_Write.store( write + 1, std::memory_order_release );
+
+    return true;
+}
+
+size_t EventQueue::pop( std::span<Event> events ) noexcept
+{
+    const uint32_t read  = m_Read.load( std::memory_order_relaxed );
+    const uint32_t write = m_Write.load( std::memory_order_acquire );
+    const uint32_t count = static_cast<uint32_t>( std::min<size_t>( write - read, events.size() ) );
+
+    // Copy in two parts if the events wrap around the end of the ring buffer.
+    const uint32_t start = read & ( CAPACITY - 1 );
+    const uint32_t first = std::min( count, CAPACITY - start );
+    std::copy_n( m_Events + start, first, events.data() );
+    std::copy_n( m_Events, count - first, events.data() + first );
+
+    m_Read.store( read + count, std::memory_order_release );
+
+    return count;
+}
+
+uint32_t EventQueue::takeDroppedCount() noexcept
+{
+    return m_Dropped.exchange( 0, std::memory_order_relaxed );
+}
+
+size_t EventQueue::size() const noexcept
+{
+    // Read the position of the consumer first so that the result is never negative.
+    const uint32_t read = m_Read.load( std::memory_order_acquire );
+    return m_Write.load( std::memory_order_acquire ) - read;
+}
@@ -1,6 +1,9 @@
+#include <input/EventQueue.hpp>
 #include <input/Gamepad.hpp>
+#include <input/Profiler.hpp>
 
 #include <algorithm>  // for std::min & std::max
+#include <array>      // for std::array
 #include <cassert>    // for assert.
 #include <cstring>    // for std::memset.
 #include <cmath>      // for std::sqrtf.
@@ -58,12 +61,96 @@ void ApplyStickDeadZone(
     }
     break;
 
+    case Gamepad::DeadZone::Radial:
+    {
+        const float dist  = std::sqrt( x * x + y * y );
+        const float scale = ( dist > deadZoneSize ) ? ( 1.f / std::max( dist, maxValue ) ) : 0.f;
+
+        resultX = std::max( -1.f, std::min( x * scale, 1.f ) );
+        resultY = std::max( -1.f, std::min( y * scale, 1.f ) );
+    }
+    break;
+
+    case Gamepad::DeadZone::Hybrid:
+    {
+        // Scaled radial removes the center dead zone, the sloped axial dead zone snaps to the axes.
+        float radialX, radialY;
+        ApplyStickDeadZone( x, y, Gamepad::DeadZone::Circular, maxValue, deadZoneSize, radialX, radialY );
+
+        resultX = ApplyLinearDeadZone( radialX, 1.f, deadZoneSize * std::abs( radialY ) );
+        resultY = ApplyLinearDeadZone( radialY, 1.f, deadZoneSize * std::abs( radialX ) );
+    }
+    break;
+
     default:  // Gamepad::DeadZone::None
         resultX = ApplyLinearDeadZone( x, maxValue, 0 );
         resultY = ApplyLinearDeadZone( y, maxValue, 0 );
         break;
     }
 }
+
+namespace
+{
+constexpr uint32_t buttonBit( bool value, Gamepad::Button button ) noexcept
+{
+    return static_cast<uint32_t>( value ) << static_cast<uint32_t>( button );
+}
+
+constexpr bool testButton( uint32_t buttons, Gamepad::Button button ) noexcept
+{
+    return ( buttons >> static_cast<uint32_t>( button ) & 1 ) != 0;
+}
+}  // namespace
+
+uint32_t PackGamepadButtons( const Gamepad::State& state ) noexcept
+{
+    using Button = Gamepad::Button;
+
+    return buttonBit( state.buttons.a, Button::A ) |
+           buttonBit( state.buttons.b, Button::B ) |
+           buttonBit( state.buttons.x, Button::X ) |
+           buttonBit( state.buttons.y, Button::Y ) |
+           buttonBit( state.buttons.leftStick, Button::LeftStick ) |
+           buttonBit( state.buttons.rightStick, Button::RightStick ) |
+           buttonBit( state.buttons.leftShoulder, Button::LeftShoulder ) |
+           buttonBit( state.buttons.rightShoulder, Button::RightShoulder ) |
+           buttonBit( state.buttons.back, Button::Back ) |
+           buttonBit( state.buttons.start, Button::Start ) |
+           buttonBit( state.dPad.up, Button::DPadUp ) |
+           buttonBit( state.dPad.down, Button::DPadDown ) |
+           buttonBit( state.dPad.left, Button::DPadLeft ) |
+           buttonBit( state.dPad.right, Button::DPadRight ) |
+           buttonBit( state.isLeftThumbStickUp(), Button::LeftStickUp ) |
+           buttonBit( state.isLeftThumbStickDown(), Button::LeftStickDown ) |
+           buttonBit( state.isLeftThumbStickLeft(), Button::LeftStickLeft ) |
+           buttonBit( state.isLeftThumbStickRight(), Button::LeftStickRight ) |
+           buttonBit( state.isRightThumbStickUp(), Button::RightStickUp ) |
+           buttonBit( state.isRightThumbStickDown(), Button::RightStickDown ) |
+           buttonBit( state.isRightThumbStickLeft(), Button::RightStickLeft ) |
+           buttonBit( state.isRightThumbStickRight(), Button::RightStickRight ) |
+           buttonBit( state.isLeftTriggerPressed(), Button::LeftTrigger ) |
+           buttonBit( state.isRightTriggerPressed(), Button::RightTrigger );
+}
+
+void UnpackGamepadButtons( uint32_t buttons, Gamepad::State& state ) noexcept
+{
+    using Button = Gamepad::Button;
+
+    state.buttons.a             = testButton( buttons, Button::A );
+    state.buttons.b             = testButton( buttons, Button::B );
+    state.buttons.x             = testButton( buttons, Button::X );
+    state.buttons.y             = testButton( buttons, Button::Y );
+    state.buttons.leftStick     = testButton( buttons, Button::LeftStick );
+    state.buttons.rightStick    = testButton( buttons, Button::RightStick );
+    state.buttons.leftShoulder  = testButton( buttons, Button::LeftShoulder );
+    state.buttons.rightShoulder = testButton( buttons, Button::RightShoulder );
+    state.buttons.back          = testButton( buttons, Button::Back );
+    state.buttons.start         = testButton( buttons, Button::Start );
+    state.dPad.up               = testButton( buttons, Button::DPadUp );
+    state.dPad.down             = testButton( buttons, Button::DPadDown );
+    state.dPad.left             = testButton( buttons, Button::DPadLeft );
+    state.dPad.right            = testButton( buttons, Button::DPadRight );
+}
 }  // namespace input
 
 using namespace input;
@@ -81,78 +168,85 @@ bool Gamepad::setVibration( float leftMotor, float rightMotor, float leftTrigger
     return setVibration( playerIndex, leftMotor, rightMotor, leftTrigger, rightTrigger );
 }
 
-#define UPDATE_BUTTON_STATE( field ) field = static_cast<ButtonState>( ( !!state.buttons.field ) | ( ( !!state.buttons.field ^ !!lastState.buttons.field ) << 1 ) )
+namespace
+{
+// Lookup table from Gamepad::Button to the GamepadStateTracker field.
+constexpr std::array<ButtonState GamepadStateTracker::*, static_cast<size_t>( Gamepad::Button::Count )> BUTTON_FIELDS = {
+    &GamepadStateTracker::a,
+    &GamepadStateTracker::b,
+    &GamepadStateTracker::x,
+    &GamepadStateTracker::y,
+    &GamepadStateTracker::leftStick,
+    &GamepadStateTracker::rightStick,
+    &GamepadStateTracker::leftShoulder,
+    &GamepadStateTracker::rightShoulder,
+    &GamepadStateTracker::back,
+    &GamepadStateTracker::start,
+    &GamepadStateTracker::dPadUp,
+    &GamepadStateTracker::dPadDown,
+    &GamepadStateTracker::dPadLeft,
+    &GamepadStateTracker::dPadRight,
+    &GamepadStateTracker::leftStickUp,
+    &GamepadStateTracker::leftStickDown,
+    &GamepadStateTracker::leftStickLeft,
+    &GamepadStateTracker::leftStickRight,
+    &GamepadStateTracker::rightStickUp,
+    &GamepadStateTracker::rightStickDown,
+    &GamepadStateTracker::rightStickLeft,
+    &GamepadStateTracker::rightStickRight,
+    &GamepadStateTracker::leftTrigger,
+    &GamepadStateTracker::rightTrigger,
+};
+
+constexpr ButtonState toButtonState( uint32_t down, uint32_t changed, uint32_t index ) noexcept
+{
+    return static_cast<ButtonState>( ( down >> index & 1 ) | ( changed >> index & 1 ) << 1 );
+}
+}  // namespace
 
 void GamepadStateTracker::update( const Gamepad::State& state )
 {
-    UPDATE_BUTTON_STATE( a );
-
-    assert( ( !state.buttons.a && !lastState.buttons.a ) == ( a == ButtonState::Up ) );
-    assert( ( state.buttons.a && lastState.buttons.a ) == ( a == ButtonState::Held ) );
-    assert( ( !state.buttons.a && lastState.buttons.a ) == ( a == ButtonState::Released ) );
-    assert( ( state.buttons.a && !lastState.buttons.a ) == ( a == ButtonState::Pressed ) );
-
-    UPDATE_BUTTON_STATE( b );
-    UPDATE_BUTTON_STATE( x );
-    UPDATE_BUTTON_STATE( y );
-
-    UPDATE_BUTTON_STATE( leftStick );
-    UPDATE_BUTTON_STATE( rightStick );
-
-    UPDATE_BUTTON_STATE( leftShoulder );
-    UPDATE_BUTTON_STATE( rightShoulder );
-
-    UPDATE_BUTTON_STATE( back );
-    UPDATE_BUTTON_STATE( start );
-
-    dPadUp    = static_cast<ButtonState>( ( !!state.dPad.up ) | ( ( !!state.dPad.up ^ !!lastState.dPad.up ) << 1 ) );
-    dPadDown  = static_cast<ButtonState>( ( !!state.dPad.down ) | ( ( !!state.dPad.down ^ !!lastState.dPad.down ) << 1 ) );
-    dPadLeft  = static_cast<ButtonState>( ( !!state.dPad.left ) | ( ( !!state.dPad.left ^ !!lastState.dPad.left ) << 1 ) );
-    dPadRight = static_cast<ButtonState>( ( !!state.dPad.right ) | ( ( !!state.dPad.right ^ !!lastState.dPad.right ) << 1 ) );
-
-    assert( ( !state.dPad.up && !lastState.dPad.up ) == ( dPadUp == ButtonState::Up ) );
-    assert( ( state.dPad.up && lastState.dPad.up ) == ( dPadUp == ButtonState::Held ) );
-    assert( ( !state.dPad.up && lastState.dPad.up ) == ( dPadUp == ButtonState::Released ) );
-    assert( ( state.dPad.up && !lastState.dPad.up ) == ( dPadUp == ButtonState::Pressed ) );
-
-    // Handle 'threshold' tests which emulate buttons
-
-    bool threshold = state.isLeftThumbStickUp();
-    leftStickUp    = static_cast<ButtonState>( ( !!threshold ) | ( ( !!threshold ^ !!lastState.isLeftThumbStickUp() ) << 1 ) );
+    INPUT_PROFILE_SCOPE( GamepadTrackerUpdate );
 
-    threshold     = state.isLeftThumbStickDown();
-    leftStickDown = static_cast<ButtonState>( ( !!threshold ) | ( ( !!threshold ^ !!lastState.isLeftThumbStickDown() ) << 1 ) );
+    const uint32_t current = PackGamepadButtons( state );
 
-    threshold     = state.isLeftThumbStickLeft();
-    leftStickLeft = static_cast<ButtonState>( ( !!threshold ) | ( ( !!threshold ^ !!lastState.isLeftThumbStickLeft() ) << 1 ) );
+    pressed  = current & ~down;
+    released = ~current & down;
+    down     = current;
 
-    threshold      = state.isLeftThumbStickRight();
-    leftStickRight = static_cast<ButtonState>( ( !!threshold ) | ( ( !!threshold ^ !!lastState.isLeftThumbStickRight() ) << 1 ) );
+    assert( ( pressed & released ) == 0 );
 
-    threshold    = state.isRightThumbStickUp();
-    rightStickUp = static_cast<ButtonState>( ( !!threshold ) | ( ( !!threshold ^ !!lastState.isRightThumbStickUp() ) << 1 ) );
+    // Expand the bitmasks into the ButtonState fields.
+    const uint32_t changed = pressed | released;
+    for ( uint32_t i = 0; i < BUTTON_FIELDS.size(); ++i )
+        this->*BUTTON_FIELDS[i] = toButtonState( down, changed, i );
 
-    threshold      = state.isRightThumbStickDown();
-    rightStickDown = static_cast<ButtonState>( ( !!threshold ) | ( ( !!threshold ^ !!lastState.isRightThumbStickDown() ) << 1 ) );
-
-    threshold      = state.isRightThumbStickLeft();
-    rightStickLeft = static_cast<ButtonState>( ( !!threshold ) | ( ( !!threshold ^ !!lastState.isRightThumbStickLeft() ) << 1 ) );
-
-    threshold       = state.isRightThumbStickRight();
-    rightStickRight = static_cast<ButtonState>( ( !!threshold ) | ( ( !!threshold ^ !!lastState.isRightThumbStickRight() ) << 1 ) );
+    lastState = state;
+    edgeTimes.endFrame();
+}
 
-    threshold   = state.isLeftTriggerPressed();
-    leftTrigger = static_cast<ButtonState>( ( !!threshold ) | ( ( !!threshold ^ !!lastState.isLeftTriggerPressed() ) << 1 ) );
+void GamepadStateTracker::addEvents( std::span<const Event> events, int player ) noexcept
+{
+    for ( const Event& event: events )
+    {
+        if ( event.type != EventType::GamepadButtonDown && event.type != EventType::GamepadButtonUp )
+            continue;
 
-    threshold    = state.isRightTriggerPressed();
-    rightTrigger = static_cast<ButtonState>( ( !!threshold ) | ( ( !!threshold ^ !!lastState.isRightTriggerPressed() ) << 1 ) );
+        const auto button = static_cast<size_t>( event.gamepadButton.button );
+        if ( event.gamepadButton.player != player || button >= static_cast<size_t>( Gamepad::Button::Count ) )
+            continue;
 
-    lastState = state;
+        edgeTimes.add( static_cast<uint32_t>( button ), event.type == EventType::GamepadButtonDown, event.timestamp );
+    }
 }
 
-#undef UPDATE_BUTTON_STATE
-
 void GamepadStateTracker::reset() noexcept
 {
     std::memset( this, 0, sizeof( GamepadStateTracker ) );
 }
+
+ButtonState GamepadStateTracker::getButtonState( Gamepad::Button button ) const noexcept
+{
+    const auto index = static_cast<uint32_t>( button );
+    return index < BUTTON_FIELDS.size() ? toButtonState( down, pressed | released, index ) : ButtonState::Up;
+}
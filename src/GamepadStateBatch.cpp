@@ -0,0 +1,358 @@
+#include <input/GamepadStateBatch.hpp>
+
+#include <algorithm>  // for std::min & std::fill.
+#include <cassert>    // for assert.
+
+#if defined( __AVX2__ )
+    #include <immintrin.h>
+    #define INPUT_BATCH_AVX2
+#elif defined( __SSE2__ ) || defined( _M_X64 ) || ( defined( _M_IX86_FP ) && _M_IX86_FP >= 2 )
+    #include <emmintrin.h>
+    #define INPUT_BATCH_SSE2
+#elif defined( __ARM_NEON ) || defined( _M_ARM64 )
+    #include <arm_neon.h>
+    #define INPUT_BATCH_NEON
+#endif
+
+using namespace input;
+
+namespace
+{
+
+constexpr float THRESHOLD = 0.5f;  // The same threshold as Gamepad::State::isLeftThumbStickUp etc.
+
+constexpr uint32_t bit( Gamepad::Button button ) noexcept
+{
+    return uint32_t { 1 } << static_cast<uint32_t>( button );
+}
+
+// The digital buttons and the d-pad come before the threshold buttons in Gamepad::Button.
+constexpr uint32_t DIGITAL_MASK = bit( Gamepad::Button::DPadRight ) * 2 - 1;
+
+static_assert( bit( Gamepad::Button::LeftStickUp ) == DIGITAL_MASK + 1 );
+
+#if defined( INPUT_BATCH_AVX2 )
+
+constexpr size_t LANES = 8;
+
+using Int   = __m256i;
+using Float = __m256;
+
+inline Float loadFloat( const float* p ) noexcept
+{
+    return _mm256_loadu_ps( p );
+}
+
+inline Int loadInt( const uint32_t* p ) noexcept
+{
+    return _mm256_loadu_si256( reinterpret_cast<const __m256i*>( p ) );
+}
+
+inline void storeInt( uint32_t* p, Int v ) noexcept
+{
+    _mm256_storeu_si256( reinterpret_cast<__m256i*>( p ), v );
+}
+
+// All bits of a lane are set if a > b.
+inline Int greater( Float a, Float b ) noexcept
+{
+    return _mm256_castps_si256( _mm256_cmp_ps( a, b, _CMP_GT_OQ ) );
+}
+
+inline Int splat( uint32_t value ) noexcept
+{
+    return _mm256_set1_epi32( static_cast<int>( value ) );
+}
+
+inline Float splat( float value ) noexcept
+{
+    return _mm256_set1_ps( value );
+}
+
+inline Int bitAnd( Int a, Int b ) noexcept
+{
+    return _mm256_and_si256( a, b );
+}
+
+inline Int bitOr( Int a, Int b ) noexcept
+{
+    return _mm256_or_si256( a, b );
+}
+
+// a & ~b
+inline Int bitAndNot( Int a, Int b ) noexcept
+{
+    return _mm256_andnot_si256( b, a );
+}
+
+#elif defined( INPUT_BATCH_SSE2 )
+
+constexpr size_t LANES = 4;
+
+using Int   = __m128i;
+using Float = __m128;
+
+inline Float loadFloat( const float* p ) noexcept
+{
+    return _mm_loadu_ps( p );
+}
+
+inline Int loadInt( const uint32_t* p ) noexcept
+{
+    return _mm_loadu_si128( reinterpret_cast<const __m128i*>( p ) );
+}
+
+inline void storeInt( uint32_t* p, Int v ) noexcept
+{
+    _mm_storeu_si128( reinterpret_cast<__m128i*>( p ), v );
+}
+
+inline Int greater( Float a, Float b ) noexcept
+{
+    return _mm_castps_si128( _mm_cmpgt_ps( a, b ) );
+}
+
+inline Int splat( uint32_t value ) noexcept
+{
+    return _mm_set1_epi32( static_cast<int>( value ) );
+}
+
+inline Float splat( float value ) noexcept
+{
+    return _mm_set1_ps( value );
+}
+
+inline Int bitAnd( Int a, Int b ) noexcept
+{
+    return _mm_and_si128( a, b );
+}
+
+inline Int bitOr( Int a, Int b ) noexcept
+{
+    return _mm_or_si128( a, b );
+}
+
+inline Int bitAndNot( Int a, Int b ) noexcept
+{
+    return _mm_andnot_si128( b, a );
+}
+
+#elif defined( INPUT_BATCH_NEON )
+
+constexpr size_t LANES = 4;
+
+using Int   = uint32x4_t;
+using Float = float32x4_t;
+
+inline Float loadFloat( const float* p ) noexcept
+{
+    return vld1q_f32( p );
+}
+
+inline Int loadInt( const uint32_t* p ) noexcept
+{
+    return vld1q_u32( p );
+}
+
+inline void storeInt( uint32_t* p, Int v ) noexcept
+{
+    vst1q_u32( p, v );
+}
+
+inline Int greater( Float a, Float b ) noexcept
+{
+    return vcgtq_f32( a, b );
+}
+
+inline Int splat( uint32_t value ) noexcept
+{
+    return vdupq_n_u32( value );
+}
+
+inline Float splat( float value ) noexcept
+{
+    return vdupq_n_f32( value );
+}
+
+inline Int bitAnd( Int a, Int b ) noexcept
+{
+    return vandq_u32( a, b );
+}
+
+inline Int bitOr( Int a, Int b ) noexcept
+{
+    return vorrq_u32( a, b );
+}
+
+inline Int bitAndNot( Int a, Int b ) noexcept
+{
+    return vbicq_u32( a, b );
+}
+
+#else
+
+constexpr size_t LANES = 0;  // Scalar only.
+
+#endif
+
+}  // namespace
+
+GamepadStateBatch::GamepadStateBatch( size_t playerCount )
+{
+    resize( playerCount );
+}
+
+void GamepadStateBatch::resize( size_t playerCount )
+{
+    m_Digital.resize( playerCount );
+    m_LeftX.resize( playerCount );
+    m_LeftY.resize( playerCount );
+    m_RightX.resize( playerCount );
+    m_RightY.resize( playerCount );
+    m_LeftTrigger.resize( playerCount );
+    m_RightTrigger.resize( playerCount );
+    m_Connected.resize( playerCount );
+    m_Packet.resize( playerCount );
+    m_Buttons.resize( playerCount );
+    m_Pressed.resize( playerCount );
+    m_Released.resize( playerCount );
+}
+
+void GamepadStateBatch::reset() noexcept
+{
+    std::fill( m_Digital.begin(), m_Digital.end(), 0u );
+    std::fill( m_LeftX.begin(), m_LeftX.end(), 0.0f );
+    std::fill( m_LeftY.begin(), m_LeftY.end(), 0.0f );
+    std::fill( m_RightX.begin(), m_RightX.end(), 0.0f );
+    std::fill( m_RightY.begin(), m_RightY.end(), 0.0f );
+    std::fill( m_LeftTrigger.begin(), m_LeftTrigger.end(), 0.0f );
+    std::fill( m_RightTrigger.begin(), m_RightTrigger.end(), 0.0f );
+    std::fill( m_Connected.begin(), m_Connected.end(), uint8_t { 0 } );
+    std::fill( m_Packet.begin(), m_Packet.end(), uint64_t { 0 } );
+    std::fill( m_Buttons.begin(), m_Buttons.end(), 0u );
+    std::fill( m_Pressed.begin(), m_Pressed.end(), 0u );
+    std::fill( m_Released.begin(), m_Released.end(), 0u );
+}
+
+void GamepadStateBatch::setState( size_t playerIndex, const Gamepad::State& state ) noexcept
+{
+    assert( playerIndex < size() );
+
+    m_Digital[playerIndex]      = PackGamepadButtons( state ) & DIGITAL_MASK;
+    m_LeftX[playerIndex]        = state.thumbSticks.leftX;
+    m_LeftY[playerIndex]        = state.thumbSticks.leftY;
+    m_RightX[playerIndex]       = state.thumbSticks.rightX;
+    m_RightY[playerIndex]       = state.thumbSticks.rightY;
+    m_LeftTrigger[playerIndex]  = state.triggers.left;
+    m_RightTrigger[playerIndex] = state.triggers.right;
+    m_Connected[playerIndex]    = state.connected;
+    m_Packet[playerIndex]       = state.packet;
+}
+
+void GamepadStateBatch::setStates( std::span<const Gamepad::State> states ) noexcept
+{
+    const size_t count = std::min( states.size(), size() );
+
+    for ( size_t i = 0; i < count; ++i )
+        setState( i, states[i] );
+}
+
+Gamepad::State GamepadStateBatch::getState( size_t playerIndex ) const noexcept
+{
+    assert( playerIndex < size() );
+
+    Gamepad::State state {};
+    UnpackGamepadButtons( m_Digital[playerIndex], state );
+
+    state.connected          = m_Connected[playerIndex] != 0;
+    state.packet             = m_Packet[playerIndex];
+    state.thumbSticks.leftX  = m_LeftX[playerIndex];
+    state.thumbSticks.leftY  = m_LeftY[playerIndex];
+    state.thumbSticks.rightX = m_RightX[playerIndex];
+    state.thumbSticks.rightY = m_RightY[playerIndex];
+    state.triggers.left      = m_LeftTrigger[playerIndex];
+    state.triggers.right     = m_RightTrigger[playerIndex];
+
+    return state;
+}
+
+void GamepadStateBatch::update() noexcept
+{
+    using Button = Gamepad::Button;
+
+    const size_t count = size();
+    size_t       i     = 0;
+
+#if defined( INPUT_BATCH_AVX2 ) || defined( INPUT_BATCH_SSE2 ) || defined( INPUT_BATCH_NEON )
+    const Float positive = splat( THRESHOLD );
+    const Float negative = splat( -THRESHOLD );
+
+    // Set the bit of a threshold button in the lanes where a > b.
+    const auto threshold = []( Float a, Float b, Button button ) noexcept {
+        return bitAnd( greater( a, b ), splat( bit( button ) ) );
+    };
+
+    for ( ; i + LANES <= count; i += LANES )
+    {
+        const Float leftX  = loadFloat( &m_LeftX[i] );
+        const Float leftY  = loadFloat( &m_LeftY[i] );
+        const Float rightX = loadFloat( &m_RightX[i] );
+        const Float rightY = loadFloat( &m_RightY[i] );
+
+        Int buttons = loadInt( &m_Digital[i] );
+        buttons     = bitOr( buttons, threshold( leftY, positive, Button::LeftStickUp ) );
+        buttons     = bitOr( buttons, threshold( negative, leftY, Button::LeftStickDown ) );
+        buttons     = bitOr( buttons, threshold( negative, leftX, Button::LeftStickLeft ) );
+        buttons     = bitOr( buttons, threshold( leftX, positive, Button::LeftStickRight ) );
+        buttons     = bitOr( buttons, threshold( rightY, positive, Button::RightStickUp ) );
+        buttons     = bitOr( buttons, threshold( negative, rightY, Button::RightStickDown ) );
+        buttons     = bitOr( buttons, threshold( negative, rightX, Button::RightStickLeft ) );
+        buttons     = bitOr( buttons, threshold( rightX, positive, Button::RightStickRight ) );
+        buttons     = bitOr( buttons, threshold( loadFloat( &m_LeftTrigger[i] ), positive, Button::LeftTrigger ) );
+        buttons     = bitOr( buttons, threshold( loadFloat( &m_RightTrigger[i] ), positive, Button::RightTrigger ) );
+
+        const Int previous = loadInt( &m_Buttons[i] );
+
+        storeInt( &m_Buttons[i], buttons );
+        storeInt( &m_Pressed[i], bitAndNot( buttons, previous ) );
+        storeInt( &m_Released[i], bitAndNot( previous, buttons ) );
+    }
+#endif
+
+    // Remaining players.
+    for ( ; i < count; ++i )
+    {
+        const auto threshold = []( bool value, Button button ) noexcept {
+            return value ? bit( button ) : 0u;
+        };
+
+        const uint32_t buttons = m_Digital[i] |
+                                 threshold( m_LeftY[i] > THRESHOLD, Button::LeftStickUp ) |
+                                 threshold( m_LeftY[i] < -THRESHOLD, Button::LeftStickDown ) |
+                                 threshold( m_LeftX[i] < -THRESHOLD, Button::LeftStickLeft ) |
+                                 threshold( m_LeftX[i] > THRESHOLD, Button::LeftStickRight ) |
+                                 threshold( m_RightY[i] > THRESHOLD, Button::RightStickUp ) |
+                                 threshold( m_RightY[i] < -THRESHOLD, Button::RightStickDown ) |
+                                 threshold( m_RightX[i] < -THRESHOLD, Button::RightStickLeft ) |
+                                 threshold( m_RightX[i] > THRESHOLD, Button::RightStickRight ) |
+                                 threshold( m_LeftTrigger[i] > THRESHOLD, Button::LeftTrigger ) |
+                                 threshold( m_RightTrigger[i] > THRESHOLD, Button::RightTrigger );
+
+        const uint32_t previous = m_Buttons[i];
+
+        m_Buttons[i]  = buttons;
+        m_Pressed[i]  = buttons & ~previous;
+        m_Released[i] = previous & ~buttons;
+    }
+}
+
+ButtonState GamepadStateBatch::getButtonState( size_t playerIndex, Gamepad::Button button ) const noexcept
+{
+    assert( playerIndex < size() );
+
+    const uint32_t shift   = static_cast<uint32_t>( button );
+    const uint32_t down    = m_Buttons[playerIndex] >> shift & 1;
+    const uint32_t changed = ( m_Pressed[playerIndex] | m_Released[playerIndex] ) >> shift & 1;
+
+    return static_cast<ButtonState>( down | changed << 1 );
+}
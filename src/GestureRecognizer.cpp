@@ -0,0 +1,360 @@
+#include <input/GestureRecognizer.hpp>
+
+#include <algorithm>
+#include <cmath>
+
+using namespace input;
+
+namespace
+{
+
+constexpr float PI = 3.14159265358979323846f;
+
+float seconds( uint64_t start, uint64_t end ) noexcept
+{
+    return end > start ? static_cast<float>( static_cast<double>( end - start ) * 1e-9 ) : 0.0f;
+}
+
+float distance( float x0, float y0, float x1, float y1 ) noexcept
+{
+    return std::hypot( x1 - x0, y1 - y0 );
+}
+
+// Wrap an angle to the range [-PI...PI].
+float wrapAngle( float angle ) noexcept
+{
+    if ( angle > PI )
+        angle -= 2.0f * PI;
+    else if ( angle < -PI )
+        angle += 2.0f * PI;
+
+    return angle;
+}
+
+GestureEvent makeEvent( GestureType type, GesturePhase phase, int64_t id, float x, float y ) noexcept
+{
+    GestureEvent event {};
+    event.type  = type;
+    event.phase = phase;
+    event.id    = id;
+    event.x     = x;
+    event.y     = y;
+    event.scale = 1.0f;
+
+    return event;
+}
+
+}  // namespace
+
+void GestureRecognizer::setSettings( const GestureSettings& settings ) noexcept
+{
+    m_Settings = settings;
+}
+
+const GestureSettings& GestureRecognizer::getSettings() const noexcept
+{
+    return m_Settings;
+}
+
+void GestureRecognizer::update( const TouchStateTracker& touches, uint64_t timestamp ) noexcept
+{
+    m_Events.clear();
+
+    // The fingers that are reported by the tracker this frame.
+    uint32_t seen = 0;
+
+    for ( const auto& touch: touches.getTrackedTouches() )
+    {
+        Finger* finger = findFinger( touch.id );
+
+        switch ( touch.state )
+        {
+        case ButtonState::Pressed:
+        case ButtonState::Held:
+            // Some backends report a touch as pressed until it moves.
+            if ( finger )
+                moved( *finger, touch, timestamp );
+            else
+                pressed( touch, timestamp );
+
+            finger = findFinger( touch.id );
+            break;
+        case ButtonState::Released:
+            if ( finger )
+            {
+                moved( *finger, touch, timestamp );
+                released( *finger, timestamp );
+            }
+            break;
+        case ButtonState::Up:
+            break;
+        }
+
+        if ( finger )
+            seen |= 1u << ( finger - m_Fingers );
+    }
+
+    // Forget fingers that are no longer tracked (for example, if the tracker was reset).
+    for ( uint32_t i = 0; i < Touch::MAX_TOUCH_COUNT; ++i )
+    {
+        if ( m_Fingers[i].active && !( seen & ( 1u << i ) ) )
+        {
+            m_Fingers[i].active = false;
+            --m_ActiveCount;
+        }
+    }
+
+    updatePair();
+}
+
+void GestureRecognizer::reset() noexcept
+{
+    for ( auto& finger: m_Fingers )
+        finger.active = false;
+
+    m_ActiveCount  = 0;
+    m_Pair         = {};
+    m_LastTapValid = false;
+    m_Events.clear();
+}
+
+bool GestureRecognizer::getVelocity( int64_t id, float& velocityX, float& velocityY ) const noexcept
+{
+    const Finger* finger = findFinger( id );
+    if ( !finger )
+        return false;
+
+    estimateVelocity( *finger, velocityX, velocityY );
+    return true;
+}
+
+void GestureRecognizer::estimateVelocity( const Finger& finger, float& velocityX, float& velocityY ) noexcept
+{
+    float x = 0.0f;
+    float y = 0.0f;
+    float t = 0.0f;
+
+    for ( uint32_t i = 0; i < finger.sampleCount; ++i )
+    {
+        x += finger.sampleX[i];
+        y += finger.sampleY[i];
+        t += finger.sampleTime[i];
+    }
+
+    velocityX = t > 0.0f ? x / t : 0.0f;
+    velocityY = t > 0.0f ? y / t : 0.0f;
+}
+
+GestureRecognizer::Finger* GestureRecognizer::findFinger( int64_t id ) noexcept
+{
+    for ( auto& finger: m_Fingers )
+    {
+        if ( finger.active && finger.id == id )
+            return &finger;
+    }
+
+    return nullptr;
+}
+
+const GestureRecognizer::Finger* GestureRecognizer::findFinger( int64_t id ) const noexcept
+{
+    return const_cast<GestureRecognizer*>( this )->findFinger( id );
+}
+
+void GestureRecognizer::pressed( const TouchStateTracker::TrackedTouch& touch, uint64_t timestamp ) noexcept
+{
+    for ( auto& finger: m_Fingers )
+    {
+        if ( finger.active )
+            continue;
+
+        finger           = {};
+        finger.id        = touch.id;
+        finger.startTime = timestamp;
+        finger.lastTime  = timestamp;
+        finger.startX    = touch.x;
+        finger.startY    = touch.y;
+        finger.x         = touch.x;
+        finger.y         = touch.y;
+        finger.active    = true;
+
+        ++m_ActiveCount;
+        return;
+    }
+}
+
+void GestureRecognizer::moved( Finger& finger, const TouchStateTracker::TrackedTouch& touch, uint64_t timestamp ) noexcept
+{
+    const float dx = touch.x - finger.x;
+    const float dy = touch.y - finger.y;
+    const float dt = seconds( finger.lastTime, timestamp );
+
+    // A release that is reported without movement does not slow the finger down.
+    if ( dt > 0.0f && ( touch.state != ButtonState::Released || dx != 0.0f || dy != 0.0f ) )
+    {
+        finger.sampleX[finger.nextSample]    = dx;
+        finger.sampleY[finger.nextSample]    = dy;
+        finger.sampleTime[finger.nextSample] = dt;
+        finger.nextSample                    = ( finger.nextSample + 1 ) % VELOCITY_SAMPLE_COUNT;
+        finger.sampleCount                   = std::min<uint32_t>( finger.sampleCount + 1, VELOCITY_SAMPLE_COUNT );
+        finger.lastTime                      = timestamp;
+    }
+
+    finger.x = touch.x;
+    finger.y = touch.y;
+
+    if ( !finger.moved && distance( finger.startX, finger.startY, finger.x, finger.y ) > m_Settings.tapMaxDistance )
+        finger.moved = true;
+
+    if ( touch.state != ButtonState::Released && !finger.moved && !finger.longPress && !finger.multiTouch
+         && seconds( finger.startTime, timestamp ) >= m_Settings.longPressDuration )
+    {
+        finger.longPress = true;
+        m_Events.push_back( makeEvent( GestureType::LongPress, GesturePhase::Ended, finger.id, finger.x, finger.y ) );
+    }
+}
+
+void GestureRecognizer::released( Finger& finger, uint64_t timestamp ) noexcept
+{
+    finger.active = false;
+    --m_ActiveCount;
+
+    if ( finger.multiTouch )
+        return;
+
+    if ( !finger.moved && !finger.longPress && seconds( finger.startTime, timestamp ) <= m_Settings.tapMaxDuration )
+    {
+        m_Events.push_back( makeEvent( GestureType::Tap, GesturePhase::Ended, finger.id, finger.x, finger.y ) );
+
+        if ( m_LastTapValid && seconds( m_LastTapTime, timestamp ) <= m_Settings.doubleTapMaxInterval
+             && distance( m_LastTapX, m_LastTapY, finger.x, finger.y ) <= m_Settings.doubleTapMaxDistance )
+        {
+            m_Events.push_back( makeEvent( GestureType::DoubleTap, GesturePhase::Ended, finger.id, finger.x, finger.y ) );
+
+            // A third tap starts a new double tap.
+            m_LastTapValid = false;
+        }
+        else
+        {
+            m_LastTapTime  = timestamp;
+            m_LastTapX     = finger.x;
+            m_LastTapY     = finger.y;
+            m_LastTapValid = true;
+        }
+
+        return;
+    }
+
+    const float deltaX = finger.x - finger.startX;
+    const float deltaY = finger.y - finger.startY;
+
+    float velocityX, velocityY;
+    estimateVelocity( finger, velocityX, velocityY );
+
+    if ( std::hypot( deltaX, deltaY ) >= m_Settings.swipeMinDistance && std::hypot( velocityX, velocityY ) >= m_Settings.swipeMinVelocity )
+    {
+        GestureEvent swipe = makeEvent( GestureType::Swipe, GesturePhase::Ended, finger.id, finger.x, finger.y );
+        swipe.deltaX       = deltaX;
+        swipe.deltaY       = deltaY;
+        swipe.velocityX    = velocityX;
+        swipe.velocityY    = velocityY;
+
+        m_Events.push_back( swipe );
+    }
+}
+
+void GestureRecognizer::updatePair() noexcept
+{
+    if ( m_ActiveCount != 2 )
+    {
+        endPair();
+
+        // Fingers that are down together do not tap, swipe, or long press.
+        if ( m_ActiveCount > 2 )
+        {
+            for ( auto& finger: m_Fingers )
+                finger.multiTouch |= finger.active;
+        }
+
+        return;
+    }
+
+    Finger* fingers[2];
+    size_t  count = 0;
+
+    for ( auto& finger: m_Fingers )
+    {
+        if ( finger.active )
+        {
+            finger.multiTouch = true;
+            fingers[count++]  = &finger;
+        }
+    }
+
+    const Finger& a = *fingers[0];
+    const Finger& b = *fingers[1];
+
+    const float dist  = distance( a.x, a.y, b.x, b.y );
+    const float angle = std::atan2( b.y - a.y, b.x - a.x );
+
+    if ( m_Pair.first != a.id || m_Pair.second != b.id )
+    {
+        endPair();
+
+        m_Pair.first         = a.id;
+        m_Pair.second        = b.id;
+        m_Pair.startDistance = dist;
+        m_Pair.lastAngle     = angle;
+        m_Pair.scale         = 1.0f;
+        m_Pair.rotation      = 0.0f;
+    }
+    else
+    {
+        // Accumulate the change in angle so that the rotation is not limited to half a turn.
+        m_Pair.scale     = m_Pair.startDistance > 0.0f ? dist / m_Pair.startDistance : 1.0f;
+        m_Pair.rotation += wrapAngle( angle - m_Pair.lastAngle );
+        m_Pair.lastAngle = angle;
+    }
+
+    m_Pair.x = ( a.x + b.x ) * 0.5f;
+    m_Pair.y = ( a.y + b.y ) * 0.5f;
+
+    if ( m_Pair.pinching || std::abs( dist - m_Pair.startDistance ) >= m_Settings.pinchMinDistance )
+    {
+        GestureEvent pinch = makeEvent( GestureType::Pinch, m_Pair.pinching ? GesturePhase::Changed : GesturePhase::Began, m_Pair.first, m_Pair.x, m_Pair.y );
+        pinch.scale        = m_Pair.scale;
+
+        m_Events.push_back( pinch );
+        m_Pair.pinching = true;
+    }
+
+    if ( m_Pair.rotating || std::abs( m_Pair.rotation ) >= m_Settings.rotateMinAngle )
+    {
+        GestureEvent rotate = makeEvent( GestureType::Rotate, m_Pair.rotating ? GesturePhase::Changed : GesturePhase::Began, m_Pair.first, m_Pair.x, m_Pair.y );
+        rotate.rotation     = m_Pair.rotation;
+
+        m_Events.push_back( rotate );
+        m_Pair.rotating = true;
+    }
+}
+
+void GestureRecognizer::endPair() noexcept
+{
+    if ( m_Pair.pinching )
+    {
+        GestureEvent pinch = makeEvent( GestureType::Pinch, GesturePhase::Ended, m_Pair.first, m_Pair.x, m_Pair.y );
+        pinch.scale        = m_Pair.scale;
+
+        m_Events.push_back( pinch );
+    }
+
+    if ( m_Pair.rotating )
+    {
+        GestureEvent rotate = makeEvent( GestureType::Rotate, GesturePhase::Ended, m_Pair.first, m_Pair.x, m_Pair.y );
+        rotate.rotation     = m_Pair.rotation;
+
+        m_Events.push_back( rotate );
+    }
+
+    m_Pair = {};
+}
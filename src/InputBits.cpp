@@ -0,0 +1,273 @@
+#include <input/InputBits.hpp>
+
+#include <bit>      // for std::countr_zero.
+#include <cassert>  // for assert.
+
+#if defined( __AVX2__ )
+    #include <immintrin.h>
+    #define INPUT_BITS_AVX2
+#elif defined( __SSE2__ ) || defined( _M_X64 ) || ( defined( _M_IX86_FP ) && _M_IX86_FP >= 2 )
+    #include <emmintrin.h>
+    #define INPUT_BITS_SSE2
+#elif defined( __ARM_NEON ) || defined( _M_ARM64 )
+    #include <arm_neon.h>
+    #define INPUT_BITS_NEON
+#endif
+
+using namespace input;
+
+namespace
+{
+
+// Bit i of the result words.
+inline void setResult( std::span<uint64_t> result, size_t i, bool value ) noexcept
+{
+    result[i / 64] |= uint64_t { value } << ( i % 64 );
+}
+
+#if defined( INPUT_BITS_AVX2 )
+
+constexpr size_t LANES = sizeof( InputBits ) / sizeof( __m256i );
+
+struct Edges
+{
+    __m256i down[LANES];
+    __m256i pressed[LANES];
+    __m256i released[LANES];
+
+    explicit Edges( const InputEdges& edges ) noexcept
+    {
+        for ( size_t i = 0; i < LANES; ++i )
+        {
+            down[i]     = _mm256_load_si256( reinterpret_cast<const __m256i*>( edges.down.words ) + i );
+            pressed[i]  = _mm256_load_si256( reinterpret_cast<const __m256i*>( edges.pressed.words ) + i );
+            released[i] = _mm256_load_si256( reinterpret_cast<const __m256i*>( edges.released.words ) + i );
+        }
+    }
+
+    void test( const InputBits& mask, bool& isDown, bool& isPressed, bool& isReleased ) const noexcept
+    {
+        __m256i d = _mm256_setzero_si256();
+        __m256i p = _mm256_setzero_si256();
+        __m256i r = _mm256_setzero_si256();
+
+        for ( size_t i = 0; i < LANES; ++i )
+        {
+            const __m256i m = _mm256_load_si256( reinterpret_cast<const __m256i*>( mask.words ) + i );
+
+            d = _mm256_or_si256( d, _mm256_and_si256( m, down[i] ) );
+            p = _mm256_or_si256( p, _mm256_and_si256( m, pressed[i] ) );
+            r = _mm256_or_si256( r, _mm256_and_si256( m, released[i] ) );
+        }
+
+        isDown     = !_mm256_testz_si256( d, d );
+        isPressed  = !_mm256_testz_si256( p, p );
+        isReleased = !_mm256_testz_si256( r, r );
+    }
+};
+
+#elif defined( INPUT_BITS_SSE2 )
+
+constexpr size_t LANES = sizeof( InputBits ) / sizeof( __m128i );
+
+inline bool isNotZero( __m128i v ) noexcept
+{
+    return _mm_movemask_epi8( _mm_cmpeq_epi8( v, _mm_setzero_si128() ) ) != 0xffff;
+}
+
+struct Edges
+{
+    __m128i down[LANES];
+    __m128i pressed[LANES];
+    __m128i released[LANES];
+
+    explicit Edges( const InputEdges& edges ) noexcept
+    {
+        for ( size_t i = 0; i < LANES; ++i )
+        {
+            down[i]     = _mm_load_si128( reinterpret_cast<const __m128i*>( edges.down.words ) + i );
+            pressed[i]  = _mm_load_si128( reinterpret_cast<const __m128i*>( edges.pressed.words ) + i );
+            released[i] = _mm_load_si128( reinterpret_cast<const __m128i*>( edges.released.words ) + i );
+        }
+    }
+
+    void test( const InputBits& mask, bool& isDown, bool& isPressed, bool& isReleased ) const noexcept
+    {
+        __m128i d = _mm_setzero_si128();
+        __m128i p = _mm_setzero_si128();
+        __m128i r = _mm_setzero_si128();
+
+        for ( size_t i = 0; i < LANES; ++i )
+        {
+            const __m128i m = _mm_load_si128( reinterpret_cast<const __m128i*>( mask.words ) + i );
+
+            d = _mm_or_si128( d, _mm_and_si128( m, down[i] ) );
+            p = _mm_or_si128( p, _mm_and_si128( m, pressed[i] ) );
+            r = _mm_or_si128( r, _mm_and_si128( m, released[i] ) );
+        }
+
+        isDown     = isNotZero( d );
+        isPressed  = isNotZero( p );
+        isReleased = isNotZero( r );
+    }
+};
+
+#elif defined( INPUT_BITS_NEON )
+
+constexpr size_t LANES = sizeof( InputBits ) / sizeof( uint64x2_t );
+
+inline bool isNotZero( uint64x2_t v ) noexcept
+{
+    return ( vgetq_lane_u64( v, 0 ) | vgetq_lane_u64( v, 1 ) ) != 0;
+}
+
+struct Edges
+{
+    uint64x2_t down[LANES];
+    uint64x2_t pressed[LANES];
+    uint64x2_t released[LANES];
+
+    explicit Edges( const InputEdges& edges ) noexcept
+    {
+        for ( size_t i = 0; i < LANES; ++i )
+        {
+            down[i]     = vld1q_u64( edges.down.words + i * 2 );
+            pressed[i]  = vld1q_u64( edges.pressed.words + i * 2 );
+            released[i] = vld1q_u64( edges.released.words + i * 2 );
+        }
+    }
+
+    void test( const InputBits& mask, bool& isDown, bool& isPressed, bool& isReleased ) const noexcept
+    {
+        uint64x2_t d = vdupq_n_u64( 0 );
+        uint64x2_t p = vdupq_n_u64( 0 );
+        uint64x2_t r = vdupq_n_u64( 0 );
+
+        for ( size_t i = 0; i < LANES; ++i )
+        {
+            const uint64x2_t m = vld1q_u64( mask.words + i * 2 );
+
+            d = vorrq_u64( d, vandq_u64( m, down[i] ) );
+            p = vorrq_u64( p, vandq_u64( m, pressed[i] ) );
+            r = vorrq_u64( r, vandq_u64( m, released[i] ) );
+        }
+
+        isDown     = isNotZero( d );
+        isPressed  = isNotZero( p );
+        isReleased = isNotZero( r );
+    }
+};
+
+#else
+
+struct Edges
+{
+    const InputEdges& edges;
+
+    explicit Edges( const InputEdges& edges ) noexcept
+    : edges( edges )
+    {}
+
+    void test( const InputBits& mask, bool& isDown, bool& isPressed, bool& isReleased ) const noexcept
+    {
+        isDown     = edges.down.any( mask );
+        isPressed  = edges.pressed.any( mask );
+        isReleased = edges.released.any( mask );
+    }
+};
+
+#endif
+
+}  // namespace
+
+void input::evaluateMasks( std::span<const InputBits> masks, const InputEdges& edges, std::span<uint64_t> down, std::span<uint64_t> pressed, std::span<uint64_t> released ) noexcept
+{
+    const size_t wordCount = ( masks.size() + 63 ) / 64;
+
+    assert( down.size() >= wordCount && pressed.size() >= wordCount && released.size() >= wordCount );
+
+    for ( size_t i = 0; i < wordCount; ++i )
+    {
+        down[i]     = 0;
+        pressed[i]  = 0;
+        released[i] = 0;
+    }
+
+    const Edges e { edges };
+
+    for ( size_t i = 0; i < masks.size(); ++i )
+    {
+        bool isDown, isPressed, isReleased;
+        e.test( masks[i], isDown, isPressed, isReleased );
+
+        setResult( down, i, isDown );
+        setResult( pressed, i, isPressed );
+        setResult( released, i, isReleased );
+    }
+}
+
+void InputCounts::add( std::span<const Event> events ) noexcept
+{
+    for ( const Event& event: events )
+    {
+        size_t bit;
+        bool   down;
+
+        switch ( event.type )
+        {
+        case EventType::KeyDown:
+        case EventType::KeyUp:
+            bit  = InputBits::keyBit( event.key.key );
+            down = event.type == EventType::KeyDown;
+            break;
+        case EventType::MouseButtonDown:
+        case EventType::MouseButtonUp:
+            bit  = InputBits::mouseBit( event.mouseButton.button );
+            down = event.type == EventType::MouseButtonDown;
+            break;
+        case EventType::GamepadButtonDown:
+        case EventType::GamepadButtonUp:
+            if ( event.gamepadButton.player < 0 || event.gamepadButton.player >= Gamepad::MAX_PLAYER_COUNT )
+                continue;
+
+            bit  = InputBits::gamepadBit( event.gamepadButton.button, event.gamepadButton.player );
+            down = event.type == EventType::GamepadButtonDown;
+            break;
+        default:
+            continue;
+        }
+
+        assert( bit < COUNT );
+
+        if ( down )
+        {
+            if ( presses[bit] < UINT8_MAX )
+                ++presses[bit];
+
+            pressed.set( bit );
+        }
+        else
+        {
+            if ( releases[bit] < UINT8_MAX )
+                ++releases[bit];
+
+            released.set( bit );
+        }
+    }
+}
+
+void InputCounts::clear() noexcept
+{
+    // Most inputs are not pressed in a frame, so only clear the counts that are set.
+    for ( size_t w = 0; w < COUNT / 64; ++w )
+    {
+        for ( uint64_t bits = pressed.words[w]; bits; bits &= bits - 1 )
+            presses[w * 64 + std::countr_zero( bits )] = 0;
+
+        for ( uint64_t bits = released.words[w]; bits; bits &= bits - 1 )
+            releases[w * 64 + std::countr_zero( bits )] = 0;
+    }
+
+    pressed  = {};
+    released = {};
+}
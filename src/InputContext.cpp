@@ -0,0 +1,1394 @@
+#include <input/InputContext.hpp>
+#include <input/InputFrame.hpp>
+#include <input/KeyNames.hpp>
+#include <input/LatencyProbe.hpp>
+#include <input/Profiler.hpp>
+#include <input/TouchRegionMap.hpp>
+#include <input/VirtualGamepad.hpp>
+
+#include <algorithm>
+#include <array>
+#include <bit>
+#include <cstring>
+#include <limits>
+#include <memory>
+#include <string>
+#include <utility>
+#include <vector>
+
+using namespace input;
+
+namespace
+{
+
+using Keyboard::Key;
+using Mouse::Button;
+
+/// <summary>
+/// The source of a term in a built-in binding.
+/// </summary>
+enum class Source : uint8_t
+{
+    None,           ///< Marks the end of the terms in a binding.
+    Key,            ///< A keyboard key (code is a Keyboard::Key).
+    MouseButton,    ///< A mouse button (code is a Mouse::Button).
+    MouseAxis,      ///< A mouse axis (code is a MouseAxis).
+    GamepadButton,  ///< A gamepad button (code is a Gamepad::Button).
+    GamepadAxis,    ///< A gamepad thumbstick or trigger (code is a GamepadAxis).
+};
+
+enum class MouseAxis : uint8_t
+{
+    X,
+    Y,
+    ScrollWheel,
+};
+
+enum class GamepadAxis : uint8_t
+{
+    LeftX,
+    LeftY,
+    RightX,
+    RightY,
+    LeftTrigger,
+    RightTrigger,
+};
+
+/// <summary>
+/// The edge of a button that is queried.
+/// </summary>
+enum class Edge : uint8_t
+{
+    Down,      ///< The button is held down (getButton).
+    Pressed,   ///< The button was pressed this frame (getButtonDown).
+    Released,  ///< The button was released this frame (getButtonUp).
+};
+
+constexpr int8_t ANY_PLAYER = -1;
+
+/// <summary>
+/// A single input that contributes to a binding.
+/// </summary>
+struct Term
+{
+    Source  source = Source::None;
+    int8_t  player = ANY_PLAYER;  ///< The gamepad player index, or ANY_PLAYER for all gamepads.
+    uint8_t code   = 0;
+    float   scale  = 1.0f;  ///< Only used for axis bindings.
+};
+
+constexpr size_t MAX_TERMS = 6;
+
+/// <summary>
+/// A built-in binding.
+/// A button binding is active if any of its terms are active.
+/// An axis binding is the (clamped) sum of the scaled values of its terms.
+/// </summary>
+struct Binding
+{
+    std::string_view            name;
+    std::array<Term, MAX_TERMS> terms;
+    float                       minValue = 0.0f;
+    float                       maxValue = 1.0f;
+};
+
+using Pad = Gamepad::Button;
+
+constexpr Term key( Key k, float scale = 1.0f )
+{
+    return { Source::Key, ANY_PLAYER, static_cast<uint8_t>( k ), scale };
+}
+
+constexpr Term mouseButton( Button button )
+{
+    return { Source::MouseButton, ANY_PLAYER, static_cast<uint8_t>( button ) };
+}
+
+constexpr Term mouseAxis( MouseAxis axis )
+{
+    return { Source::MouseAxis, ANY_PLAYER, static_cast<uint8_t>( axis ) };
+}
+
+constexpr Term pad( Pad button, int8_t player = ANY_PLAYER )
+{
+    return { Source::GamepadButton, player, static_cast<uint8_t>( button ) };
+}
+
+constexpr Term padAxis( GamepadAxis axis, int8_t player = ANY_PLAYER )
+{
+    return { Source::GamepadAxis, player, static_cast<uint8_t>( axis ) };
+}
+
+constexpr float NO_LIMIT = std::numeric_limits<float>::max();
+
+// clang-format off
+constexpr Binding AXIS_BINDINGS[] = {
+    { "Horizontal", { padAxis( GamepadAxis::LeftX ), padAxis( GamepadAxis::RightX ), key( Key::A, -1.0f ), key( Key::D ), key( Key::Left, -1.0f ), key( Key::Right ) }, -1.0f, 1.0f },
+    { "Vertical", { padAxis( GamepadAxis::LeftY ), padAxis( GamepadAxis::RightY ), key( Key::S, -1.0f ), key( Key::W ), key( Key::Down, -1.0f ), key( Key::Up ) }, -1.0f, 1.0f },
+    { "Fire1", { padAxis( GamepadAxis::RightTrigger ), key( Key::LeftControl ), mouseButton( Button::Left ) } },
+    { "Fire2", { padAxis( GamepadAxis::LeftTrigger ), key( Key::LeftAlt ), mouseButton( Button::Right ) } },
+    { "Fire3", { key( Key::LeftShift ), mouseButton( Button::Middle ) } },
+    { "Jump", { pad( Pad::A ), key( Key::Space ) } },
+    { "Mouse X", { mouseAxis( MouseAxis::X ) }, -NO_LIMIT, NO_LIMIT },
+    { "Mouse Y", { mouseAxis( MouseAxis::Y ) }, -NO_LIMIT, NO_LIMIT },
+    { "Mouse ScrollWheel", { mouseAxis( MouseAxis::ScrollWheel ) }, -NO_LIMIT, NO_LIMIT },
+    { "Submit", { pad( Pad::A ), pad( Pad::Start ), key( Key::Enter ), key( Key::Space ) } },
+    { "Cancel", { pad( Pad::B ), pad( Pad::Back ), key( Key::Escape ) } },
+};
+
+constexpr Binding BUTTON_BINDINGS[] = {
+    { "win", { key( Key::LeftSuper ), key( Key::RightSuper ) } },
+    { "mouse 0", { mouseButton( Button::Left ) } },
+    { "mouse 1", { mouseButton( Button::Right ) } },
+    { "mouse 2", { mouseButton( Button::Middle ) } },
+    { "mouse x1", { mouseButton( Button::XButton1 ) } },
+    { "mouse x2", { mouseButton( Button::XButton2 ) } },
+    { "joystick button 1", { pad( Pad::A ) } },
+    { "joystick button 2", { pad( Pad::B ) } },
+    { "joystick button 3", { pad( Pad::X ) } },
+    { "joystick button 4", { pad( Pad::Y ) } },
+    { "joystick button 5", { pad( Pad::LeftShoulder ) } },
+    { "joystick button 6", { pad( Pad::RightShoulder ) } },
+    { "joystick button 7", { pad( Pad::View ) } },
+    { "joystick button 8", { pad( Pad::Menu ) } },
+    { "joystick button 9", { pad( Pad::LeftStick ) } },
+    { "joystick button 10", { pad( Pad::RightStick ) } },
+    { "joystick dpad up", { pad( Pad::DPadUp ) } },
+    { "joystick dpad down", { pad( Pad::DPadDown ) } },
+    { "joystick dpad left", { pad( Pad::DPadLeft ) } },
+    { "joystick dpad right", { pad( Pad::DPadRight ) } },
+    { "joystick 1 button 1", { pad( Pad::A, 0 ) } },
+    { "joystick 1 button 2", { pad( Pad::B, 0 ) } },
+    { "joystick 1 button 3", { pad( Pad::X, 0 ) } },
+    { "joystick 1 button 4", { pad( Pad::Y, 0 ) } },
+    { "joystick 1 button 5", { pad( Pad::LeftShoulder, 0 ) } },
+    { "joystick 1 button 6", { pad( Pad::RightShoulder, 0 ) } },
+    { "joystick 1 button 7", { pad( Pad::View, 0 ) } },
+    { "joystick 1 button 8", { pad( Pad::Menu, 0 ) } },
+    { "joystick 1 button 9", { pad( Pad::LeftStick, 0 ) } },
+    { "joystick 1 button 10", { pad( Pad::RightStick, 0 ) } },
+    { "joystick 1 dpad up", { pad( Pad::DPadUp, 0 ) } },
+    { "joystick 1 dpad down", { pad( Pad::DPadDown, 0 ) } },
+    { "joystick 1 dpad left", { pad( Pad::DPadLeft, 0 ) } },
+    { "joystick 1 dpad right", { pad( Pad::DPadRight, 0 ) } },
+    { "joystick 2 button 1", { pad( Pad::A, 1 ) } },
+    { "joystick 2 button 2", { pad( Pad::B, 1 ) } },
+    { "joystick 2 button 3", { pad( Pad::X, 1 ) } },
+    { "joystick 2 button 4", { pad( Pad::Y, 1 ) } },
+    { "joystick 2 button 5", { pad( Pad::LeftShoulder, 1 ) } },
+    { "joystick 2 button 6", { pad( Pad::RightShoulder, 1 ) } },
+    { "joystick 2 button 7", { pad( Pad::View, 1 ) } },
+    { "joystick 2 button 8", { pad( Pad::Menu, 1 ) } },
+    { "joystick 2 button 9", { pad( Pad::LeftStick, 1 ) } },
+    { "joystick 2 button 10", { pad( Pad::RightStick, 1 ) } },
+    { "joystick 2 dpad up", { pad( Pad::DPadUp, 1 ) } },
+    { "joystick 2 dpad down", { pad( Pad::DPadDown, 1 ) } },
+    { "joystick 2 dpad left", { pad( Pad::DPadLeft, 1 ) } },
+    { "joystick 2 dpad right", { pad( Pad::DPadRight, 1 ) } },
+    { "joystick 3 button 1", { pad( Pad::A, 2 ) } },
+    { "joystick 3 button 2", { pad( Pad::B, 2 ) } },
+    { "joystick 3 button 3", { pad( Pad::X, 2 ) } },
+    { "joystick 3 button 4", { pad( Pad::Y, 2 ) } },
+    { "joystick 3 button 5", { pad( Pad::LeftShoulder, 2 ) } },
+    { "joystick 3 button 6", { pad( Pad::RightShoulder, 2 ) } },
+    { "joystick 3 button 7", { pad( Pad::View, 2 ) } },
+    { "joystick 3 button 8", { pad( Pad::Menu, 2 ) } },
+    { "joystick 3 button 9", { pad( Pad::LeftStick, 2 ) } },
+    { "joystick 3 button 10", { pad( Pad::RightStick, 2 ) } },
+    { "joystick 3 dpad up", { pad( Pad::DPadUp, 2 ) } },
+    { "joystick 3 dpad down", { pad( Pad::DPadDown, 2 ) } },
+    { "joystick 3 dpad left", { pad( Pad::DPadLeft, 2 ) } },
+    { "joystick 3 dpad right", { pad( Pad::DPadRight, 2 ) } },
+    { "joystick 4 button 1", { pad( Pad::A, 3 ) } },
+    { "joystick 4 button 2", { pad( Pad::B, 3 ) } },
+    { "joystick 4 button 3", { pad( Pad::X, 3 ) } },
+    { "joystick 4 button 4", { pad( Pad::Y, 3 ) } },
+    { "joystick 4 button 5", { pad( Pad::LeftShoulder, 3 ) } },
+    { "joystick 4 button 6", { pad( Pad::RightShoulder, 3 ) } },
+    { "joystick 4 button 7", { pad( Pad::View, 3 ) } },
+    { "joystick 4 button 8", { pad( Pad::Menu, 3 ) } },
+    { "joystick 4 button 9", { pad( Pad::LeftStick, 3 ) } },
+    { "joystick 4 button 10", { pad( Pad::RightStick, 3 ) } },
+    { "joystick 4 dpad up", { pad( Pad::DPadUp, 3 ) } },
+    { "joystick 4 dpad down", { pad( Pad::DPadDown, 3 ) } },
+    { "joystick 4 dpad left", { pad( Pad::DPadLeft, 3 ) } },
+    { "joystick 4 dpad right", { pad( Pad::DPadRight, 3 ) } },
+    { "Submit", { pad( Pad::A ), pad( Pad::Start ), key( Key::Enter ), key( Key::Space ) } },
+    { "Cancel", { pad( Pad::B ), pad( Pad::Back ), key( Key::Escape ) } },
+};
+// clang-format on
+
+/// <summary>
+/// User-registered callback functions for an action.
+/// </summary>
+struct Callbacks
+{
+    AxisCallback   axis;
+    ButtonCallback button;
+    ButtonCallback buttonDown;
+    ButtonCallback buttonUp;
+
+    CallbackCaching axisCaching       = CallbackCaching::PerFrame;
+    CallbackCaching buttonCaching     = CallbackCaching::PerFrame;
+    CallbackCaching buttonDownCaching = CallbackCaching::PerFrame;
+    CallbackCaching buttonUpCaching   = CallbackCaching::PerFrame;
+};
+
+constexpr int16_t  NO_BINDING   = -1;
+constexpr uint32_t NO_MASK      = UINT32_MAX;
+constexpr uint32_t NO_CALLBACKS = UINT32_MAX;
+
+/// <summary>
+/// An action maps a name to the bindings and callback functions that are used to evaluate it.
+/// User-registered callback functions take precedence over the built-in bindings.
+/// </summary>
+struct Action
+{
+    std::string_view name;
+    int16_t          axisBinding = NO_BINDING;    ///< Index into AXIS_BINDINGS.
+    uint32_t         buttonMask  = NO_MASK;       ///< Index into BUILTIN_BUTTON_MASKS, or USER_MASK_OFFSET + index into the context's masks.
+    uint32_t         callbacks   = NO_CALLBACKS;  ///< Index into the context's callbacks.
+
+    // If the name of the action is also a key name, getButtonDown and getButtonUp
+    // fall back to the key if no button binding is mapped.
+    Key key = Key::None;
+};
+
+/// <summary>
+/// The result of evaluating an axis or button callback, cached for the frame in which it was evaluated.
+/// The result is valid if the frame matches the generation of the context.
+/// </summary>
+template<typename T>
+struct CachedResult
+{
+    uint32_t frame = 0;
+    T        value {};
+};
+
+/// <summary>
+/// The cached results of an action (see memoize).
+/// </summary>
+struct ActionCache
+{
+    CachedResult<float> axis;
+    CachedResult<bool>  button[3];  ///< Indexed by Edge.
+};
+
+constexpr size_t countBuiltinActions()
+{
+    size_t count = std::size( AXIS_BINDINGS );
+    for ( const Binding& button: BUTTON_BINDINGS )
+    {
+        if ( std::ranges::none_of( AXIS_BINDINGS, [&]( const Binding& axis ) { return axis.name == button.name; } ) )
+            ++count;
+    }
+    return count;
+}
+
+constexpr size_t NUM_BUILTIN_ACTIONS = countBuiltinActions();
+
+/// <summary>
+/// Merge the axis and button bindings into a table of actions that is sorted by name.
+/// </summary>
+constexpr std::array<Action, NUM_BUILTIN_ACTIONS> makeBuiltinActions()
+{
+    std::array<Action, NUM_BUILTIN_ACTIONS> actions {};
+    size_t                                  count = 0;
+
+    for ( size_t i = 0; i < std::size( AXIS_BINDINGS ); ++i )
+    {
+        Action& action     = actions[count++];
+        action.name        = AXIS_BINDINGS[i].name;
+        action.axisBinding = static_cast<int16_t>( i );
+        action.key         = Keyboard::keyFromName( action.name );
+    }
+
+    for ( size_t i = 0; i < std::size( BUTTON_BINDINGS ); ++i )
+    {
+        auto iter = std::find_if( actions.begin(), actions.begin() + count, [&]( const Action& a ) { return a.name == BUTTON_BINDINGS[i].name; } );
+        if ( iter == actions.begin() + count )
+        {
+            iter       = actions.begin() + count++;
+            iter->name = BUTTON_BINDINGS[i].name;
+            iter->key  = Keyboard::keyFromName( iter->name );
+        }
+        iter->buttonMask = static_cast<uint32_t>( i );
+    }
+
+    std::sort( actions.begin(), actions.end(), []( const Action& lhs, const Action& rhs ) { return lhs.name < rhs.name; } );
+
+    return actions;
+}
+
+/// <summary>
+/// Convert a button binding to a mask over the input bit vector.
+/// </summary>
+constexpr InputBits makeButtonMask( const Binding& binding )
+{
+    InputBits mask;
+
+    for ( const Term& term: binding.terms )
+    {
+        switch ( term.source )
+        {
+        case Source::Key:
+            mask.set( InputBits::keyBit( static_cast<Key>( term.code ) ) );
+            break;
+        case Source::MouseButton:
+            mask.set( InputBits::mouseBit( static_cast<Button>( term.code ) ) );
+            break;
+        case Source::GamepadButton:
+            for ( int player = 0; player < Gamepad::MAX_PLAYER_COUNT; ++player )
+            {
+                if ( term.player == ANY_PLAYER || term.player == player )
+                    mask.set( InputBits::gamepadBit( static_cast<Pad>( term.code ), player ) );
+            }
+            break;
+        default:
+            break;
+        }
+    }
+
+    return mask;
+}
+
+constexpr auto BUILTIN_BUTTON_MASKS = []() {
+    std::array<InputBits, std::size( BUTTON_BINDINGS )> masks {};
+    for ( size_t i = 0; i < masks.size(); ++i )
+        masks[i] = makeButtonMask( BUTTON_BINDINGS[i] );
+
+    return masks;
+}();
+
+// The built-in button masks are shared by all contexts. Masks that are owned by a context start at
+// USER_MASK_OFFSET so the results of both sets of masks start on a 64-bit word boundary.
+constexpr size_t BUILTIN_MASK_WORDS = ( BUILTIN_BUTTON_MASKS.size() + 63 ) / 64;
+constexpr size_t USER_MASK_OFFSET   = BUILTIN_MASK_WORDS * 64;
+
+// The results of both sets of masks are stored in the fixed-size arrays of the frame.
+constexpr size_t MAX_USER_MASKS = ( InputFrame::MAX_BUTTON_MASK_WORDS - BUILTIN_MASK_WORDS ) * 64;
+static_assert( MAX_USER_MASKS == 256, "Update the limit in the documentation of Input::addButtonBinding." );
+
+// The built-in actions. Each context starts with a copy of this table.
+constexpr std::array<Action, NUM_BUILTIN_ACTIONS> BUILTIN_ACTIONS = makeBuiltinActions();
+
+}  // namespace
+
+namespace input::detail
+{
+/// <summary>
+/// The actions, callbacks, and button masks of a context.
+/// </summary>
+/// <remarks>
+/// The frame of the context and the snapshots that are published from it point to the table, and other threads
+/// can query the snapshots. A table that may have been published is never modified: adding an action, callback,
+/// or binding modifies a copy (see getWritableTable), and the context keeps the previous table until the snapshots
+/// that point to it have been overwritten.
+/// </remarks>
+struct ActionTable
+{
+    // The built-in actions use the handle indices [0...NUM_BUILTIN_ACTIONS).
+    // Only the button mask and callbacks index of a built-in action are modified.
+    std::array<Action, NUM_BUILTIN_ACTIONS> builtinActions = BUILTIN_ACTIONS;
+
+    // Actions that are added at runtime with names that do not match a built-in action.
+    // User actions use the handle indices [NUM_BUILTIN_ACTIONS...).
+    // The name of a user action points to a string in the userActionNames of the context.
+    std::vector<Action>   userActions;
+    std::vector<uint32_t> sortedUserActions;  ///< Indices into userActions, sorted by name.
+
+    // User-registered callback functions (only allocated when a callback is added).
+    std::vector<Callbacks> callbacks;
+
+    // The button masks of the context (mask index USER_MASK_OFFSET + i).
+    std::vector<InputBits> buttonMasks;
+
+    // The frame number of the context when the table was created. The table has not been published
+    // (and can be modified) until the context is updated.
+    uint64_t frameNumber = 0;
+};
+
+/// <summary>
+/// An action table that was replaced, and the frame number of the context when it was replaced.
+/// </summary>
+struct RetiredTable
+{
+    uint64_t                           frameNumber;
+    std::unique_ptr<const ActionTable> table;
+};
+
+/// <summary>
+/// The state and action maps of an InputContext.
+/// </summary>
+struct InputContextData
+{
+    /// <summary>
+    /// The input state of the context.
+    /// </summary>
+    InputFrame frame;
+
+    // The current actions of the context (frame.actions points to it).
+    std::unique_ptr<ActionTable> actions = std::make_unique<ActionTable>();
+
+    // The tables that were replaced, but may still be used by a published snapshot.
+    std::vector<RetiredTable> retiredActions;
+
+    // The names of the user actions. The strings are never removed, so the names of the actions in all tables remain valid.
+    std::vector<std::unique_ptr<std::string>> userActionNames;
+
+    // The cached results of the actions, indexed by handle. Only used by the frame of the context,
+    // on the thread that updates it.
+    mutable std::vector<ActionCache> cache = std::vector<ActionCache>( NUM_BUILTIN_ACTIONS );
+
+    // The on-screen touch regions (bound to the touch region bits of the input edges).
+    TouchRegionMap touchRegions;
+
+    // The gamepad that is emulated with touch regions.
+    VirtualGamepad virtualGamepad;
+
+    // The presses and releases that were added since the last update (see InputContext::addEvents).
+    InputCounts pendingCounts;
+
+    // The frame generation counter. Incremented by update to invalidate the cached action results.
+    // Generation 0 is never used so a zero-initialized cache entry is never valid.
+    uint32_t generation = 1;
+
+    InputContextData()
+    {
+        frame.context = this;
+        frame.actions = actions.get();
+    }
+};
+}  // namespace input::detail
+
+using input::detail::ActionTable;
+using input::detail::InputContextData;
+using input::detail::RetiredTable;
+
+namespace
+{
+
+uint32_t findAction( const ActionTable& table, std::string_view actionName )
+{
+    // The names of the built-in actions are the same in all contexts.
+    const auto builtin = std::ranges::lower_bound( BUILTIN_ACTIONS, actionName, {}, &Action::name );
+    if ( builtin != BUILTIN_ACTIONS.end() && builtin->name == actionName )
+    {
+        INPUT_PROFILE_COUNT( BuiltinActionHits );
+        return static_cast<uint32_t>( builtin - BUILTIN_ACTIONS.begin() );
+    }
+
+    const auto& userActions = table.userActions;
+    const auto  user        = std::ranges::lower_bound( table.sortedUserActions, actionName, {}, [&]( uint32_t i ) { return userActions[i].name; } );
+    if ( user != table.sortedUserActions.end() && userActions[*user].name == actionName )
+    {
+        INPUT_PROFILE_COUNT( UserActionHits );
+        return static_cast<uint32_t>( NUM_BUILTIN_ACTIONS + *user );
+    }
+
+    INPUT_PROFILE_COUNT( ActionMisses );
+    return Input::ActionHandle::INVALID_INDEX;
+}
+
+const Action* getAction( const ActionTable& table, uint32_t index )
+{
+    if ( index < NUM_BUILTIN_ACTIONS )
+        return &table.builtinActions[index];
+
+    if ( index - NUM_BUILTIN_ACTIONS < table.userActions.size() )
+        return &table.userActions[index - NUM_BUILTIN_ACTIONS];
+
+    return nullptr;
+}
+
+Action& getAction( ActionTable& table, uint32_t index )
+{
+    return const_cast<Action&>( *getAction( std::as_const( table ), index ) );
+}
+
+/// <summary>
+/// Get the action table of a context to modify it. If the table may have been published, it is replaced with a copy.
+/// </summary>
+ActionTable& getWritableTable( InputContextData& context )
+{
+    InputFrame& frame = context.frame;
+
+    if ( context.actions->frameNumber != frame.frameNumber )
+    {
+        auto actions         = std::make_unique<ActionTable>( *context.actions );
+        actions->frameNumber = frame.frameNumber;
+
+        context.retiredActions.push_back( { frame.frameNumber, std::move( context.actions ) } );
+        context.actions = std::move( actions );
+        frame.actions   = context.actions.get();
+    }
+
+    return *context.actions;
+}
+
+/// <summary>
+/// Free the action tables that can no longer be used by a published snapshot.
+/// </summary>
+void freeRetiredTables( InputContextData& context ) noexcept
+{
+    // The last snapshot that points to a table is the one of the frame in which the table was replaced.
+    // Input::update overwrites that snapshot when it publishes the third frame after it, so the table is
+    // freed by the update after that.
+    std::erase_if( context.retiredActions, [&]( const RetiredTable& retired ) { return retired.frameNumber + 3 < context.frame.frameNumber; } );
+}
+
+uint32_t getOrAddAction( InputContextData& context, std::string_view actionName )
+{
+    if ( const uint32_t index = findAction( *context.actions, actionName ); index != Input::ActionHandle::INVALID_INDEX )
+        return index;
+
+    ActionTable& table       = getWritableTable( context );
+    const auto&  userActions = table.userActions;
+    const auto   index       = static_cast<uint32_t>( userActions.size() );
+    const auto   pos         = std::ranges::lower_bound( table.sortedUserActions, actionName, {}, [&]( uint32_t i ) { return userActions[i].name; } );
+
+    // The string is heap allocated so the name of the action remains valid when userActionNames grows.
+    const std::string& name = *context.userActionNames.emplace_back( std::make_unique<std::string>( actionName ) );
+
+    Action& action = table.userActions.emplace_back();
+    action.name    = name;
+    action.key     = Keyboard::keyFromName( name );
+
+    table.sortedUserActions.insert( pos, index );
+    context.cache.emplace_back();
+
+    return static_cast<uint32_t>( NUM_BUILTIN_ACTIONS + index );
+}
+
+Callbacks& getOrAddCallbacks( InputContextData& context, std::string_view actionName )
+{
+    const uint32_t index  = getOrAddAction( context, actionName );
+    ActionTable&   table  = getWritableTable( context );
+    Action&        action = getAction( table, index );
+    if ( action.callbacks == NO_CALLBACKS )
+    {
+        action.callbacks = static_cast<uint32_t>( table.callbacks.size() );
+        table.callbacks.emplace_back();
+    }
+
+    return table.callbacks[action.callbacks];
+}
+
+const Callbacks* getCallbacks( const ActionTable& table, const Action& action )
+{
+    return action.callbacks != NO_CALLBACKS ? &table.callbacks[action.callbacks] : nullptr;
+}
+
+bool testEdge( ButtonState state, Edge edge )
+{
+    switch ( edge )
+    {
+    case Edge::Down:
+        return state == ButtonState::Held || state == ButtonState::Pressed;
+    case Edge::Pressed:
+        return state == ButtonState::Pressed;
+    case Edge::Released:
+        return state == ButtonState::Released;
+    }
+
+    return false;
+}
+
+ButtonState getMouseButtonState( const MouseStateTracker& mouseState, Button button )
+{
+    switch ( button )
+    {
+    case Button::Left:
+        return mouseState.leftButton;
+    case Button::Right:
+        return mouseState.rightButton;
+    case Button::Middle:
+        return mouseState.middleButton;
+    case Button::XButton1:
+        return mouseState.xButton1;
+    case Button::XButton2:
+        return mouseState.xButton2;
+    default:
+        return ButtonState::Up;
+    }
+}
+
+float getGamepadAxis( const GamepadStateTracker& gamepadState, GamepadAxis axis )
+{
+    const auto state = gamepadState.getLastState();
+
+    switch ( axis )
+    {
+    case GamepadAxis::LeftX:
+        return state.thumbSticks.leftX;
+    case GamepadAxis::LeftY:
+        return state.thumbSticks.leftY;
+    case GamepadAxis::RightX:
+        return state.thumbSticks.rightX;
+    case GamepadAxis::RightY:
+        return state.thumbSticks.rightY;
+    case GamepadAxis::LeftTrigger:
+        return state.triggers.left;
+    case GamepadAxis::RightTrigger:
+        return state.triggers.right;
+    }
+
+    return 0.0f;
+}
+
+void invalidateCache( InputContextData& context ) noexcept
+{
+    if ( ++context.generation == 0 )
+        context.generation = 1;
+}
+
+/// <summary>
+/// Check if a frame is the current frame of its context (and not a snapshot that can be queried from other threads).
+/// </summary>
+bool isContextFrame( const InputFrame& frame ) noexcept
+{
+    return frame.context && &frame == &frame.context->frame;
+}
+
+/// <summary>
+/// Get the cached results of an action, or null if the frame is a snapshot (the results of snapshots are not cached).
+/// </summary>
+ActionCache* getCache( const InputFrame& frame, uint32_t index ) noexcept
+{
+    return isContextFrame( frame ) ? &frame.context->cache[index] : nullptr;
+}
+
+/// <summary>
+/// Return the cached value if it was evaluated in this generation, otherwise evaluate (and optionally cache) it.
+/// </summary>
+template<typename T, typename Evaluate>
+T memoize( const InputFrame& frame, CachedResult<T>* result, CallbackCaching caching, Evaluate&& evaluate )
+{
+    if ( !result || caching == CallbackCaching::None )
+        return evaluate();
+
+    const uint32_t generation = frame.context->generation;
+    if ( result->frame != generation )
+    {
+        result->value = evaluate();
+        result->frame = generation;
+    }
+
+    return result->value;
+}
+
+/// <summary>
+/// Gather the down, pressed, and released edges of all digital inputs into the input bit vectors.
+/// </summary>
+void updateInputEdges( InputFrame& frame )
+{
+    InputEdges& edges = frame.edges;
+
+    // The keyboard state has the same layout as the first 256 bits of the input bit vector.
+    static_assert( sizeof( Keyboard::State ) == InputBits::GAMEPAD_OFFSET / 8 );
+    std::memcpy( edges.down.words, &frame.keyboardState.lastState, sizeof( Keyboard::State ) );
+    std::memcpy( edges.pressed.words, &frame.keyboardState.pressed, sizeof( Keyboard::State ) );
+    std::memcpy( edges.released.words, &frame.keyboardState.released, sizeof( Keyboard::State ) );
+
+    // The gamepad state trackers use the same button layout as the gamepad bits of the input bit vector.
+    for ( int player = 0; player < Gamepad::MAX_PLAYER_COUNT; ++player )
+    {
+        const GamepadStateTracker& gamepadState = frame.gamepadStates[player];
+
+        edges.down.setGamepadButtons( player, gamepadState.down );
+        edges.pressed.setGamepadButtons( player, gamepadState.pressed );
+        edges.released.setGamepadButtons( player, gamepadState.released );
+    }
+
+    for ( Button button: { Button::Left, Button::Right, Button::Middle, Button::XButton1, Button::XButton2 } )
+    {
+        const ButtonState state = getMouseButtonState( frame.mouseState, button );
+        const size_t      bit   = InputBits::mouseBit( button );
+
+        testEdge( state, Edge::Down ) ? edges.down.set( bit ) : edges.down.reset( bit );
+        testEdge( state, Edge::Pressed ) ? edges.pressed.set( bit ) : edges.pressed.reset( bit );
+        testEdge( state, Edge::Released ) ? edges.released.set( bit ) : edges.released.reset( bit );
+    }
+
+    // Add the presses and releases that were counted from events (including the ones that are shorter than a frame).
+    for ( size_t i = 0; i < InputBits::WORD_COUNT; ++i )
+    {
+        edges.pressed.words[i] |= frame.counts.pressed.words[i];
+        edges.released.words[i] |= frame.counts.released.words[i];
+    }
+}
+
+/// <summary>
+/// Evaluate the built-in button masks and the button masks of the context against the input edges.
+/// </summary>
+void evaluateButtonMasks( InputContextData& context )
+{
+    InputFrame&               frame = context.frame;
+    const std::span<uint64_t> down { frame.buttonMasksDown };
+    const std::span<uint64_t> pressed { frame.buttonMasksPressed };
+    const std::span<uint64_t> released { frame.buttonMasksReleased };
+
+    evaluateMasks( BUILTIN_BUTTON_MASKS, frame.edges, down.first( BUILTIN_MASK_WORDS ), pressed.first( BUILTIN_MASK_WORDS ), released.first( BUILTIN_MASK_WORDS ) );
+    evaluateMasks( context.actions->buttonMasks, frame.edges, down.subspan( BUILTIN_MASK_WORDS ), pressed.subspan( BUILTIN_MASK_WORDS ), released.subspan( BUILTIN_MASK_WORDS ) );
+}
+
+const InputBits& getButtonMask( const InputFrame& frame, uint32_t mask )
+{
+    // The results of a frame were evaluated with the masks of its action table, so the mask is always in the table.
+    return mask < USER_MASK_OFFSET ? BUILTIN_BUTTON_MASKS[mask] : frame.actions->buttonMasks[mask - USER_MASK_OFFSET];
+}
+
+bool testButtonMask( const InputFrame& frame, uint32_t mask, Edge edge )
+{
+    const auto& results = edge == Edge::Down ? frame.buttonMasksDown : edge == Edge::Pressed ? frame.buttonMasksPressed : frame.buttonMasksReleased;
+    const bool  result  = ( results[mask / 64] >> ( mask % 64 ) & 1 ) != 0;
+
+#ifdef INPUT_ENABLE_LATENCY_PROBE
+    // Only the queries of the current frame of a context are reported to the latency probe.
+    if ( result && edge == Edge::Pressed && isContextFrame( frame ) )
+        LatencyProbe::consume( getButtonMask( frame, mask ) );
+#endif
+
+    return result;
+}
+
+/// <summary>
+/// Test if an input was pressed this frame.
+/// </summary>
+bool testPressed( const InputFrame& frame, size_t bit ) noexcept
+{
+    const bool pressed = frame.edges.pressed.test( bit );
+
+#ifdef INPUT_ENABLE_LATENCY_PROBE
+    if ( pressed && isContextFrame( frame ) )
+        LatencyProbe::consume( bit );
+#endif
+
+    return pressed;
+}
+
+void addButtonBinding( InputContextData& context, std::string_view buttonName, size_t bit )
+{
+    const uint32_t index  = getOrAddAction( context, buttonName );
+    ActionTable&   table  = getWritableTable( context );
+    Action&        action = getAction( table, index );
+
+    // The built-in masks are shared by all contexts, so copy the mask before modifying it.
+    if ( action.buttonMask == NO_MASK || action.buttonMask < USER_MASK_OFFSET )
+    {
+        // The results of the masks are stored in the frame, so the binding is ignored if the context has no free mask.
+        if ( table.buttonMasks.size() == MAX_USER_MASKS )
+            return;
+
+        const InputBits mask = action.buttonMask != NO_MASK ? BUILTIN_BUTTON_MASKS[action.buttonMask] : InputBits {};
+
+        action.buttonMask = static_cast<uint32_t>( USER_MASK_OFFSET + table.buttonMasks.size() );
+        table.buttonMasks.push_back( mask );
+    }
+
+    table.buttonMasks[action.buttonMask - USER_MASK_OFFSET].set( bit );
+
+    // Re-evaluate so the binding is reflected immediately (and not only after the next update).
+    evaluateButtonMasks( context );
+    invalidateCache( context );
+}
+
+/// <summary>
+/// Evaluate a built-in axis binding.
+/// </summary>
+float evaluateAxis( const Binding& binding, std::span<const GamepadStateTracker> gamepadStates, const KeyboardStateTracker& keyboardState, const MouseStateTracker& mouseState )
+{
+    float value = 0.0f;
+
+    for ( const Term& term: binding.terms )
+    {
+        float termValue = 0.0f;
+
+        switch ( term.source )
+        {
+        case Source::None:
+            return std::clamp( value, binding.minValue, binding.maxValue );
+        case Source::Key:
+            termValue = keyboardState.lastState.isKeyDown( static_cast<Key>( term.code ) ) ? 1.0f : 0.0f;
+            break;
+        case Source::MouseButton:
+            termValue = testEdge( getMouseButtonState( mouseState, static_cast<Button>( term.code ) ), Edge::Down ) ? 1.0f : 0.0f;
+            break;
+        case Source::MouseAxis:
+            switch ( static_cast<MouseAxis>( term.code ) )
+            {
+            case MouseAxis::X:
+                termValue = mouseState.getLastState().x;
+                break;
+            case MouseAxis::Y:
+                termValue = mouseState.getLastState().y;
+                break;
+            case MouseAxis::ScrollWheel:
+                termValue = static_cast<float>( mouseState.getLastState().scrollWheelValue );
+                break;
+            }
+            break;
+        case Source::GamepadButton:
+            if ( term.player == ANY_PLAYER )
+            {
+                for ( const auto& gamepadState: gamepadStates )
+                    termValue += testEdge( gamepadState.getButtonState( static_cast<Pad>( term.code ) ), Edge::Down ) ? 1.0f : 0.0f;
+            }
+            else
+            {
+                termValue = testEdge( gamepadStates[term.player].getButtonState( static_cast<Pad>( term.code ) ), Edge::Down ) ? 1.0f : 0.0f;
+            }
+            break;
+        case Source::GamepadAxis:
+            if ( term.player == ANY_PLAYER )
+            {
+                for ( const auto& gamepadState: gamepadStates )
+                    termValue += getGamepadAxis( gamepadState, static_cast<GamepadAxis>( term.code ) );
+            }
+            else
+            {
+                termValue = getGamepadAxis( gamepadStates[term.player], static_cast<GamepadAxis>( term.code ) );
+            }
+            break;
+        }
+
+        value += termValue * term.scale;
+    }
+
+    return std::clamp( value, binding.minValue, binding.maxValue );
+}
+
+/// <summary>
+/// Evaluate the axis of an action.
+/// Results are only cached for the frame that is owned by the context (snapshots may be queried from any thread).
+/// </summary>
+float queryAxis( const InputFrame& frame, uint32_t index )
+{
+    if ( !frame.actions )
+        return 0.0f;
+
+    const ActionTable& table = *frame.actions;
+    const Action*      a     = getAction( table, index );
+    if ( !a )
+        return 0.0f;
+
+    ActionCache* cache = getCache( frame, index );
+
+    if ( const Callbacks* callbacks = getCallbacks( table, *a ); callbacks && callbacks->axis )
+    {
+        return memoize( frame, cache ? &cache->axis : nullptr, callbacks->axisCaching, [&] {
+            INPUT_PROFILE_COUNT( CallbackInvocations );
+            return callbacks->axis( frame.gamepadStates, frame.keyboardState, frame.mouseState );
+        } );
+    }
+
+    if ( a->axisBinding != NO_BINDING )
+    {
+        return memoize( frame, cache ? &cache->axis : nullptr, CallbackCaching::PerFrame, [&] { return evaluateAxis( AXIS_BINDINGS[a->axisBinding], frame.gamepadStates, frame.keyboardState, frame.mouseState ); } );
+    }
+
+    return 0.0f;
+}
+
+/// <summary>
+/// Evaluate the held (Edge::Down), pressed, or released state of an action.
+/// </summary>
+bool queryButton( const InputFrame& frame, uint32_t index, Edge edge )
+{
+    if ( !frame.actions )
+        return false;
+
+    const ActionTable& table = *frame.actions;
+    const Action*      a     = getAction( table, index );
+    if ( !a )
+        return false;
+
+    const Callbacks* callbacks = getCallbacks( table, *a );
+
+    // First check if there is a matching button callback.
+    if ( callbacks )
+    {
+        const ButtonCallback& callback = edge == Edge::Down ? callbacks->button : edge == Edge::Pressed ? callbacks->buttonDown : callbacks->buttonUp;
+        const CallbackCaching caching  = edge == Edge::Down ? callbacks->buttonCaching : edge == Edge::Pressed ? callbacks->buttonDownCaching : callbacks->buttonUpCaching;
+
+        if ( callback )
+        {
+            ActionCache* cache = getCache( frame, index );
+            return memoize( frame, cache ? &cache->button[static_cast<size_t>( edge )] : nullptr, caching, [&] {
+                INPUT_PROFILE_COUNT( CallbackInvocations );
+                return callback( frame.gamepadStates, frame.keyboardState, frame.mouseState );
+            } );
+        }
+    }
+
+    // Then check the button bindings.
+    if ( a->buttonMask != NO_MASK )
+    {
+        return testButtonMask( frame, a->buttonMask, edge );
+    }
+
+    switch ( edge )
+    {
+    case Edge::Down:
+        // Then check if there is a matching axis mapping.
+        if ( ( callbacks && callbacks->axis ) || a->axisBinding != NO_BINDING )
+        {
+            return queryAxis( frame, index ) > 0.0f;
+        }
+        break;
+    case Edge::Pressed:
+        // Then check to see if the action name is also a key name.
+        return a->key != Key::None && testPressed( frame, InputBits::keyBit( a->key ) );
+    case Edge::Released:
+        return a->key != Key::None && frame.edges.released.test( InputBits::keyBit( a->key ) );
+    }
+
+    return false;
+}
+
+bool queryButton( const InputFrame& frame, std::string_view buttonName, Edge edge )
+{
+    const uint32_t index = frame.actions ? findAction( *frame.actions, buttonName ) : Input::ActionHandle::INVALID_INDEX;
+    if ( index != Input::ActionHandle::INVALID_INDEX )
+    {
+        return queryButton( frame, index, edge );
+    }
+
+    // Then check to see if there is a key with the same name:
+    if ( const Key key = Keyboard::keyFromName( buttonName ); key != Key::None )
+    {
+        switch ( edge )
+        {
+        case Edge::Pressed:
+            return testPressed( frame, InputBits::keyBit( key ) );
+        case Edge::Released:
+            return frame.edges.released.test( InputBits::keyBit( key ) );
+        default:
+            break;
+        }
+    }
+
+    return false;
+}
+
+/// <summary>
+/// The number of times an input was pressed this frame. An input that was pressed without a counted event is counted once.
+/// </summary>
+uint32_t queryPressCount( const InputFrame& frame, size_t bit ) noexcept
+{
+    const uint32_t count = bit < InputCounts::COUNT ? frame.counts.presses[bit] : 0;
+    return std::max<uint32_t>( count, frame.edges.pressed.test( bit ) );
+}
+
+/// <summary>
+/// The number of times the inputs that are bound to an action were pressed this frame.
+/// </summary>
+uint32_t queryPressCount( const InputFrame& frame, uint32_t index )
+{
+    if ( !frame.actions )
+        return 0;
+
+    const ActionTable& table = *frame.actions;
+    const Action*      a     = getAction( table, index );
+    if ( !a )
+        return 0;
+
+    const Callbacks* callbacks = getCallbacks( table, *a );
+    if ( a->buttonMask != NO_MASK && !( callbacks && callbacks->buttonDown ) )
+    {
+        const InputBits& mask  = getButtonMask( frame, a->buttonMask );
+        uint32_t         count = 0;
+
+        // Only visit the bound inputs that were pressed.
+        for ( size_t w = 0; w < InputBits::WORD_COUNT; ++w )
+        {
+            for ( uint64_t bits = mask.words[w] & frame.edges.pressed.words[w]; bits; bits &= bits - 1 )
+                count += queryPressCount( frame, w * 64 + std::countr_zero( bits ) );
+        }
+
+        return count;
+    }
+
+    if ( a->key != Key::None && !( callbacks && callbacks->buttonDown ) )
+        return queryPressCount( frame, InputBits::keyBit( a->key ) );
+
+    // Callbacks and axis bindings do not have counts.
+    return queryButton( frame, index, Edge::Pressed ) ? 1 : 0;
+}
+
+uint32_t queryPressCount( const InputFrame& frame, std::string_view buttonName )
+{
+    const uint32_t index = frame.actions ? findAction( *frame.actions, buttonName ) : Input::ActionHandle::INVALID_INDEX;
+    if ( index != Input::ActionHandle::INVALID_INDEX )
+        return queryPressCount( frame, index );
+
+    // Then check to see if there is a key with the same name.
+    const Key key = Keyboard::keyFromName( buttonName );
+    return key != Key::None ? queryPressCount( frame, InputBits::keyBit( key ) ) : 0;
+}
+
+float queryAxis( const InputFrame& frame, std::string_view axisName )
+{
+    return frame.actions ? queryAxis( frame, findAction( *frame.actions, axisName ) ) : 0.0f;
+}
+
+}  // namespace
+
+InputContext::InputContext()
+: m_Data( std::make_unique<InputContextData>() )
+{}
+
+InputContext::~InputContext() = default;
+
+InputContext::InputContext( InputContext&& ) noexcept = default;
+
+InputContext& InputContext::operator=( InputContext&& ) noexcept = default;
+
+void InputContext::update( std::span<const Gamepad::State> gamepadStates, const Keyboard::State& keyboardState, const Mouse::State& mouseState )
+{
+    InputFrame& frame = m_Data->frame;
+
+    for ( size_t i = 0; i < Gamepad::MAX_PLAYER_COUNT; ++i )
+        frame.gamepadStates[i].update( i < gamepadStates.size() ? gamepadStates[i] : Gamepad::State {} );
+
+    frame.keyboardState.update( keyboardState );
+    frame.mouseState.update( mouseState );
+
+    // Move the presses and releases that were added since the last update to the frame.
+    frame.counts = m_Data->pendingCounts;
+    m_Data->pendingCounts.clear();
+
+    updateInputEdges( frame );
+    evaluateButtonMasks( *m_Data );
+    invalidateCache( *m_Data );
+
+    ++frame.frameNumber;
+    freeRetiredTables( *m_Data );
+}
+
+void InputContext::update( std::span<const Gamepad::State> gamepadStates, const Keyboard::State& keyboardState, const Mouse::State& mouseState, const Touch::State& touchState )
+{
+    update( gamepadStates, keyboardState, mouseState, touchState, getEventTime() );
+}
+
+void InputContext::update( std::span<const Gamepad::State> gamepadStates, const Keyboard::State& keyboardState, const Mouse::State& mouseState, const Touch::State& touchState,
+                           uint64_t timestamp )
+{
+    InputFrame& frame = m_Data->frame;
+    frame.touchState.update( touchState );
+    frame.gestures.update( frame.touchState, timestamp );
+
+    TouchRegionMap& touchRegions = m_Data->touchRegions;
+    touchRegions.update( frame.touchState );
+    frame.edges.down.setTouchRegions( touchRegions.getDown() );
+    frame.edges.pressed.setTouchRegions( touchRegions.getPressed() );
+    frame.edges.released.setTouchRegions( touchRegions.getReleased() );
+
+    // Merge the virtual gamepad into its player slot before the gamepad state trackers are updated.
+    VirtualGamepad& virtualGamepad = m_Data->virtualGamepad;
+    if ( virtualGamepad.getPlayerIndex() >= 0 )
+    {
+        virtualGamepad.update( touchRegions );
+
+        Gamepad::State states[Gamepad::MAX_PLAYER_COUNT] {};
+        std::copy_n( gamepadStates.begin(), std::min( gamepadStates.size(), std::size( states ) ), states );
+        virtualGamepad.apply( states );
+
+        update( states, keyboardState, mouseState );
+        return;
+    }
+
+    update( gamepadStates, keyboardState, mouseState );
+}
+
+void InputContext::setGestureSettings( const GestureSettings& settings ) noexcept
+{
+    m_Data->frame.gestures.setSettings( settings );
+}
+
+void InputContext::addEvents( std::span<const Event> events ) noexcept
+{
+    m_Data->pendingCounts.add( events );
+
+    // The timestamps are recorded in the trackers of the frame before the next update.
+    InputFrame& frame = m_Data->frame;
+    frame.keyboardState.addEvents( events );
+    frame.mouseState.addEvents( events );
+    for ( int player = 0; player < Gamepad::MAX_PLAYER_COUNT; ++player )
+        frame.gamepadStates[player].addEvents( events, player );
+}
+
+uint32_t InputContext::addTouchRegion( std::string_view buttonName, const TouchRect& rect )
+{
+    const uint32_t region = m_Data->touchRegions.addRegion( buttonName, rect );
+    if ( region != TouchRegionMap::INVALID_REGION )
+        ::addButtonBinding( *m_Data, buttonName, InputBits::touchRegionBit( region ) );
+
+    return region;
+}
+
+TouchRegionMap& InputContext::getTouchRegions() noexcept
+{
+    return m_Data->touchRegions;
+}
+
+const TouchRegionMap& InputContext::getTouchRegions() const noexcept
+{
+    return m_Data->touchRegions;
+}
+
+VirtualGamepad& InputContext::getVirtualGamepad() noexcept
+{
+    return m_Data->virtualGamepad;
+}
+
+const InputFrame& InputContext::getFrame() const noexcept
+{
+    return m_Data->frame;
+}
+
+Input::ActionHandle InputContext::getActionHandle( std::string_view actionName )
+{
+    return { getOrAddAction( *m_Data, actionName ) };
+}
+
+float InputContext::getAxis( std::string_view axisName ) const
+{
+    return m_Data->frame.getAxis( axisName );
+}
+
+float InputContext::getAxis( Input::ActionHandle action ) const
+{
+    return m_Data->frame.getAxis( action );
+}
+
+bool InputContext::getButton( std::string_view buttonName ) const
+{
+    return m_Data->frame.getButton( buttonName );
+}
+
+bool InputContext::getButton( Input::ActionHandle action ) const
+{
+    return m_Data->frame.getButton( action );
+}
+
+bool InputContext::getButtonDown( std::string_view buttonName ) const
+{
+    return m_Data->frame.getButtonDown( buttonName );
+}
+
+bool InputContext::getButtonDown( Input::ActionHandle action ) const
+{
+    return m_Data->frame.getButtonDown( action );
+}
+
+bool InputContext::getButtonUp( std::string_view buttonName ) const
+{
+    return m_Data->frame.getButtonUp( buttonName );
+}
+
+bool InputContext::getButtonUp( Input::ActionHandle action ) const
+{
+    return m_Data->frame.getButtonUp( action );
+}
+
+uint32_t InputContext::getPressCount( std::string_view buttonName ) const
+{
+    return m_Data->frame.getPressCount( buttonName );
+}
+
+uint32_t InputContext::getPressCount( Input::ActionHandle action ) const
+{
+    return m_Data->frame.getPressCount( action );
+}
+
+void InputContext::addAxisCallback( std::string_view axisName, AxisCallback callback, CallbackCaching caching )
+{
+    Callbacks& callbacks  = getOrAddCallbacks( *m_Data, axisName );
+    callbacks.axis        = std::move( callback );
+    callbacks.axisCaching = caching;
+
+    invalidateCache( *m_Data );
+}
+
+void InputContext::addButtonCallback( std::string_view buttonName, ButtonCallback callback, CallbackCaching caching )
+{
+    Callbacks& callbacks    = getOrAddCallbacks( *m_Data, buttonName );
+    callbacks.button        = std::move( callback );
+    callbacks.buttonCaching = caching;
+
+    invalidateCache( *m_Data );
+}
+
+void InputContext::addButtonDownCallback( std::string_view buttonName, ButtonCallback callback, CallbackCaching caching )
+{
+    Callbacks& callbacks        = getOrAddCallbacks( *m_Data, buttonName );
+    callbacks.buttonDown        = std::move( callback );
+    callbacks.buttonDownCaching = caching;
+
+    invalidateCache( *m_Data );
+}
+
+void InputContext::addButtonUpCallback( std::string_view buttonName, ButtonCallback callback, CallbackCaching caching )
+{
+    Callbacks& callbacks      = getOrAddCallbacks( *m_Data, buttonName );
+    callbacks.buttonUp        = std::move( callback );
+    callbacks.buttonUpCaching = caching;
+
+    invalidateCache( *m_Data );
+}
+
+void InputContext::addButtonBinding( std::string_view buttonName, Key key )
+{
+    ::addButtonBinding( *m_Data, buttonName, InputBits::keyBit( key ) );
+}
+
+void InputContext::addButtonBinding( std::string_view buttonName, Button button )
+{
+    ::addButtonBinding( *m_Data, buttonName, InputBits::mouseBit( button ) );
+}
+
+void InputContext::addButtonBinding( std::string_view buttonName, Gamepad::Button button, int playerIndex )
+{
+    for ( int player = 0; player < Gamepad::MAX_PLAYER_COUNT; ++player )
+    {
+        if ( playerIndex < 0 || playerIndex == player )
+            ::addButtonBinding( *m_Data, buttonName, InputBits::gamepadBit( button, player ) );
+    }
+}
+
+float InputFrame::getAxis( std::string_view axisName ) const
+{
+    return queryAxis( *this, axisName );
+}
+
+float InputFrame::getAxis( Input::ActionHandle action ) const
+{
+    return queryAxis( *this, action.index );
+}
+
+bool InputFrame::getButton( std::string_view buttonName ) const
+{
+    return queryButton( *this, buttonName, Edge::Down );
+}
+
+bool InputFrame::getButton( Input::ActionHandle action ) const
+{
+    return queryButton( *this, action.index, Edge::Down );
+}
+
+bool InputFrame::getButtonDown( std::string_view buttonName ) const
+{
+    return queryButton( *this, buttonName, Edge::Pressed );
+}
+
+bool InputFrame::getButtonDown( Input::ActionHandle action ) const
+{
+    return queryButton( *this, action.index, Edge::Pressed );
+}
+
+bool InputFrame::getButtonUp( std::string_view buttonName ) const
+{
+    return queryButton( *this, buttonName, Edge::Released );
+}
+
+bool InputFrame::getButtonUp( Input::ActionHandle action ) const
+{
+    return queryButton( *this, action.index, Edge::Released );
+}
+
+uint32_t InputFrame::getPressCount( std::string_view buttonName ) const
+{
+    return queryPressCount( *this, buttonName );
+}
+
+uint32_t InputFrame::getPressCount( Input::ActionHandle action ) const
+{
+    return queryPressCount( *this, action.index );
+}
+
+uint32_t InputFrame::getPressCount( Key key ) const noexcept
+{
+    return queryPressCount( *this, InputBits::keyBit( key ) );
+}
+
+uint32_t InputFrame::getPressCount( Button button ) const noexcept
+{
+    return queryPressCount( *this, InputBits::mouseBit( button ) );
+}
+
+uint32_t InputFrame::getPressCount( Gamepad::Button button, int playerIndex ) const noexcept
+{
+    if ( playerIndex < 0 || playerIndex >= Gamepad::MAX_PLAYER_COUNT )
+        return 0;
+
+    return queryPressCount( *this, InputBits::gamepadBit( button, playerIndex ) );
+}
+
+bool InputFrame::getKey( std::string_view keyName ) const
+{
+    const Key key = Keyboard::keyFromName( keyName );
+    return key != Key::None && getKey( key );
+}
+
+bool InputFrame::getKey( Key key ) const noexcept
+{
+    return keyboardState.lastState.isKeyDown( key );
+}
+
+bool InputFrame::getKeyDown( std::string_view keyName ) const
+{
+    const Key key = Keyboard::keyFromName( keyName );
+    return key != Key::None && getKeyDown( key );
+}
+
+bool InputFrame::getKeyDown( Key key ) const noexcept
+{
+    return testPressed( *this, InputBits::keyBit( key ) );
+}
+
+bool InputFrame::getKeyUp( std::string_view keyName ) const
+{
+    const Key key = Keyboard::keyFromName( keyName );
+    return key != Key::None && getKeyUp( key );
+}
+
+bool InputFrame::getKeyUp( Key key ) const noexcept
+{
+    return edges.released.test( InputBits::keyBit( key ) );
+}
+
+bool InputFrame::getMouseButton( Button button ) const noexcept
+{
+    return testEdge( getMouseButtonState( mouseState, button ), Edge::Down );
+}
+
+bool InputFrame::getMouseButtonDown( Button button ) const noexcept
+{
+    return testPressed( *this, InputBits::mouseBit( button ) );
+}
+
+bool InputFrame::getMouseButtonUp( Button button ) const noexcept
+{
+    return edges.released.test( InputBits::mouseBit( button ) );
+}
+
+float InputFrame::getMouseX() const noexcept
+{
+    return mouseState.getLastState().x;
+}
+
+float InputFrame::getMouseY() const noexcept
+{
+    return mouseState.getLastState().y;
+}
+
+float InputFrame::getMouseMoveX() const noexcept
+{
+    return mouseState.x;
+}
+
+float InputFrame::getMouseMoveY() const noexcept
+{
+    return mouseState.y;
+}
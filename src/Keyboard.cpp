@@ -1,4 +1,6 @@
+#include <input/EventQueue.hpp>
 #include <input/Keyboard.hpp>
+#include <input/Profiler.hpp>
 
 #include <cstring> // for std::memset
 
@@ -33,6 +35,8 @@ bool Keyboard::State::isKeyUp( Key key ) const noexcept
 
 void KeyboardStateTracker::update( const Keyboard::State& state )
 {
+    INPUT_PROFILE_SCOPE( KeyboardTrackerUpdate );
+
     auto currPtr     = reinterpret_cast<const uint32_t*>( &state );
     auto prevPtr     = reinterpret_cast<const uint32_t*>( &lastState );
     auto releasedPtr = reinterpret_cast<uint32_t*>( &released );
@@ -49,6 +53,16 @@ void KeyboardStateTracker::update( const Keyboard::State& state )
     }
 
     lastState = state;
+    edgeTimes.endFrame();
+}
+
+void KeyboardStateTracker::addEvents( std::span<const Event> events ) noexcept
+{
+    for ( const Event& event: events )
+    {
+        if ( event.type == EventType::KeyDown || event.type == EventType::KeyUp )
+            edgeTimes.add( static_cast<uint8_t>( event.key.key ), event.type == EventType::KeyDown, event.timestamp );
+    }
 }
 
 void KeyboardStateTracker::reset()
@@ -0,0 +1,273 @@
+#include <input/EventQueue.hpp>
+#include <input/LatencyProbe.hpp>
+
+#include <algorithm>
+#include <bit>
+#include <cmath>
+
+using namespace input;
+
+namespace
+{
+
+LatencyHistogram g_Histograms[static_cast<size_t>( DeviceClass::Count )][static_cast<size_t>( LatencyStage::Count )];
+
+#ifdef INPUT_ENABLE_LATENCY_PROBE
+
+struct Sample
+{
+    size_t      bit;
+    DeviceClass device;
+    bool        consumed;
+    uint64_t    timestamp;    ///< The timestamp of the event.
+    uint64_t    updateTime;   ///< The time of the Input::update that drained the event.
+    uint64_t    consumeTime;  ///< The time of the first query that observed the press.
+};
+
+Sample g_Samples[LatencyProbe::MAX_SAMPLES];
+size_t g_SampleCount = 0;
+
+void record( DeviceClass device, LatencyStage stage, uint64_t start, uint64_t end ) noexcept
+{
+    // The clocks of some backends have a coarse resolution, so the end can be slightly before the start.
+    g_Histograms[static_cast<size_t>( device )][static_cast<size_t>( stage )].add( end > start ? end - start : 0 );
+}
+
+// Get the device and the InputBits bit of an event. Returns false for events that are not recorded.
+bool classify( const Event& event, DeviceClass& device, size_t& bit, bool& press ) noexcept
+{
+    bit   = InputBits::BIT_COUNT;
+    press = false;
+
+    switch ( event.type )
+    {
+    case EventType::KeyDown:
+        bit   = InputBits::keyBit( event.key.key );
+        press = true;
+        [[fallthrough]];
+    case EventType::KeyUp:
+        device = DeviceClass::Keyboard;
+        return true;
+    case EventType::MouseButtonDown:
+        bit   = InputBits::mouseBit( event.mouseButton.button );
+        press = true;
+        [[fallthrough]];
+    case EventType::MouseButtonUp:
+    case EventType::MouseMotion:
+    case EventType::MouseWheel:
+        device = DeviceClass::Mouse;
+        return true;
+    case EventType::GamepadButtonDown:
+        if ( event.gamepadButton.player >= 0 && event.gamepadButton.player < Gamepad::MAX_PLAYER_COUNT )
+        {
+            bit   = InputBits::gamepadBit( event.gamepadButton.button, event.gamepadButton.player );
+            press = true;
+        }
+        [[fallthrough]];
+    case EventType::GamepadButtonUp:
+    case EventType::GamepadAxis:
+        device = DeviceClass::Gamepad;
+        return true;
+    case EventType::TouchDown:
+    case EventType::TouchMotion:
+    case EventType::TouchUp:
+        // Touch points are not bound to bits, so their presses are not sampled.
+        device = DeviceClass::Touch;
+        return true;
+    }
+
+    return false;
+}
+
+#endif  // INPUT_ENABLE_LATENCY_PROBE
+
+}  // namespace
+
+void LatencyHistogram::add( uint64_t value ) noexcept
+{
+    ++m_Buckets[getBucket( value )];
+    ++m_Count;
+    m_Max = std::max( m_Max, value );
+}
+
+void LatencyHistogram::reset() noexcept
+{
+    *this = {};
+}
+
+uint64_t LatencyHistogram::getPercentile( double fraction ) const noexcept
+{
+    if ( m_Count == 0 )
+        return 0;
+
+    const auto target = std::max<uint64_t>( 1, static_cast<uint64_t>( std::ceil( std::clamp( fraction, 0.0, 1.0 ) * static_cast<double>( m_Count ) ) ) );
+
+    uint64_t count = 0;
+    for ( size_t i = 0; i < BUCKET_COUNT; ++i )
+    {
+        count += m_Buckets[i];
+        if ( count >= target )
+        {
+            // The last bucket is open-ended, so use the largest value instead of its midpoint.
+            if ( i == BUCKET_COUNT - 1 )
+                return m_Max;
+
+            const uint64_t start = getBucketStart( i );
+            const uint64_t end   = getBucketStart( i + 1 );
+            return std::min( start + ( end - start ) / 2, m_Max );
+        }
+    }
+
+    return m_Max;
+}
+
+LatencyPercentiles LatencyHistogram::getPercentiles() const noexcept
+{
+    LatencyPercentiles percentiles;
+    percentiles.count = m_Count;
+    percentiles.p50   = getPercentile( 0.50 );
+    percentiles.p95   = getPercentile( 0.95 );
+    percentiles.p99   = getPercentile( 0.99 );
+    percentiles.max   = m_Max;
+
+    return percentiles;
+}
+
+size_t LatencyHistogram::getBucket( uint64_t value ) noexcept
+{
+    // Values below SUB_BUCKET_COUNT have a bucket each. Above that, each power of two has SUB_BUCKET_COUNT buckets.
+    if ( value < SUB_BUCKET_COUNT )
+        return static_cast<size_t>( value );
+
+    const size_t shift  = static_cast<size_t>( std::bit_width( value ) ) - 1 - SUB_BUCKET_BITS;
+    const size_t bucket = ( shift + 1 ) * SUB_BUCKET_COUNT + static_cast<size_t>( ( value >> shift ) & ( SUB_BUCKET_COUNT - 1 ) );
+
+    return std::min( bucket, BUCKET_COUNT - 1 );
+}
+
+uint64_t LatencyHistogram::getBucketStart( size_t bucket ) noexcept
+{
+    if ( bucket < SUB_BUCKET_COUNT )
+        return bucket;
+
+    const size_t shift = bucket / SUB_BUCKET_COUNT - 1;
+    return static_cast<uint64_t>( SUB_BUCKET_COUNT + bucket % SUB_BUCKET_COUNT ) << shift;
+}
+
+#ifdef INPUT_ENABLE_LATENCY_PROBE
+
+void LatencyProbe::stamp( Event& event ) noexcept
+{
+    event.queueTime = getEventTime();
+}
+
+void LatencyProbe::update( std::span<const Event> events ) noexcept
+{
+    // Presses that were not observed in the last frame (or were observed, but the frame was not submitted) are discarded.
+    g_SampleCount = 0;
+
+    const uint64_t now = getEventTime();
+
+    for ( const Event& event: events )
+    {
+        DeviceClass device;
+        size_t      bit;
+        bool        press;
+        if ( !classify( event, device, bit, press ) )
+            continue;
+
+        record( device, LatencyStage::Receive, event.timestamp, event.queueTime );
+        record( device, LatencyStage::Queue, event.queueTime, now );
+
+        if ( press && bit < InputBits::BIT_COUNT && g_SampleCount < MAX_SAMPLES )
+        {
+            Sample& sample     = g_Samples[g_SampleCount++];
+            sample.bit         = bit;
+            sample.device      = device;
+            sample.consumed    = false;
+            sample.timestamp   = event.timestamp;
+            sample.updateTime  = now;
+            sample.consumeTime = 0;
+        }
+    }
+}
+
+void LatencyProbe::consume( const InputBits& mask ) noexcept
+{
+    uint64_t now = 0;
+
+    for ( size_t i = 0; i < g_SampleCount; ++i )
+    {
+        Sample& sample = g_Samples[i];
+        if ( sample.consumed || !mask.test( sample.bit ) )
+            continue;
+
+        // Only read the clock if a sample was observed.
+        if ( now == 0 )
+            now = getEventTime();
+
+        sample.consumed    = true;
+        sample.consumeTime = now;
+        record( sample.device, LatencyStage::Consume, sample.updateTime, now );
+    }
+}
+
+void LatencyProbe::consume( size_t bit ) noexcept
+{
+    InputBits mask;
+    mask.set( bit );
+    consume( mask );
+}
+
+void LatencyProbe::submit() noexcept
+{
+    uint64_t now = 0;
+
+    // Remove the observed samples and keep the others until the next update.
+    size_t count = 0;
+    for ( size_t i = 0; i < g_SampleCount; ++i )
+    {
+        const Sample& sample = g_Samples[i];
+        if ( !sample.consumed )
+        {
+            g_Samples[count++] = sample;
+            continue;
+        }
+
+        if ( now == 0 )
+            now = getEventTime();
+
+        record( sample.device, LatencyStage::Submit, sample.consumeTime, now );
+        record( sample.device, LatencyStage::Total, sample.timestamp, now );
+    }
+
+    g_SampleCount = count;
+}
+
+#endif  // INPUT_ENABLE_LATENCY_PROBE
+
+LatencyStats LatencyProbe::getStats() noexcept
+{
+    LatencyStats stats;
+
+    for ( size_t device = 0; device < static_cast<size_t>( DeviceClass::Count ); ++device )
+    {
+        for ( size_t stage = 0; stage < static_cast<size_t>( LatencyStage::Count ); ++stage )
+            stats.stages[device][stage] = g_Histograms[device][stage].getPercentiles();
+    }
+
+    return stats;
+}
+
+void LatencyProbe::reset() noexcept
+{
+    for ( auto& histograms: g_Histograms )
+    {
+        for ( auto& histogram: histograms )
+            histogram.reset();
+    }
+
+#ifdef INPUT_ENABLE_LATENCY_PROBE
+    g_SampleCount = 0;
+#endif
+}
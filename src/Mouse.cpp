@@ -1,5 +1,8 @@
+#include <input/EventQueue.hpp>
 #include <input/Mouse.hpp>
+#include <input/Profiler.hpp>
 
+#include <algorithm>
 #include <cassert>
 #include <cstring>  // for memset
 
@@ -9,6 +12,8 @@ using namespace input;
 
 void MouseStateTracker::update( const Mouse::State& state ) noexcept
 {
+    INPUT_PROFILE_SCOPE( MouseTrackerUpdate );
+
     UPDATE_BUTTON_STATE( leftButton );
 
     assert( ( !state.leftButton && !lastState.leftButton ) == ( leftButton == ButtonState::Up ) );
@@ -35,11 +40,58 @@ void MouseStateTracker::update( const Mouse::State& state ) noexcept
     }
 
     lastState = state;
+    edgeTimes.endFrame();
 }
 
 #undef UPDATE_BUTTON_STATE
 
+void MouseStateTracker::addEvents( std::span<const Event> events ) noexcept
+{
+    for ( const Event& event: events )
+    {
+        if ( event.type != EventType::MouseButtonDown && event.type != EventType::MouseButtonUp )
+            continue;
+
+        const auto button = static_cast<size_t>( event.mouseButton.button );
+        if ( button >= BUTTON_COUNT )
+            continue;
+
+        edgeTimes.add( static_cast<uint32_t>( button ), event.type == EventType::MouseButtonDown, event.timestamp );
+    }
+}
+
 void MouseStateTracker::reset() noexcept
 {
     std::memset( this, 0, sizeof( MouseStateTracker ) );
 }
+
+void Mouse::MotionHistory::add( const MotionSample& sample ) noexcept
+{
+    if ( m_Count == MAX_MOTION_SAMPLES )
+    {
+        // Overwrite the oldest sample.
+        m_Ring[m_Head] = sample;
+        m_Head         = ( m_Head + 1 ) % MAX_MOTION_SAMPLES;
+        ++m_Dropped;
+    }
+    else
+    {
+        m_Ring[( m_Head + m_Count ) % MAX_MOTION_SAMPLES] = sample;
+        ++m_Count;
+    }
+}
+
+void Mouse::MotionHistory::endFrame() noexcept
+{
+    // Copy the ring buffer in two parts so that the oldest sample is first.
+    const uint32_t first = std::min<uint32_t>( m_Count, MAX_MOTION_SAMPLES - m_Head );
+    std::copy_n( m_Ring + m_Head, first, m_Frame );
+    std::copy_n( m_Ring, m_Count - first, m_Frame + first );
+
+    m_FrameCount   = m_Count;
+    m_FrameDropped = m_Dropped;
+
+    m_Head    = 0;
+    m_Count   = 0;
+    m_Dropped = 0;
+}
@@ -0,0 +1,229 @@
+#include <input/PackedGamepad.hpp>
+
+#include <algorithm>  // for std::clamp & std::min.
+#include <cassert>    // for assert.
+#include <cstddef>    // for offsetof.
+
+#if defined( __SSE2__ ) || defined( _M_X64 ) || ( defined( _M_IX86_FP ) && _M_IX86_FP >= 2 )
+    #include <emmintrin.h>
+    #define INPUT_PACKED_SSE2
+#elif defined( __aarch64__ ) || defined( _M_ARM64 )
+    #include <arm_neon.h>
+    #define INPUT_PACKED_NEON
+#endif
+
+using namespace input;
+
+namespace
+{
+
+using Packed = PackedGamepadState;
+
+// The vectorized versions load the thumbsticks and triggers directly from Gamepad::State.
+static_assert( offsetof( Gamepad::ThumbSticks, rightY ) == 3 * sizeof( float ) );
+static_assert( offsetof( Gamepad::Triggers, right ) == sizeof( float ) );
+static_assert( offsetof( Packed, rightY ) == offsetof( Packed, leftX ) + 3 * sizeof( int16_t ) );
+
+// Round a (scaled) value away from zero.
+// Rounding away from zero maps values that are greater than 0.5 to a step that is greater than 0.5.
+inline int32_t quantize( float value ) noexcept
+{
+    const auto  truncated = static_cast<int32_t>( value );
+    const float t         = static_cast<float>( truncated );
+
+    return truncated + ( value > t ) - ( value < t );
+}
+
+inline int16_t packStick( float value ) noexcept
+{
+    return static_cast<int16_t>( quantize( std::clamp( value, -1.0f, 1.0f ) * Packed::STICK_SCALE ) );
+}
+
+inline uint8_t packTrigger( float value ) noexcept
+{
+    return static_cast<uint8_t>( quantize( std::clamp( value, 0.0f, 1.0f ) * Packed::TRIGGER_SCALE ) );
+}
+
+inline uint16_t packButtons( const Gamepad::State& state ) noexcept
+{
+    return static_cast<uint16_t>( ( PackGamepadButtons( state ) & Packed::BUTTON_MASK ) | ( state.connected ? Packed::CONNECTED_FLAG : 0 ) );
+}
+
+// Unpack everything except for the thumbsticks and triggers.
+inline void unpackButtons( const Packed& packed, Gamepad::State& state ) noexcept
+{
+    state.connected = ( packed.buttons & Packed::CONNECTED_FLAG ) != 0;
+    state.packet    = packed.sequence;
+    UnpackGamepadButtons( packed.buttons & Packed::BUTTON_MASK, state );
+}
+
+#if defined( INPUT_PACKED_SSE2 )
+
+// The 10 buttons and the 4 d-pad bools are contiguous, followed by the padding before the thumbsticks.
+static_assert( offsetof( Gamepad::State, dPad ) == offsetof( Gamepad::State, buttons ) + 10 );
+static_assert( offsetof( Gamepad::State, thumbSticks ) >= offsetof( Gamepad::State, buttons ) + 16 );
+
+inline __m128i quantize( __m128 value ) noexcept
+{
+    const __m128i truncated = _mm_cvttps_epi32( value );
+    const __m128  t         = _mm_cvtepi32_ps( truncated );
+
+    // The compare masks are -1 in the lanes where the compare is true.
+    const __m128i greater = _mm_castps_si128( _mm_cmpgt_ps( value, t ) );
+    const __m128i less    = _mm_castps_si128( _mm_cmplt_ps( value, t ) );
+
+    return _mm_add_epi32( _mm_sub_epi32( truncated, greater ), less );
+}
+
+inline void pack( const Gamepad::State& state, Packed& packed ) noexcept
+{
+    // One byte per button, a set bit for each non-zero byte.
+    const __m128i  bytes = _mm_loadu_si128( reinterpret_cast<const __m128i*>( &state.buttons ) );
+    const uint32_t mask  = ~static_cast<uint32_t>( _mm_movemask_epi8( _mm_cmpeq_epi8( bytes, _mm_setzero_si128() ) ) );
+
+    // Gamepad::DPad is ordered up, down, right, left.
+    packed.buttons = static_cast<uint16_t>( ( mask & 0x0fff ) | ( mask >> 1 & 0x1000 ) | ( mask << 1 & 0x2000 ) | ( state.connected ? Packed::CONNECTED_FLAG : 0 ) );
+
+    __m128 sticks = _mm_loadu_ps( &state.thumbSticks.leftX );
+    sticks        = _mm_max_ps( _mm_min_ps( sticks, _mm_set1_ps( 1.0f ) ), _mm_set1_ps( -1.0f ) );
+    sticks        = _mm_mul_ps( sticks, _mm_set1_ps( Packed::STICK_SCALE ) );
+
+    const __m128i s = quantize( sticks );
+    _mm_storel_epi64( reinterpret_cast<__m128i*>( &packed.leftX ), _mm_packs_epi32( s, s ) );
+
+    __m128 triggers = _mm_castsi128_ps( _mm_loadl_epi64( reinterpret_cast<const __m128i*>( &state.triggers ) ) );
+    triggers        = _mm_max_ps( _mm_min_ps( triggers, _mm_set1_ps( 1.0f ) ), _mm_setzero_ps() );
+    triggers        = _mm_mul_ps( triggers, _mm_set1_ps( Packed::TRIGGER_SCALE ) );
+
+    const __m128i  t = quantize( triggers );
+    const uint32_t b = static_cast<uint32_t>( _mm_cvtsi128_si32( _mm_packus_epi16( _mm_packs_epi32( t, t ), t ) ) );
+
+    packed.leftTrigger  = static_cast<uint8_t>( b );
+    packed.rightTrigger = static_cast<uint8_t>( b >> 8 );
+    packed.sequence     = static_cast<uint32_t>( state.packet );
+}
+
+inline void unpack( const Packed& packed, Gamepad::State& state ) noexcept
+{
+    unpackButtons( packed, state );
+
+    // Sign extend the sticks to 32-bit.
+    __m128i s = _mm_loadl_epi64( reinterpret_cast<const __m128i*>( &packed.leftX ) );
+    s         = _mm_srai_epi32( _mm_unpacklo_epi16( s, s ), 16 );
+
+    _mm_storeu_ps( &state.thumbSticks.leftX, _mm_div_ps( _mm_cvtepi32_ps( s ), _mm_set1_ps( Packed::STICK_SCALE ) ) );
+
+    state.triggers.left  = static_cast<float>( packed.leftTrigger ) / Packed::TRIGGER_SCALE;
+    state.triggers.right = static_cast<float>( packed.rightTrigger ) / Packed::TRIGGER_SCALE;
+}
+
+#elif defined( INPUT_PACKED_NEON )
+
+inline int32x4_t quantize( float32x4_t value ) noexcept
+{
+    const int32x4_t   truncated = vcvtq_s32_f32( value );
+    const float32x4_t t         = vcvtq_f32_s32( truncated );
+
+    const int32x4_t greater = vreinterpretq_s32_u32( vcgtq_f32( value, t ) );
+    const int32x4_t less    = vreinterpretq_s32_u32( vcltq_f32( value, t ) );
+
+    return vaddq_s32( vsubq_s32( truncated, greater ), less );
+}
+
+inline void pack( const Gamepad::State& state, Packed& packed ) noexcept
+{
+    packed.buttons = packButtons( state );
+
+    float32x4_t sticks = vld1q_f32( &state.thumbSticks.leftX );
+    sticks             = vmaxq_f32( vminq_f32( sticks, vdupq_n_f32( 1.0f ) ), vdupq_n_f32( -1.0f ) );
+    sticks             = vmulq_n_f32( sticks, Packed::STICK_SCALE );
+
+    vst1_s16( &packed.leftX, vqmovn_s32( quantize( sticks ) ) );
+
+    // Both triggers in the low lanes.
+    float32x4_t triggers = vcombine_f32( vld1_f32( &state.triggers.left ), vdup_n_f32( 0.0f ) );
+    triggers             = vmaxq_f32( vminq_f32( triggers, vdupq_n_f32( 1.0f ) ), vdupq_n_f32( 0.0f ) );
+    triggers             = vmulq_n_f32( triggers, Packed::TRIGGER_SCALE );
+
+    const int32x4_t t = quantize( triggers );
+
+    packed.leftTrigger  = static_cast<uint8_t>( vgetq_lane_s32( t, 0 ) );
+    packed.rightTrigger = static_cast<uint8_t>( vgetq_lane_s32( t, 1 ) );
+    packed.sequence     = static_cast<uint32_t>( state.packet );
+}
+
+inline void unpack( const Packed& packed, Gamepad::State& state ) noexcept
+{
+    unpackButtons( packed, state );
+
+    const float32x4_t sticks = vcvtq_f32_s32( vmovl_s16( vld1_s16( &packed.leftX ) ) );
+    vst1q_f32( &state.thumbSticks.leftX, vdivq_f32( sticks, vdupq_n_f32( Packed::STICK_SCALE ) ) );
+
+    state.triggers.left  = static_cast<float>( packed.leftTrigger ) / Packed::TRIGGER_SCALE;
+    state.triggers.right = static_cast<float>( packed.rightTrigger ) / Packed::TRIGGER_SCALE;
+}
+
+#else
+
+inline void pack( const Gamepad::State& state, Packed& packed ) noexcept
+{
+    packed = PackGamepadState( state );
+}
+
+inline void unpack( const Packed& packed, Gamepad::State& state ) noexcept
+{
+    state = UnpackGamepadState( packed );
+}
+
+#endif
+
+}  // namespace
+
+PackedGamepadState input::PackGamepadState( const Gamepad::State& state ) noexcept
+{
+    PackedGamepadState packed;
+
+    packed.buttons      = packButtons( state );
+    packed.leftTrigger  = packTrigger( state.triggers.left );
+    packed.rightTrigger = packTrigger( state.triggers.right );
+    packed.leftX        = packStick( state.thumbSticks.leftX );
+    packed.leftY        = packStick( state.thumbSticks.leftY );
+    packed.rightX       = packStick( state.thumbSticks.rightX );
+    packed.rightY       = packStick( state.thumbSticks.rightY );
+    packed.sequence     = static_cast<uint32_t>( state.packet );
+
+    return packed;
+}
+
+Gamepad::State input::UnpackGamepadState( const PackedGamepadState& packed ) noexcept
+{
+    Gamepad::State state {};
+    unpackButtons( packed, state );
+
+    state.thumbSticks.leftX  = static_cast<float>( packed.leftX ) / Packed::STICK_SCALE;
+    state.thumbSticks.leftY  = static_cast<float>( packed.leftY ) / Packed::STICK_SCALE;
+    state.thumbSticks.rightX = static_cast<float>( packed.rightX ) / Packed::STICK_SCALE;
+    state.thumbSticks.rightY = static_cast<float>( packed.rightY ) / Packed::STICK_SCALE;
+    state.triggers.left      = static_cast<float>( packed.leftTrigger ) / Packed::TRIGGER_SCALE;
+    state.triggers.right     = static_cast<float>( packed.rightTrigger ) / Packed::TRIGGER_SCALE;
+
+    return state;
+}
+
+void input::PackGamepadStates( std::span<const Gamepad::State> states, std::span<PackedGamepadState> packed ) noexcept
+{
+    assert( packed.size() >= states.size() );
+
+    const size_t count = std::min( states.size(), packed.size() );
+    for ( size_t i = 0; i < count; ++i )
+        pack( states[i], packed[i] );
+}
+
+void input::UnpackGamepadStates( std::span<const PackedGamepadState> packed, std::span<Gamepad::State> states ) noexcept
+{
+    assert( states.size() >= packed.size() );
+
+    const size_t count = std::min( states.size(), packed.size() );
+    for ( size_t i = 0; i < count; ++i )
+        unpack( packed[i], states[i] );
+}
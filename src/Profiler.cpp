@@ -0,0 +1,182 @@
+#include <input/Profiler.hpp>
+
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <iterator>
+#include <ostream>
+
+using namespace input;
+
+namespace
+{
+
+constexpr const char* TIMER_NAMES[] = {
+    "Input::update",
+    "Keyboard::getState",
+    "Mouse::getState",
+    "Gamepad::getState",
+    "Touch::getState",
+    "KeyboardStateTracker::update",
+    "MouseStateTracker::update",
+    "GamepadStateTracker::update",
+    "TouchStateTracker::update",
+};
+
+constexpr const char* COUNTER_NAMES[] = {
+    "BuiltinActionHits",
+    "UserActionHits",
+    "ActionMisses",
+    "CallbackInvocations",
+    "MutexLocks",
+    "MutexContentions",
+    "KeyboardWatchEvents",
+    "MouseWatchEvents",
+    "GamepadWatchEvents",
+    "TouchWatchEvents",
+};
+
+static_assert( std::size( TIMER_NAMES ) == static_cast<size_t>( ProfileTimer::Count ) );
+static_assert( std::size( COUNTER_NAMES ) == static_cast<size_t>( ProfileCounter::Count ) );
+
+struct TimerData
+{
+    std::atomic<uint64_t> count { 0 };
+    std::atomic<uint64_t> totalTime { 0 };
+    std::atomic<uint64_t> maxTime { 0 };
+};
+
+struct TraceEvent
+{
+    uint64_t     start;
+    uint64_t     duration;
+    ProfileTimer timer;
+    uint32_t     thread;
+};
+
+TimerData             g_Timers[static_cast<size_t>( ProfileTimer::Count )];
+std::atomic<uint64_t> g_Counters[static_cast<size_t>( ProfileCounter::Count )];
+
+// The most recent timed scopes (a ring buffer).
+TraceEvent            g_Trace[Profiler::TRACE_CAPACITY];
+std::atomic<uint64_t> g_TraceCount { 0 };
+
+// A small ID for each thread that is shown as the track of its scopes in the trace.
+uint32_t getThreadId() noexcept
+{
+    static std::atomic<uint32_t> nextId { 1 };
+    thread_local const uint32_t  id = nextId.fetch_add( 1, std::memory_order_relaxed );
+    return id;
+}
+
+// Chrome trace timestamps are in microseconds. Write them with a fixed precision of a nanosecond.
+void writeMicroseconds( std::ostream& out, uint64_t nanoseconds )
+{
+    char buffer[32];
+    std::snprintf( buffer, sizeof( buffer ), "%llu.%03llu", static_cast<unsigned long long>( nanoseconds / 1000 ), static_cast<unsigned long long>( nanoseconds % 1000 ) );
+    out << buffer;
+}
+
+}  // namespace
+
+uint64_t Profiler::now() noexcept
+{
+    using namespace std::chrono;
+    return duration_cast<nanoseconds>( steady_clock::now().time_since_epoch() ).count();
+}
+
+void Profiler::addTime( ProfileTimer timer, uint64_t start, uint64_t end ) noexcept
+{
+    const uint64_t duration = end - start;
+
+    TimerData& data = g_Timers[static_cast<size_t>( timer )];
+    data.count.fetch_add( 1, std::memory_order_relaxed );
+    data.totalTime.fetch_add( duration, std::memory_order_relaxed );
+
+    uint64_t maxTime = data.maxTime.load( std::memory_order_relaxed );
+    while ( duration > maxTime && !data.maxTime.compare_exchange_weak( maxTime, duration, std::memory_order_relaxed ) )
+    {}
+
+    const uint64_t index = g_TraceCount.fetch_add( 1, std::memory_order_relaxed ) % TRACE_CAPACITY;
+    g_Trace[index]       = { start, duration, timer, getThreadId() };
+}
+
+void Profiler::count( ProfileCounter counter, uint64_t value ) noexcept
+{
+    g_Counters[static_cast<size_t>( counter )].fetch_add( value, std::memory_order_relaxed );
+}
+
+ProfileStats Profiler::getStats() noexcept
+{
+    ProfileStats stats;
+
+    for ( size_t i = 0; i < std::size( g_Timers ); ++i )
+    {
+        stats.timers[i].count     = g_Timers[i].count.load( std::memory_order_relaxed );
+        stats.timers[i].totalTime = g_Timers[i].totalTime.load( std::memory_order_relaxed );
+        stats.timers[i].maxTime   = g_Timers[i].maxTime.load( std::memory_order_relaxed );
+    }
+
+    for ( size_t i = 0; i < std::size( g_Counters ); ++i )
+        stats.counters[i] = g_Counters[i].load( std::memory_order_relaxed );
+
+    return stats;
+}
+
+void Profiler::writeTrace( std::ostream& out )
+{
+    const uint64_t traceCount = g_TraceCount.load( std::memory_order_relaxed );
+    const uint64_t first      = traceCount > TRACE_CAPACITY ? traceCount - TRACE_CAPACITY : 0;
+
+    out << "{\"displayTimeUnit\":\"ns\",\"traceEvents\":[";
+
+    const char* separator = "";
+    for ( uint64_t i = first; i < traceCount; ++i )
+    {
+        const TraceEvent& event = g_Trace[i % TRACE_CAPACITY];
+
+        out << separator << "{\"name\":\"" << getName( event.timer ) << "\",\"cat\":\"input\",\"ph\":\"X\",\"pid\":1,\"tid\":" << event.thread
+            << ",\"ts\":";
+        writeMicroseconds( out, event.start );
+        out << ",\"dur\":";
+        writeMicroseconds( out, event.duration );
+        out << '}';
+        separator = ",";
+    }
+
+    // The counters are written as a single sample at the time of the trace.
+    out << separator << "{\"name\":\"Counters\",\"cat\":\"input\",\"ph\":\"C\",\"pid\":1,\"tid\":0,\"ts\":";
+    writeMicroseconds( out, now() );
+    out << ",\"args\":{";
+    for ( size_t i = 0; i < std::size( g_Counters ); ++i )
+        out << ( i ? "," : "" ) << '"' << COUNTER_NAMES[i] << "\":" << g_Counters[i].load( std::memory_order_relaxed );
+
+    out << "}}]}";
+}
+
+void Profiler::reset() noexcept
+{
+    for ( auto& timer: g_Timers )
+    {
+        timer.count.store( 0, std::memory_order_relaxed );
+        timer.totalTime.store( 0, std::memory_order_relaxed );
+        timer.maxTime.store( 0, std::memory_order_relaxed );
+    }
+
+    for ( auto& counter: g_Counters )
+        counter.store( 0, std::memory_order_relaxed );
+
+    g_TraceCount.store( 0, std::memory_order_relaxed );
+}
+
+const char* Profiler::getName( ProfileTimer timer ) noexcept
+{
+    const auto index = static_cast<size_t>( timer );
+    return index < std::size( TIMER_NAMES ) ? TIMER_NAMES[index] : "";
+}
+
+const char* Profiler::getName( ProfileCounter counter ) noexcept
+{
+    const auto index = static_cast<size_t>( counter );
+    return index < std::size( COUNTER_NAMES ) ? COUNTER_NAMES[index] : "";
+}
@@ -0,0 +1,701 @@
+#include <input/Recording.hpp>
+
+#ifdef _WIN32
+    #define WIN32_LEAN_AND_MEAN
+    #include <Windows.h>
+#else
+    #include <fcntl.h>
+    #include <sys/mman.h>
+    #include <sys/stat.h>
+    #include <unistd.h>
+#endif
+
+#include <algorithm>
+#include <cstring>
+#include <utility>
+
+using namespace input;
+
+// The layout of a recording (the values are stored in the byte order of the machine, which is little-endian on all
+// supported platforms):
+//
+//   FileHeader
+//   Frame...       The frames in order.
+//   Index          uint64 count, then count (uint64 frame, uint64 offset) pairs for the keyframes.
+//
+// Each frame starts with a flags byte and the timestamp of the frame (a varint in a keyframe, the zigzag difference
+// to the previous frame otherwise). The device states of a keyframe are stored in full (STATE_SIZE bytes),
+// the device states of the other frames are stored as the runs of bytes that differ from the previous frame
+// (varint run count, then varint skip, varint length, and the bytes of each run). The touch points and the
+// events of the frame follow. The timestamp of each event is stored as the difference to the previous event
+// (the first event to the timestamp of the frame).
+
+namespace
+{
+constexpr char     MAGIC[4]             = { 'I', 'R', 'E', 'C' };
+constexpr uint32_t VERSION              = 2;
+constexpr uint8_t  KEYFRAME             = 0x01;
+constexpr size_t   KEYBOARD_SIZE        = sizeof( Keyboard::State );
+constexpr size_t   MOUSE_SIZE           = 1 + 1 + 4 + 4 + 8;
+constexpr size_t   GAMEPAD_SIZE         = 1 + 8 + 4 + 6 * 4;
+constexpr size_t   STATE_SIZE           = KEYBOARD_SIZE + MOUSE_SIZE + GAMEPAD_SIZE * Gamepad::MAX_PLAYER_COUNT;
+constexpr size_t   MIN_UNCHANGED_LENGTH = 4;  ///< Shorter unchanged runs are merged into the surrounding changed runs.
+
+struct FileHeader
+{
+    char     magic[4];
+    uint32_t version;
+    uint32_t keyframeInterval;
+    uint32_t playerCount;
+    uint64_t frameCount;
+    uint64_t indexOffset;  ///< 0 if the recording was not closed.
+};
+
+static_assert( sizeof( FileHeader ) == 32 );
+static_assert( sizeof( Keyboard::State ) == 32 );
+
+template<typename T>
+void put( std::vector<uint8_t>& out, const T& value )
+{
+    // Resize and copy instead of inserting a byte range, which GCC reports as an overflow (-Wstringop-overflow)
+    // when it is inlined for single bytes.
+    const size_t size = out.size();
+    out.resize( size + sizeof( T ) );
+    std::memcpy( out.data() + size, &value, sizeof( T ) );
+}
+
+void putVarint( std::vector<uint8_t>& out, uint64_t value )
+{
+    while ( value >= 0x80 )
+    {
+        out.push_back( static_cast<uint8_t>( value | 0x80 ) );
+        value >>= 7;
+    }
+    out.push_back( static_cast<uint8_t>( value ) );
+}
+
+// Map signed values to unsigned values so that small negative values have short varints.
+uint64_t zigZag( int64_t value ) noexcept
+{
+    return ( static_cast<uint64_t>( value ) << 1 ) ^ static_cast<uint64_t>( value >> 63 );
+}
+
+int64_t unZigZag( uint64_t value ) noexcept
+{
+    return static_cast<int64_t>( value >> 1 ) ^ -static_cast<int64_t>( value & 1 );
+}
+
+// Reads the values of an encoded frame. Reading past the end fails (and all following reads fail).
+struct Cursor
+{
+    const uint8_t* data;
+    size_t         size;
+    size_t         offset = 0;
+    bool           ok     = true;
+
+    template<typename T>
+    T get() noexcept
+    {
+        T value {};
+        if ( ok && size - offset >= sizeof( T ) )
+        {
+            std::memcpy( &value, data + offset, sizeof( T ) );
+            offset += sizeof( T );
+        }
+        else
+        {
+            ok = false;
+        }
+
+        return value;
+    }
+
+    uint64_t getVarint() noexcept
+    {
+        uint64_t value = 0;
+        for ( int shift = 0; ok && shift < 64; shift += 7 )
+        {
+            const auto byte = get<uint8_t>();
+            value |= static_cast<uint64_t>( byte & 0x7f ) << shift;
+            if ( ( byte & 0x80 ) == 0 )
+                return value;
+        }
+
+        ok = false;
+        return 0;
+    }
+
+    const uint8_t* getBytes( size_t count ) noexcept
+    {
+        if ( !ok || size - offset < count )
+        {
+            ok = false;
+            return nullptr;
+        }
+
+        const uint8_t* bytes = data + offset;
+        offset += count;
+        return bytes;
+    }
+};
+
+uint8_t packMouseButtons( const Mouse::State& state ) noexcept
+{
+    return static_cast<uint8_t>( state.leftButton | state.middleButton << 1 | state.rightButton << 2 | state.xButton1 << 3 | state.xButton2 << 4 );
+}
+
+void encodeStates( const RecordedFrame& frame, std::vector<uint8_t>& out )
+{
+    out.clear();
+    put( out, frame.keyboard );
+
+    put( out, packMouseButtons( frame.mouse ) );
+    put( out, static_cast<uint8_t>( frame.mouse.positionMode ) );
+    put( out, frame.mouse.x );
+    put( out, frame.mouse.y );
+    put( out, frame.mouse.scrollWheelValue );
+
+    for ( auto& gamepad: frame.gamepads )
+    {
+        put( out, static_cast<uint8_t>( gamepad.connected ) );
+        put( out, gamepad.packet );
+        put( out, PackGamepadButtons( gamepad ) );
+        put( out, gamepad.thumbSticks );
+        put( out, gamepad.triggers );
+    }
+}
+
+void decodeStates( const std::vector<uint8_t>& states, RecordedFrame& frame )
+{
+    Cursor cursor { states.data(), states.size() };
+
+    frame.keyboard = cursor.get<Keyboard::State>();
+
+    const auto buttons           = cursor.get<uint8_t>();
+    frame.mouse                  = {};
+    frame.mouse.leftButton       = ( buttons & 0x01 ) != 0;
+    frame.mouse.middleButton     = ( buttons & 0x02 ) != 0;
+    frame.mouse.rightButton      = ( buttons & 0x04 ) != 0;
+    frame.mouse.xButton1         = ( buttons & 0x08 ) != 0;
+    frame.mouse.xButton2         = ( buttons & 0x10 ) != 0;
+    frame.mouse.positionMode     = static_cast<Mouse::Mode>( cursor.get<uint8_t>() );
+    frame.mouse.x                = cursor.get<float>();
+    frame.mouse.y                = cursor.get<float>();
+    frame.mouse.scrollWheelValue = cursor.get<int64_t>();
+
+    for ( auto& gamepad: frame.gamepads )
+    {
+        gamepad           = {};
+        gamepad.connected = cursor.get<uint8_t>() != 0;
+        gamepad.packet    = cursor.get<uint64_t>();
+        UnpackGamepadButtons( cursor.get<uint32_t>(), gamepad );
+        gamepad.thumbSticks = cursor.get<Gamepad::ThumbSticks>();
+        gamepad.triggers    = cursor.get<Gamepad::Triggers>();
+    }
+}
+
+// Write the runs of bytes that differ from the previous states.
+void encodeDelta( const std::vector<uint8_t>& previous, const std::vector<uint8_t>& states, std::vector<uint8_t>& out )
+{
+    struct Run
+    {
+        size_t begin;
+        size_t end;
+    };
+
+    Run    runs[STATE_SIZE / 2 + 1];
+    size_t runCount = 0;
+
+    for ( size_t i = 0; i < STATE_SIZE; )
+    {
+        if ( states[i] == previous[i] )
+        {
+            ++i;
+            continue;
+        }
+
+        Run run { i, i + 1 };
+        for ( size_t j = i + 1; j < STATE_SIZE && j - run.end < MIN_UNCHANGED_LENGTH; ++j )
+        {
+            if ( states[j] != previous[j] )
+                run.end = j + 1;
+        }
+
+        runs[runCount++] = run;
+        i                = run.end;
+    }
+
+    putVarint( out, runCount );
+
+    size_t position = 0;
+    for ( size_t i = 0; i < runCount; ++i )
+    {
+        putVarint( out, runs[i].begin - position );
+        putVarint( out, runs[i].end - runs[i].begin );
+        out.insert( out.end(), states.begin() + static_cast<ptrdiff_t>( runs[i].begin ), states.begin() + static_cast<ptrdiff_t>( runs[i].end ) );
+        position = runs[i].end;
+    }
+}
+
+bool decodeDelta( Cursor& cursor, std::vector<uint8_t>& states )
+{
+    const uint64_t runCount = cursor.getVarint();
+
+    size_t position = 0;
+    for ( uint64_t i = 0; i < runCount && cursor.ok; ++i )
+    {
+        const uint64_t skip   = cursor.getVarint();
+        const uint64_t length = cursor.getVarint();
+        if ( skip > STATE_SIZE - position || length > STATE_SIZE - position - skip )
+            return false;
+
+        position += skip;
+        if ( const uint8_t* bytes = cursor.getBytes( length ) )
+            std::memcpy( states.data() + position, bytes, length );
+
+        position += length;
+    }
+
+    return cursor.ok;
+}
+
+void encodeEvent( const Event& event, uint64_t& timestamp, std::vector<uint8_t>& out )
+{
+    put( out, event.type );
+    putVarint( out, zigZag( static_cast<int64_t>( event.timestamp - timestamp ) ) );
+    timestamp = event.timestamp;
+
+    switch ( event.type )
+    {
+    case EventType::KeyDown:
+    case EventType::KeyUp:
+        put( out, event.key.key );
+        break;
+    case EventType::MouseButtonDown:
+    case EventType::MouseButtonUp:
+        put( out, event.mouseButton.button );
+        put( out, event.mouseButton.x );
+        put( out, event.mouseButton.y );
+        break;
+    case EventType::MouseMotion:
+        put( out, event.mouseMotion );
+        break;
+    case EventType::MouseWheel:
+        putVarint( out, zigZag( event.mouseWheel.delta ) );
+        break;
+    case EventType::GamepadButtonDown:
+    case EventType::GamepadButtonUp:
+        put( out, static_cast<uint8_t>( event.gamepadButton.player ) );
+        put( out, event.gamepadButton.button );
+        break;
+    case EventType::GamepadAxis:
+        put( out, static_cast<uint8_t>( event.gamepadAxis.player ) );
+        put( out, event.gamepadAxis.axis );
+        put( out, event.gamepadAxis.value );
+        break;
+    case EventType::TouchDown:
+    case EventType::TouchMotion:
+    case EventType::TouchUp:
+        putVarint( out, static_cast<uint64_t>( event.touch.id ) );
+        put( out, event.touch.x );
+        put( out, event.touch.y );
+        put( out, event.touch.pressure );
+        break;
+    }
+}
+
+Event decodeEvent( Cursor& cursor, uint64_t& timestamp )
+{
+    Event event {};
+    event.type      = cursor.get<EventType>();
+    event.timestamp = timestamp + static_cast<uint64_t>( unZigZag( cursor.getVarint() ) );
+    timestamp       = event.timestamp;
+
+    switch ( event.type )
+    {
+    case EventType::KeyDown:
+    case EventType::KeyUp:
+        event.key.key = cursor.get<Keyboard::Key>();
+        break;
+    case EventType::MouseButtonDown:
+    case EventType::MouseButtonUp:
+        event.mouseButton.button = cursor.get<Mouse::Button>();
+        event.mouseButton.x      = cursor.get<float>();
+        event.mouseButton.y      = cursor.get<float>();
+        break;
+    case EventType::MouseMotion:
+        event.mouseMotion = cursor.get<Event::MouseMotionEvent>();
+        break;
+    case EventType::MouseWheel:
+        event.mouseWheel.delta = static_cast<int32_t>( unZigZag( cursor.getVarint() ) );
+        break;
+    case EventType::GamepadButtonDown:
+    case EventType::GamepadButtonUp:
+        event.gamepadButton.player = cursor.get<uint8_t>();
+        event.gamepadButton.button = cursor.get<Gamepad::Button>();
+        break;
+    case EventType::GamepadAxis:
+        event.gamepadAxis.player = cursor.get<uint8_t>();
+        event.gamepadAxis.axis   = cursor.get<GamepadAxis>();
+        event.gamepadAxis.value  = cursor.get<float>();
+        break;
+    case EventType::TouchDown:
+    case EventType::TouchMotion:
+    case EventType::TouchUp:
+        event.touch.id       = static_cast<int64_t>( cursor.getVarint() );
+        event.touch.x        = cursor.get<float>();
+        event.touch.y        = cursor.get<float>();
+        event.touch.pressure = cursor.get<float>();
+        break;
+    default:
+        cursor.ok = false;
+        break;
+    }
+
+    // The values that index the state of the trackers must be in range.
+    switch ( event.type )
+    {
+    case EventType::MouseButtonDown:
+    case EventType::MouseButtonUp:
+        cursor.ok = cursor.ok && event.mouseButton.button <= Mouse::Button::XButton2;
+        break;
+    case EventType::GamepadButtonDown:
+    case EventType::GamepadButtonUp:
+        cursor.ok = cursor.ok && event.gamepadButton.player < Gamepad::MAX_PLAYER_COUNT && event.gamepadButton.button < Gamepad::Button::Count;
+        break;
+    case EventType::GamepadAxis:
+        cursor.ok = cursor.ok && event.gamepadAxis.player < Gamepad::MAX_PLAYER_COUNT && event.gamepadAxis.axis <= GamepadAxis::RightTrigger;
+        break;
+    default:
+        break;
+    }
+
+    return event;
+}
+}  // namespace
+
+RecordingWriter::~RecordingWriter()
+{
+    close();
+}
+
+bool RecordingWriter::open( const std::string& path, uint32_t keyframeInterval )
+{
+    close();
+
+    m_File.open( path, std::ios::binary | std::ios::trunc );
+    if ( !m_File )
+        return false;
+
+    FileHeader header {};
+    std::memcpy( header.magic, MAGIC, sizeof( MAGIC ) );
+    header.version          = VERSION;
+    header.keyframeInterval = std::max( keyframeInterval, 1u );
+    header.playerCount      = Gamepad::MAX_PLAYER_COUNT;
+    m_File.write( reinterpret_cast<const char*>( &header ), sizeof( header ) );
+
+    m_KeyframeInterval = header.keyframeInterval;
+    m_FrameCount       = 0;
+    m_Offset           = sizeof( header );
+    m_Timestamp        = 0;
+    m_States.assign( STATE_SIZE, 0 );
+    m_Index.clear();
+
+    return static_cast<bool>( m_File );
+}
+
+void RecordingWriter::close()
+{
+    if ( !m_File.is_open() )
+        return;
+
+    m_Buffer.clear();
+    put( m_Buffer, static_cast<uint64_t>( m_Index.size() ) );
+    for ( auto& keyframe: m_Index )
+    {
+        put( m_Buffer, keyframe.frame );
+        put( m_Buffer, keyframe.offset );
+    }
+    m_File.write( reinterpret_cast<const char*>( m_Buffer.data() ), static_cast<std::streamsize>( m_Buffer.size() ) );
+
+    // Complete the header.
+    const uint64_t indexOffset = m_Offset;
+    m_File.seekp( offsetof( FileHeader, frameCount ) );
+    m_File.write( reinterpret_cast<const char*>( &m_FrameCount ), sizeof( m_FrameCount ) );
+    m_File.write( reinterpret_cast<const char*>( &indexOffset ), sizeof( indexOffset ) );
+
+    m_File.close();
+}
+
+void RecordingWriter::write( const RecordedFrame& frame )
+{
+    if ( !m_File.is_open() )
+        return;
+
+    encodeStates( frame, m_NextStates );
+
+    const bool keyframe = m_FrameCount % m_KeyframeInterval == 0;
+
+    m_Buffer.clear();
+    put( m_Buffer, keyframe ? KEYFRAME : uint8_t { 0 } );
+    putVarint( m_Buffer, keyframe ? frame.timestamp : zigZag( static_cast<int64_t>( frame.timestamp - m_Timestamp ) ) );
+    m_Timestamp = frame.timestamp;
+
+    if ( keyframe )
+    {
+        m_Index.push_back( { m_FrameCount, m_Offset } );
+        m_Buffer.insert( m_Buffer.end(), m_NextStates.begin(), m_NextStates.end() );
+    }
+    else
+    {
+        encodeDelta( m_States, m_NextStates, m_Buffer );
+    }
+
+    std::swap( m_States, m_NextStates );
+
+    put( m_Buffer, static_cast<uint8_t>( frame.touch.touches.size() ) );
+    for ( auto& touch: frame.touch.touches )
+    {
+        putVarint( m_Buffer, touch.id );
+        putVarint( m_Buffer, touch.timestamp );
+        put( m_Buffer, touch.x );
+        put( m_Buffer, touch.y );
+        put( m_Buffer, touch.pressure );
+        put( m_Buffer, touch.phase );
+    }
+
+    uint64_t timestamp = frame.timestamp;
+    putVarint( m_Buffer, frame.events.size() );
+    for ( auto& event: frame.events )
+        encodeEvent( event, timestamp, m_Buffer );
+
+    m_File.write( reinterpret_cast<const char*>( m_Buffer.data() ), static_cast<std::streamsize>( m_Buffer.size() ) );
+    m_Offset += m_Buffer.size();
+    ++m_FrameCount;
+}
+
+RecordingReader::~RecordingReader()
+{
+    close();
+}
+
+bool RecordingReader::open( const std::string& path )
+{
+    close();
+
+#ifdef _WIN32
+    HANDLE file = CreateFileA( path.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, nullptr );
+    if ( file == INVALID_HANDLE_VALUE )
+        return false;
+
+    LARGE_INTEGER size {};
+    HANDLE        mapping = nullptr;
+    if ( GetFileSizeEx( file, &size ) && size.QuadPart >= static_cast<LONGLONG>( sizeof( FileHeader ) ) )
+        mapping = CreateFileMappingA( file, nullptr, PAGE_READONLY, 0, 0, nullptr );
+    CloseHandle( file );
+
+    if ( !mapping )
+        return false;
+
+    m_Data = static_cast<const uint8_t*>( MapViewOfFile( mapping, FILE_MAP_READ, 0, 0, 0 ) );
+    if ( !m_Data )
+    {
+        CloseHandle( mapping );
+        return false;
+    }
+
+    m_Mapping = mapping;
+    m_Size    = static_cast<size_t>( size.QuadPart );
+#else
+    const int fd = ::open( path.c_str(), O_RDONLY | O_CLOEXEC );
+    if ( fd < 0 )
+        return false;
+
+    struct stat status {};
+    void*       data = MAP_FAILED;
+    if ( fstat( fd, &status ) == 0 && status.st_size >= static_cast<off_t>( sizeof( FileHeader ) ) )
+        data = mmap( nullptr, static_cast<size_t>( status.st_size ), PROT_READ, MAP_PRIVATE, fd, 0 );
+    ::close( fd );
+
+    if ( data == MAP_FAILED )
+        return false;
+
+    m_Data = static_cast<const uint8_t*>( data );
+    m_Size = static_cast<size_t>( status.st_size );
+#endif
+
+    FileHeader header;
+    std::memcpy( &header, m_Data, sizeof( header ) );
+
+    if ( std::memcmp( header.magic, MAGIC, sizeof( MAGIC ) ) != 0 || header.version != VERSION || header.playerCount != Gamepad::MAX_PLAYER_COUNT )
+    {
+        close();
+        return false;
+    }
+
+    // Use the index of the file, unless the recording was not closed (or the index is damaged).
+    bool validIndex = false;
+    if ( header.indexOffset >= sizeof( header ) && header.indexOffset < m_Size )
+    {
+        Cursor cursor { m_Data, m_Size, header.indexOffset };
+
+        const auto count = cursor.get<uint64_t>();
+        for ( uint64_t i = 0; i < count && cursor.ok; ++i )
+        {
+            const auto frame  = cursor.get<uint64_t>();
+            const auto offset = cursor.get<uint64_t>();
+            if ( offset < sizeof( header ) || offset >= header.indexOffset || ( !m_Index.empty() && frame <= m_Index.back().frame ) )
+                cursor.ok = false;
+            else
+                m_Index.push_back( { frame, offset } );
+        }
+
+        m_FrameCount = header.frameCount;
+        validIndex   = cursor.ok && ( m_Index.empty() ? m_FrameCount == 0 : m_Index.front().frame == 0 && m_Index.back().frame < m_FrameCount );
+    }
+
+    if ( !validIndex && !buildIndex() )
+    {
+        close();
+        return false;
+    }
+
+    m_States.assign( STATE_SIZE, 0 );
+    m_NextFrame = 0;
+    m_Offset    = sizeof( header );
+
+    return true;
+}
+
+void RecordingReader::close()
+{
+    if ( m_Data )
+    {
+#ifdef _WIN32
+        UnmapViewOfFile( m_Data );
+        CloseHandle( static_cast<HANDLE>( m_Mapping ) );
+#else
+        munmap( const_cast<uint8_t*>( m_Data ), m_Size );
+#endif
+    }
+
+    m_Data       = nullptr;
+    m_Size       = 0;
+    m_Mapping    = nullptr;
+    m_FrameCount = 0;
+    m_NextFrame  = 0;
+    m_Offset     = 0;
+    m_Index.clear();
+}
+
+bool RecordingReader::read( uint64_t index, RecordedFrame& frame )
+{
+    if ( !m_Data || index >= m_FrameCount )
+        return false;
+
+    if ( index != m_NextFrame )
+    {
+        // Start at the last keyframe before the frame, unless the frames up to it can be decoded from here.
+        auto keyframe = std::ranges::upper_bound( m_Index, index, {}, &Keyframe::frame ) - 1;
+        if ( index < m_NextFrame || keyframe->frame > m_NextFrame )
+        {
+            m_NextFrame = keyframe->frame;
+            m_Offset    = static_cast<size_t>( keyframe->offset );
+        }
+
+        RecordedFrame skipped;
+        while ( m_NextFrame < index )
+        {
+            if ( !decode( skipped ) )
+                return false;
+        }
+    }
+
+    return decode( frame );
+}
+
+bool RecordingReader::decode( RecordedFrame& frame )
+{
+    Cursor cursor { m_Data, m_Size, m_Offset };
+
+    const auto flags = cursor.get<uint8_t>();
+    m_Timestamp      = flags & KEYFRAME ? cursor.getVarint() : m_Timestamp + static_cast<uint64_t>( unZigZag( cursor.getVarint() ) );
+    frame.timestamp  = m_Timestamp;
+
+    if ( flags & KEYFRAME )
+    {
+        if ( const uint8_t* states = cursor.getBytes( STATE_SIZE ) )
+            std::memcpy( m_States.data(), states, STATE_SIZE );
+    }
+    else if ( !decodeDelta( cursor, m_States ) )
+    {
+        m_NextFrame = m_FrameCount;
+        return false;
+    }
+
+    decodeStates( m_States, frame );
+
+    const auto touchCount = cursor.get<uint8_t>();
+    frame.touch           = {};
+    for ( uint8_t i = 0; i < touchCount && cursor.ok; ++i )
+    {
+        Touch::TouchPoint touch {};
+        touch.id        = cursor.getVarint();
+        touch.timestamp = cursor.getVarint();
+        touch.x         = cursor.get<float>();
+        touch.y         = cursor.get<float>();
+        touch.pressure  = cursor.get<float>();
+        touch.phase     = cursor.get<Touch::Phase>();
+        cursor.ok       = cursor.ok && touch.phase <= Touch::Phase::Cancelled;
+        frame.touch.touches.push_back( touch );
+    }
+
+    const uint64_t eventCount = cursor.getVarint();
+    frame.events.clear();
+    uint64_t timestamp = frame.timestamp;
+    for ( uint64_t i = 0; i < eventCount && cursor.ok; ++i )
+        frame.events.push_back( decodeEvent( cursor, timestamp ) );
+
+    if ( !cursor.ok )
+    {
+        // The states may be partially decoded, so the next read starts at a keyframe.
+        m_NextFrame = m_FrameCount;
+        return false;
+    }
+
+    m_Offset = cursor.offset;
+    ++m_NextFrame;
+
+    return true;
+}
+
+bool RecordingReader::buildIndex()
+{
+    m_Index.clear();
+    m_States.assign( STATE_SIZE, 0 );
+    m_NextFrame = 0;
+    m_Offset    = sizeof( FileHeader );
+
+    // Decode the frames until the end of the file (the last frame may be incomplete).
+    RecordedFrame frame;
+    uint64_t      frameCount = 0;
+    while ( m_Offset < m_Size )
+    {
+        const size_t offset   = m_Offset;
+        const bool   keyframe = ( m_Data[offset] & KEYFRAME ) != 0;
+        if ( frameCount == 0 && !keyframe )
+            return false;
+
+        if ( !decode( frame ) )
+            break;
+
+        if ( keyframe )
+            m_Index.push_back( { frameCount, offset } );
+
+        ++frameCount;
+    }
+
+    m_FrameCount = frameCount;
+
+    return true;
+}
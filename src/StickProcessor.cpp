@@ -0,0 +1,510 @@
+#include <input/StickProcessor.hpp>
+
+#include <algorithm>  // for std::min, std::max & std::any_of.
+#include <cassert>    // for assert.
+#include <cmath>      // for std::abs, std::copysign, std::pow, std::sqrt & std::trunc.
+#include <iterator>   // for std::begin & std::end.
+
+#if defined( __SSE2__ ) || defined( _M_X64 ) || ( defined( _M_IX86_FP ) && _M_IX86_FP >= 2 )
+    #include <emmintrin.h>
+    #define INPUT_STICKS_SSE2
+#elif defined( __aarch64__ ) || defined( _M_ARM64 )
+    #include <arm_neon.h>
+    #define INPUT_STICKS_NEON
+#endif
+
+using namespace input;
+
+namespace
+{
+
+using DeadZone = Gamepad::DeadZone;
+
+constexpr float SEGMENTS = static_cast<float>( ResponseCurve::SEGMENT_COUNT );
+
+constexpr bool isAxial( DeadZone deadZoneMode ) noexcept
+{
+    return deadZoneMode == DeadZone::IndependentAxis || deadZoneMode == DeadZone::None;
+}
+
+// Apply the response curve to the result of the dead zone.
+void applyResponseCurve( const StickSettings& settings, float& x, float& y ) noexcept
+{
+    const ResponseCurve& curve = settings.responseCurve;
+
+    if ( curve.isLinear() )
+        return;
+
+    if ( isAxial( settings.deadZoneMode ) )
+    {
+        x = std::copysign( curve.evaluate( std::abs( x ) ), x );
+        y = std::copysign( curve.evaluate( std::abs( y ) ), y );
+    }
+    else
+    {
+        const float length = std::sqrt( x * x + y * y );
+        const float scale  = ( length > 0.f ) ? ( curve.evaluate( length ) / length ) : 0.f;
+
+        x = std::max( -1.f, std::min( x * scale, 1.f ) );
+        y = std::max( -1.f, std::min( y * scale, 1.f ) );
+    }
+}
+
+#if defined( INPUT_STICKS_SSE2 )
+
+constexpr size_t LANES = 4;
+
+using Float = __m128;
+using Mask  = __m128;
+
+inline Float load( const float* p ) noexcept
+{
+    return _mm_load_ps( p );
+}
+
+inline Mask loadMask( const uint32_t* p ) noexcept
+{
+    return _mm_castsi128_ps( _mm_load_si128( reinterpret_cast<const __m128i*>( p ) ) );
+}
+
+inline void store( float* p, Float v ) noexcept
+{
+    _mm_store_ps( p, v );
+}
+
+inline Float splat( float value ) noexcept
+{
+    return _mm_set1_ps( value );
+}
+
+inline Float add( Float a, Float b ) noexcept
+{
+    return _mm_add_ps( a, b );
+}
+
+inline Float sub( Float a, Float b ) noexcept
+{
+    return _mm_sub_ps( a, b );
+}
+
+inline Float mul( Float a, Float b ) noexcept
+{
+    return _mm_mul_ps( a, b );
+}
+
+inline Float divide( Float a, Float b ) noexcept
+{
+    return _mm_div_ps( a, b );
+}
+
+inline Float minimum( Float a, Float b ) noexcept
+{
+    return _mm_min_ps( a, b );
+}
+
+inline Float maximum( Float a, Float b ) noexcept
+{
+    return _mm_max_ps( a, b );
+}
+
+inline Float squareRoot( Float v ) noexcept
+{
+    return _mm_sqrt_ps( v );
+}
+
+inline Float absolute( Float v ) noexcept
+{
+    return _mm_andnot_ps( _mm_set1_ps( -0.0f ), v );
+}
+
+// The magnitude of the first argument with the sign of the second argument.
+inline Float copySign( Float magnitude, Float sign ) noexcept
+{
+    const __m128 signBit = _mm_set1_ps( -0.0f );
+    return _mm_or_ps( _mm_andnot_ps( signBit, magnitude ), _mm_and_ps( signBit, sign ) );
+}
+
+inline Mask greater( Float a, Float b ) noexcept
+{
+    return _mm_cmpgt_ps( a, b );
+}
+
+// a where the mask is set, b otherwise.
+inline Float select( Mask mask, Float a, Float b ) noexcept
+{
+    return _mm_or_ps( _mm_and_ps( mask, a ), _mm_andnot_ps( mask, b ) );
+}
+
+inline Float truncate( Float v ) noexcept
+{
+    return _mm_cvtepi32_ps( _mm_cvttps_epi32( v ) );
+}
+
+inline void storeIndices( int32_t* p, Float v ) noexcept
+{
+    _mm_store_si128( reinterpret_cast<__m128i*>( p ), _mm_cvttps_epi32( v ) );
+}
+
+#elif defined( INPUT_STICKS_NEON )
+
+constexpr size_t LANES = 4;
+
+using Float = float32x4_t;
+using Mask  = uint32x4_t;
+
+inline Float load( const float* p ) noexcept
+{
+    return vld1q_f32( p );
+}
+
+inline Mask loadMask( const uint32_t* p ) noexcept
+{
+    return vld1q_u32( p );
+}
+
+inline void store( float* p, Float v ) noexcept
+{
+    vst1q_f32( p, v );
+}
+
+inline Float splat( float value ) noexcept
+{
+    return vdupq_n_f32( value );
+}
+
+inline Float add( Float a, Float b ) noexcept
+{
+    return vaddq_f32( a, b );
+}
+
+inline Float sub( Float a, Float b ) noexcept
+{
+    return vsubq_f32( a, b );
+}
+
+inline Float mul( Float a, Float b ) noexcept
+{
+    return vmulq_f32( a, b );
+}
+
+inline Float divide( Float a, Float b ) noexcept
+{
+    return vdivq_f32( a, b );
+}
+
+inline Float minimum( Float a, Float b ) noexcept
+{
+    return vminq_f32( a, b );
+}
+
+inline Float maximum( Float a, Float b ) noexcept
+{
+    return vmaxq_f32( a, b );
+}
+
+inline Float squareRoot( Float v ) noexcept
+{
+    return vsqrtq_f32( v );
+}
+
+inline Float absolute( Float v ) noexcept
+{
+    return vabsq_f32( v );
+}
+
+inline Float copySign( Float magnitude, Float sign ) noexcept
+{
+    return vbslq_f32( vdupq_n_u32( 0x80000000u ), sign, magnitude );
+}
+
+inline Mask greater( Float a, Float b ) noexcept
+{
+    return vcgtq_f32( a, b );
+}
+
+inline Float select( Mask mask, Float a, Float b ) noexcept
+{
+    return vbslq_f32( mask, a, b );
+}
+
+inline Float truncate( Float v ) noexcept
+{
+    return vcvtq_f32_s32( vcvtq_s32_f32( v ) );
+}
+
+inline void storeIndices( int32_t* p, Float v ) noexcept
+{
+    vst1q_s32( p, vcvtq_s32_f32( v ) );
+}
+
+#endif
+
+#if defined( INPUT_STICKS_SSE2 ) || defined( INPUT_STICKS_NEON )
+
+inline Float clamp( Float v ) noexcept
+{
+    return maximum( minimum( v, splat( 1.f ) ), splat( -1.f ) );
+}
+
+// Vectorized ApplyLinearDeadZone.
+inline Float linearDeadZone( Float value, Float maxValue, Float deadZoneSize ) noexcept
+{
+    const Float magnitude = absolute( value );
+    const Float scaled    = minimum( divide( sub( magnitude, deadZoneSize ), sub( maxValue, deadZoneSize ) ), splat( 1.f ) );
+
+    return select( greater( magnitude, deadZoneSize ), copySign( scaled, value ), splat( 0.f ) );
+}
+
+// Vectorized ResponseCurve::evaluate with a different curve in each lane.
+inline Float evaluateCurves( Float value, const ResponseCurve* const ( &curves )[LANES] ) noexcept
+{
+    const Float p = mul( minimum( maximum( value, splat( 0.f ) ), splat( 1.f ) ), splat( SEGMENTS ) );
+    const Float i = minimum( truncate( p ), splat( SEGMENTS - 1.f ) );
+    const Float f = sub( p, i );
+
+    alignas( 16 ) int32_t index[LANES];
+    alignas( 16 ) float   a[LANES];
+    alignas( 16 ) float   b[LANES];
+
+    storeIndices( index, i );
+    for ( size_t k = 0; k < LANES; ++k )
+    {
+        const auto& points = curves[k]->getPoints();
+
+        a[k] = points[index[k]];
+        b[k] = points[index[k] + 1];
+    }
+
+    const Float pointA = load( a );
+    const Float pointB = load( b );
+
+    return add( pointA, mul( sub( pointB, pointA ), f ) );
+}
+
+#endif
+
+}  // namespace
+
+ResponseCurve::ResponseCurve() noexcept
+{
+    for ( size_t i = 0; i <= SEGMENT_COUNT; ++i )
+        m_Points[i] = static_cast<float>( i ) / SEGMENTS;
+}
+
+ResponseCurve ResponseCurve::linear() noexcept
+{
+    return {};
+}
+
+ResponseCurve ResponseCurve::exponential( float exponent ) noexcept
+{
+    ResponseCurve curve;
+
+    if ( exponent != 1.0f )
+    {
+        for ( size_t i = 0; i <= SEGMENT_COUNT; ++i )
+            curve.m_Points[i] = std::pow( static_cast<float>( i ) / SEGMENTS, exponent );
+
+        curve.m_Linear = false;
+    }
+
+    return curve;
+}
+
+ResponseCurve ResponseCurve::table( std::span<const float> points ) noexcept
+{
+    ResponseCurve curve;
+
+    if ( points.size() >= 2 )
+    {
+        // Resample the points to the segments of the lookup table.
+        const float last = static_cast<float>( points.size() - 1 );
+        for ( size_t i = 0; i <= SEGMENT_COUNT; ++i )
+        {
+            const float  t = static_cast<float>( i ) / SEGMENTS * last;
+            const size_t j = std::min( static_cast<size_t>( t ), points.size() - 2 );
+            const float  f = t - static_cast<float>( j );
+
+            curve.m_Points[i] = points[j] + ( points[j + 1] - points[j] ) * f;
+        }
+
+        curve.m_Linear = false;
+    }
+
+    return curve;
+}
+
+float ResponseCurve::evaluate( float value ) const noexcept
+{
+    value = std::min( std::max( value, 0.f ), 1.f );
+
+    if ( m_Linear )
+        return value;
+
+    const float p = value * SEGMENTS;
+    const float i = std::min( std::trunc( p ), SEGMENTS - 1.f );
+    const float f = p - i;
+
+    const auto index = static_cast<size_t>( i );
+    return m_Points[index] + ( m_Points[index + 1] - m_Points[index] ) * f;
+}
+
+void input::ApplyStickSettings( const StickSettings& settings, float x, float y, float& resultX, float& resultY ) noexcept
+{
+    ApplyStickDeadZone( x, y, settings.deadZoneMode, settings.outerDeadZone, settings.innerDeadZone, resultX, resultY );
+    applyResponseCurve( settings, resultX, resultY );
+}
+
+StickProcessor::StickProcessor() noexcept
+{
+    for ( int i = 0; i < Gamepad::MAX_PLAYER_COUNT; ++i )
+        updateLanes( i );
+}
+
+void StickProcessor::setSettings( int playerIndex, const StickSettings& settings ) noexcept
+{
+    assert( playerIndex >= -1 && playerIndex < Gamepad::MAX_PLAYER_COUNT );
+
+    for ( int i = 0; i < Gamepad::MAX_PLAYER_COUNT; ++i )
+    {
+        if ( playerIndex < 0 || playerIndex == i )
+        {
+            m_Settings[i] = settings;
+            updateLanes( i );
+        }
+    }
+
+    m_Curved = std::any_of( std::begin( m_Settings ), std::end( m_Settings ), []( const StickSettings& s ) {
+        return !s.responseCurve.isLinear();
+    } );
+}
+
+const StickSettings& StickProcessor::getSettings( int playerIndex ) const noexcept
+{
+    assert( playerIndex >= 0 && playerIndex < Gamepad::MAX_PLAYER_COUNT );
+
+    return m_Settings[playerIndex];
+}
+
+void StickProcessor::updateLanes( int playerIndex ) noexcept
+{
+    const StickSettings& settings = m_Settings[playerIndex];
+    const DeadZone       mode     = settings.deadZoneMode;
+
+    for ( size_t stick = 0; stick < 2; ++stick )
+    {
+        const size_t lane = playerIndex * 2 + stick;
+
+        // ApplyStickDeadZone ignores the dead zone size in the None mode.
+        m_Lanes.innerDeadZone[lane] = mode == DeadZone::None ? 0.f : settings.innerDeadZone;
+        m_Lanes.outerDeadZone[lane] = settings.outerDeadZone;
+        m_Lanes.axial[lane]         = isAxial( mode ) ? ~0u : 0u;
+        m_Lanes.radial[lane]        = mode == DeadZone::Radial ? ~0u : 0u;
+        m_Lanes.hybrid[lane]        = mode == DeadZone::Hybrid ? ~0u : 0u;
+        m_Lanes.curved[lane]        = settings.responseCurve.isLinear() ? 0u : ~0u;
+    }
+}
+
+void StickProcessor::process( std::span<Gamepad::State> states ) const noexcept
+{
+    const size_t playerCount = std::min( states.size(), static_cast<size_t>( Gamepad::MAX_PLAYER_COUNT ) );
+
+    // Gather the sticks of all players.
+    alignas( 16 ) float xs[STICK_COUNT] {};
+    alignas( 16 ) float ys[STICK_COUNT] {};
+
+    for ( size_t i = 0; i < playerCount; ++i )
+    {
+        const Gamepad::ThumbSticks& sticks = states[i].thumbSticks;
+
+        xs[i * 2]     = sticks.leftX;
+        ys[i * 2]     = sticks.leftY;
+        xs[i * 2 + 1] = sticks.rightX;
+        ys[i * 2 + 1] = sticks.rightY;
+    }
+
+#if defined( INPUT_STICKS_SSE2 ) || defined( INPUT_STICKS_NEON )
+    static_assert( STICK_COUNT % LANES == 0 );
+
+    const Float zero = splat( 0.f );
+    const Float one  = splat( 1.f );
+
+    // Every dead zone mode is computed for every stick, then the result of the mode of each stick is selected.
+    for ( size_t i = 0; i < playerCount * 2; i += LANES )
+    {
+        const Float x     = load( &xs[i] );
+        const Float y     = load( &ys[i] );
+        const Float inner = load( &m_Lanes.innerDeadZone[i] );
+        const Float outer = load( &m_Lanes.outerDeadZone[i] );
+
+        // IndependentAxis and None.
+        const Float axialX = linearDeadZone( x, outer, inner );
+        const Float axialY = linearDeadZone( y, outer, inner );
+
+        // Circular (scaled radial).
+        const Float length    = squareRoot( add( mul( x, x ), mul( y, y ) ) );
+        const Float wanted    = linearDeadZone( length, outer, inner );
+        const Float scale     = select( greater( wanted, zero ), divide( wanted, length ), zero );
+        const Float circularX = clamp( mul( x, scale ) );
+        const Float circularY = clamp( mul( y, scale ) );
+
+        // Radial.
+        const Float radialScale = select( greater( length, inner ), divide( one, maximum( length, outer ) ), zero );
+        const Float radialX     = clamp( mul( x, radialScale ) );
+        const Float radialY     = clamp( mul( y, radialScale ) );
+
+        // Hybrid.
+        const Float hybridX = linearDeadZone( circularX, one, mul( inner, absolute( circularY ) ) );
+        const Float hybridY = linearDeadZone( circularY, one, mul( inner, absolute( circularX ) ) );
+
+        const Mask axial  = loadMask( &m_Lanes.axial[i] );
+        const Mask radial = loadMask( &m_Lanes.radial[i] );
+        const Mask hybrid = loadMask( &m_Lanes.hybrid[i] );
+
+        Float resultX = select( axial, axialX, select( radial, radialX, select( hybrid, hybridX, circularX ) ) );
+        Float resultY = select( axial, axialY, select( radial, radialY, select( hybrid, hybridY, circularY ) ) );
+
+        if ( m_Curved )
+        {
+            static_assert( LANES == 4 );
+            const ResponseCurve* const curves[LANES] = {
+                &m_Settings[i / 2].responseCurve,
+                &m_Settings[( i + 1 ) / 2].responseCurve,
+                &m_Settings[( i + 2 ) / 2].responseCurve,
+                &m_Settings[( i + 3 ) / 2].responseCurve,
+            };
+
+            // The axial modes apply the curve to each axis, the radial modes to the length of the stick.
+            const Float resultLength = squareRoot( add( mul( resultX, resultX ), mul( resultY, resultY ) ) );
+            const Float curveX       = evaluateCurves( select( axial, absolute( resultX ), resultLength ), curves );
+            const Float curveY       = evaluateCurves( absolute( resultY ), curves );
+            const Float curveScale   = select( greater( resultLength, zero ), divide( curveX, resultLength ), zero );
+
+            const Float curvedX = select( axial, copySign( curveX, resultX ), clamp( mul( resultX, curveScale ) ) );
+            const Float curvedY = select( axial, copySign( curveY, resultY ), clamp( mul( resultY, curveScale ) ) );
+
+            const Mask curved = loadMask( &m_Lanes.curved[i] );
+
+            resultX = select( curved, curvedX, resultX );
+            resultY = select( curved, curvedY, resultY );
+        }
+
+        store( &xs[i], resultX );
+        store( &ys[i], resultY );
+    }
+#else
+    for ( size_t i = 0; i < playerCount * 2; ++i )
+        ApplyStickSettings( m_Settings[i / 2], xs[i], ys[i], xs[i], ys[i] );
+#endif
+
+    // Scatter the processed sticks.
+    for ( size_t i = 0; i < playerCount; ++i )
+    {
+        Gamepad::ThumbSticks& sticks = states[i].thumbSticks;
+
+        sticks.leftX  = xs[i * 2];
+        sticks.leftY  = ys[i * 2];
+        sticks.rightX = xs[i * 2 + 1];
+        sticks.rightY = ys[i * 2 + 1];
+    }
+}
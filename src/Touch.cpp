@@ -1,13 +1,49 @@
+#include <input/Profiler.hpp>
 #include <input/Touch.hpp>
 
-#include <algorithm>
-
 using namespace input;
 
+namespace
+{
+
+// A bit for each slot of Touch::State::touches.
+static_assert( Touch::MAX_TOUCH_COUNT <= 32 );
+
+// Find the slot of a touch, starting at the hint. Returns touches.size() if the touch is not found.
+// The backends add new touches at the end and remove touches without changing the order of the
+// other touches, so the touch is usually found at the hint (the slot after the previous match).
+size_t findTouch( const Touch::TouchList& touches, uint64_t id, size_t hint ) noexcept
+{
+    const size_t count = touches.size();
+
+    for ( size_t i = hint; i < count; ++i )
+    {
+        if ( touches[i].id == id )
+            return i;
+    }
+
+    for ( size_t i = 0; i < hint && i < count; ++i )
+    {
+        if ( touches[i].id == id )
+            return i;
+    }
+
+    return count;
+}
+
+}  // namespace
+
 void TouchStateTracker::update( const Touch::State& state ) noexcept
 {
+    INPUT_PROFILE_SCOPE( TouchTrackerUpdate );
+
     trackedTouches.clear();
 
+    const Touch::TouchList& lastTouches = lastState.touches;
+
+    uint32_t matched = 0;  // The slots of the last touches that are still active.
+    size_t   hint    = 0;
+
     // Process current touches
     for ( const auto& touch : state.touches )
     {
@@ -18,14 +54,18 @@ void TouchStateTracker::update( const Touch::State& state ) noexcept
         tracked.pressure = touch.pressure;
 
         // Find matching touch in last state
-        auto lastTouch = std::find_if( lastState.touches.begin(), lastState.touches.end(),
-                                       [&]( const Touch::TouchPoint& t ) { return t.id == touch.id; } );
+        const size_t slot = findTouch( lastTouches, touch.id, hint );
 
-        if ( lastTouch != lastState.touches.end() )
+        if ( slot < lastTouches.size() )
         {
             // Touch existed in last frame
-            tracked.deltaX = touch.x - lastTouch->x;
-            tracked.deltaY = touch.y - lastTouch->y;
+            const auto& lastTouch = lastTouches[slot];
+
+            matched |= 1u << slot;
+            hint = slot + 1;
+
+            tracked.deltaX = touch.x - lastTouch.x;
+            tracked.deltaY = touch.y - lastTouch.y;
 
             // Determine button state based on phase
             switch ( touch.phase )
@@ -54,25 +94,24 @@ void TouchStateTracker::update( const Touch::State& state ) noexcept
         trackedTouches.push_back( tracked );
     }
 
-    // Check for touches that ended (were in last state but not in current)
-    for ( const auto& lastTouch : lastState.touches )
+    // Touches that ended (were in last state but not in current)
+    for ( size_t slot = 0; slot < lastTouches.size(); ++slot )
     {
-        auto currentTouch = std::find_if( state.touches.begin(), state.touches.end(),
-                                          [&]( const Touch::TouchPoint& t ) { return t.id == lastTouch.id; } );
+        if ( matched & ( 1u << slot ) )
+            continue;
 
-        if ( currentTouch == state.touches.end() )
-        {
-            // Touch ended - add as released
-            TrackedTouch tracked;
-            tracked.id       = lastTouch.id;
-            tracked.x        = lastTouch.x;
-            tracked.y        = lastTouch.y;
-            tracked.pressure = 0.0f;
-            tracked.deltaX   = 0.0f;
-            tracked.deltaY   = 0.0f;
-            tracked.state    = ButtonState::Released;
-            trackedTouches.push_back( tracked );
-        }
+        // Touch ended - add as released
+        const auto& lastTouch = lastTouches[slot];
+
+        TrackedTouch tracked;
+        tracked.id       = lastTouch.id;
+        tracked.x        = lastTouch.x;
+        tracked.y        = lastTouch.y;
+        tracked.pressure = 0.0f;
+        tracked.deltaX   = 0.0f;
+        tracked.deltaY   = 0.0f;
+        tracked.state    = ButtonState::Released;
+        trackedTouches.push_back( tracked );
     }
 
     lastState = state;
@@ -0,0 +1,289 @@
+#include <input/TouchRegionMap.hpp>
+
+#include <algorithm>
+#include <bit>
+
+using namespace input;
+
+namespace
+{
+
+constexpr uint64_t bit( uint32_t region ) noexcept
+{
+    return uint64_t { 1 } << ( region % 64 );
+}
+
+}  // namespace
+
+uint32_t TouchRegionMap::addRegion( std::string_view name, const TouchRect& rect )
+{
+    if ( const uint32_t region = findRegion( name ); region != INVALID_REGION )
+    {
+        setRect( region, rect );
+        return region;
+    }
+
+    if ( m_Regions.size() >= MAX_REGION_COUNT )
+        return INVALID_REGION;
+
+    const auto region = static_cast<uint32_t>( m_Regions.size() );
+
+    m_Regions.push_back( { rect } );
+    m_Names.emplace_back( name );
+    updateGrid( region );
+
+    return region;
+}
+
+void TouchRegionMap::setRect( uint32_t region, const TouchRect& rect ) noexcept
+{
+    if ( region >= m_Regions.size() )
+        return;
+
+    m_Regions[region].rect = rect;
+    updateGrid( region );
+}
+
+void TouchRegionMap::setEnabled( uint32_t region, bool enabled ) noexcept
+{
+    if ( region < m_Regions.size() )
+        m_Regions[region].enabled = enabled;
+}
+
+uint32_t TouchRegionMap::findRegion( std::string_view name ) const noexcept
+{
+    const auto it = std::ranges::find( m_Names, name );
+    return it != m_Names.end() ? static_cast<uint32_t>( it - m_Names.begin() ) : INVALID_REGION;
+}
+
+std::string_view TouchRegionMap::getName( uint32_t region ) const noexcept
+{
+    return region < m_Names.size() ? std::string_view { m_Names[region] } : std::string_view {};
+}
+
+TouchRect TouchRegionMap::getRect( uint32_t region ) const noexcept
+{
+    return region < m_Regions.size() ? m_Regions[region].rect : TouchRect {};
+}
+
+bool TouchRegionMap::isEnabled( uint32_t region ) const noexcept
+{
+    return region < m_Regions.size() && m_Regions[region].enabled;
+}
+
+uint32_t TouchRegionMap::hitTest( float x, float y ) const noexcept
+{
+    const uint64_t* regions = m_Grid[cell( y ) * GRID_SIZE + cell( x )];
+
+    // Regions that were added later are on top, so search from the highest bit.
+    for ( size_t word = WORD_COUNT; word-- > 0; )
+    {
+        uint64_t bits = regions[word];
+        while ( bits )
+        {
+            const auto    region = static_cast<uint32_t>( word * 64 + 63 - std::countl_zero( bits ) );
+            const Region& r      = m_Regions[region];
+
+            if ( r.enabled && r.rect.contains( x, y ) )
+                return region;
+
+            bits &= ~bit( region );
+        }
+    }
+
+    return INVALID_REGION;
+}
+
+void TouchRegionMap::update( const TouchStateTracker& touches ) noexcept
+{
+    std::ranges::fill( m_Entered, 0 );
+
+    // The fingers that are reported by the tracker this frame.
+    uint32_t seen = 0;
+
+    for ( const auto& touch: touches.getTrackedTouches() )
+    {
+        Finger* finger = findFinger( touch.id );
+
+        if ( touch.state == ButtonState::Released )
+        {
+            if ( finger )
+                finger->active = false;
+
+            continue;
+        }
+
+        if ( touch.state == ButtonState::Up )
+            continue;
+
+        if ( !finger )
+        {
+            // A new touch point captures the region under it.
+            finger = findFreeFinger();
+            if ( !finger )
+                continue;
+
+            const uint32_t region = hitTest( touch.x, touch.y );
+
+            finger->id       = touch.id;
+            finger->x        = touch.x;
+            finger->y        = touch.y;
+            finger->captured = region;
+            finger->hovered  = region;
+            finger->active   = true;
+        }
+        else if ( touch.x != finger->x || touch.y != finger->y )
+        {
+            finger->x = touch.x;
+            finger->y = touch.y;
+
+            const uint32_t region = hitTest( touch.x, touch.y );
+            if ( region != finger->hovered && region != INVALID_REGION && region != finger->captured )
+                m_Entered[region / 64] |= bit( region );
+
+            finger->hovered = region;
+        }
+
+        seen |= 1u << ( finger - m_Fingers );
+    }
+
+    // Release fingers that are no longer tracked (for example, if the tracker was reset).
+    for ( uint32_t i = 0; i < Touch::MAX_TOUCH_COUNT; ++i )
+    {
+        if ( !( seen & ( 1u << i ) ) )
+            m_Fingers[i].active = false;
+    }
+
+    uint64_t down[WORD_COUNT] {};
+    for ( const Finger& finger: m_Fingers )
+    {
+        if ( finger.active && finger.captured != INVALID_REGION )
+            down[finger.captured / 64] |= bit( finger.captured );
+    }
+
+    for ( size_t i = 0; i < WORD_COUNT; ++i )
+    {
+        m_Pressed[i]  = down[i] & ~m_Down[i];
+        m_Released[i] = ~down[i] & m_Down[i];
+        m_Down[i]     = down[i];
+    }
+}
+
+void TouchRegionMap::reset() noexcept
+{
+    for ( Finger& finger: m_Fingers )
+        finger.active = false;
+
+    std::ranges::fill( m_Down, 0 );
+    std::ranges::fill( m_Pressed, 0 );
+    std::ranges::fill( m_Released, 0 );
+    std::ranges::fill( m_Entered, 0 );
+}
+
+ButtonState TouchRegionMap::getState( uint32_t region ) const noexcept
+{
+    if ( region >= MAX_REGION_COUNT )
+        return ButtonState::Up;
+
+    const size_t   word = region / 64;
+    const uint64_t mask = bit( region );
+
+    if ( m_Pressed[word] & mask )
+        return ButtonState::Pressed;
+    if ( m_Released[word] & mask )
+        return ButtonState::Released;
+    if ( m_Down[word] & mask )
+        return ButtonState::Held;
+
+    return ButtonState::Up;
+}
+
+bool TouchRegionMap::isEntered( uint32_t region ) const noexcept
+{
+    return region < MAX_REGION_COUNT && ( m_Entered[region / 64] & bit( region ) ) != 0;
+}
+
+bool TouchRegionMap::getTouchPosition( uint32_t region, float& x, float& y ) const noexcept
+{
+    const Finger* finger = findCapture( region );
+    if ( !finger )
+        return false;
+
+    x = finger->x;
+    y = finger->y;
+
+    return true;
+}
+
+int64_t TouchRegionMap::getTouchId( uint32_t region ) const noexcept
+{
+    const Finger* finger = findCapture( region );
+    return finger ? finger->id : -1;
+}
+
+TouchRegionMap::Finger* TouchRegionMap::findFinger( int64_t id ) noexcept
+{
+    for ( Finger& finger: m_Fingers )
+    {
+        if ( finger.active && finger.id == id )
+            return &finger;
+    }
+
+    return nullptr;
+}
+
+TouchRegionMap::Finger* TouchRegionMap::findFreeFinger() noexcept
+{
+    for ( Finger& finger: m_Fingers )
+    {
+        if ( !finger.active )
+            return &finger;
+    }
+
+    return nullptr;
+}
+
+const TouchRegionMap::Finger* TouchRegionMap::findCapture( uint32_t region ) const noexcept
+{
+    if ( region == INVALID_REGION )
+        return nullptr;
+
+    for ( const Finger& finger: m_Fingers )
+    {
+        if ( finger.active && finger.captured == region )
+            return &finger;
+    }
+
+    return nullptr;
+}
+
+void TouchRegionMap::updateGrid( uint32_t region ) noexcept
+{
+    const size_t   word = region / 64;
+    const uint64_t mask = bit( region );
+
+    for ( auto& regions: m_Grid )
+        regions[word] &= ~mask;
+
+    const TouchRect& rect = m_Regions[region].rect;
+    if ( !( rect.left < rect.right && rect.top < rect.bottom ) )
+        return;
+
+    const size_t left   = cell( rect.left );
+    const size_t right  = cell( rect.right );
+    const size_t top    = cell( rect.top );
+    const size_t bottom = cell( rect.bottom );
+
+    for ( size_t y = top; y <= bottom; ++y )
+    {
+        for ( size_t x = left; x <= right; ++x )
+            m_Grid[y * GRID_SIZE + x][word] |= mask;
+    }
+}
+
+size_t TouchRegionMap::cell( float value ) noexcept
+{
+    // Points outside of the touch surface use the cells at the edges.
+    const float c = value * static_cast<float>( GRID_SIZE );
+    return c > 0.0f ? std::min( static_cast<size_t>( c ), GRID_SIZE - 1 ) : 0;
+}
@@ -0,0 +1,183 @@
+#include <input/TouchRegionMap.hpp>
+#include <input/VirtualGamepad.hpp>
+
+#include <algorithm>
+#include <cmath>
+
+using namespace input;
+
+namespace
+{
+
+using Pad = Gamepad::Button;
+
+constexpr uint32_t bit( Pad button ) noexcept
+{
+    return 1u << static_cast<uint32_t>( button );
+}
+
+bool isDown( const TouchRegionMap& regions, uint32_t region ) noexcept
+{
+    const ButtonState state = regions.getState( region );
+    return state == ButtonState::Pressed || state == ButtonState::Held;
+}
+
+// Emulate a threshold button by fully deflecting an axis.
+void applyThreshold( uint32_t buttons, Pad negative, Pad positive, float& axis ) noexcept
+{
+    if ( buttons & bit( positive ) )
+        axis = 1.0f;
+    else if ( buttons & bit( negative ) )
+        axis = -1.0f;
+}
+
+}  // namespace
+
+VirtualGamepad::VirtualGamepad() noexcept
+{
+    clear();
+}
+
+void VirtualGamepad::setPlayerIndex( int playerIndex ) noexcept
+{
+    m_PlayerIndex = playerIndex >= 0 && playerIndex < Gamepad::MAX_PLAYER_COUNT ? playerIndex : -1;
+}
+
+void VirtualGamepad::setStick( Stick stick, const VirtualStick& settings ) noexcept
+{
+    StickState& s = m_Sticks[static_cast<size_t>( stick )];
+    s.settings    = settings;
+    s.active      = false;
+}
+
+const VirtualGamepad::VirtualStick& VirtualGamepad::getStick( Stick stick ) const noexcept
+{
+    return m_Sticks[static_cast<size_t>( stick )].settings;
+}
+
+void VirtualGamepad::setButton( Gamepad::Button button, uint32_t region ) noexcept
+{
+    if ( button < Gamepad::Button::Count )
+        m_Buttons[static_cast<size_t>( button )] = region;
+}
+
+uint32_t VirtualGamepad::getButton( Gamepad::Button button ) const noexcept
+{
+    return button < Gamepad::Button::Count ? m_Buttons[static_cast<size_t>( button )] : INVALID_REGION;
+}
+
+void VirtualGamepad::clear() noexcept
+{
+    for ( StickState& stick: m_Sticks )
+        stick = {};
+
+    std::ranges::fill( m_Buttons, INVALID_REGION );
+}
+
+void VirtualGamepad::update( const TouchRegionMap& regions ) noexcept
+{
+    const uint64_t packet = m_State.packet;
+
+    m_State           = {};
+    m_State.connected = true;
+    m_State.packet    = packet + 1;
+
+    uint32_t buttons = 0;
+    for ( size_t i = 0; i < std::size( m_Buttons ); ++i )
+    {
+        if ( m_Buttons[i] != INVALID_REGION && isDown( regions, m_Buttons[i] ) )
+            buttons |= 1u << i;
+    }
+
+    UnpackGamepadButtons( buttons, m_State );
+
+    Gamepad::ThumbSticks& sticks = m_State.thumbSticks;
+    updateStick( m_Sticks[0], regions, sticks.leftX, sticks.leftY );
+    updateStick( m_Sticks[1], regions, sticks.rightX, sticks.rightY );
+
+    applyThreshold( buttons, Pad::LeftStickLeft, Pad::LeftStickRight, sticks.leftX );
+    applyThreshold( buttons, Pad::LeftStickDown, Pad::LeftStickUp, sticks.leftY );
+    applyThreshold( buttons, Pad::RightStickLeft, Pad::RightStickRight, sticks.rightX );
+    applyThreshold( buttons, Pad::RightStickDown, Pad::RightStickUp, sticks.rightY );
+
+    m_State.triggers.left  = buttons & bit( Pad::LeftTrigger ) ? 1.0f : 0.0f;
+    m_State.triggers.right = buttons & bit( Pad::RightTrigger ) ? 1.0f : 0.0f;
+}
+
+void VirtualGamepad::apply( std::span<Gamepad::State> states ) const noexcept
+{
+    if ( m_PlayerIndex < 0 || static_cast<size_t>( m_PlayerIndex ) >= states.size() )
+        return;
+
+    Gamepad::State& state = states[m_PlayerIndex];
+
+    if ( !state.connected )
+    {
+        state = m_State;
+        return;
+    }
+
+    UnpackGamepadButtons( PackGamepadButtons( state ) | PackGamepadButtons( m_State ), state );
+
+    const Gamepad::ThumbSticks& sticks = m_State.thumbSticks;
+    if ( sticks.leftX != 0.0f || sticks.leftY != 0.0f )
+    {
+        state.thumbSticks.leftX = sticks.leftX;
+        state.thumbSticks.leftY = sticks.leftY;
+    }
+    if ( sticks.rightX != 0.0f || sticks.rightY != 0.0f )
+    {
+        state.thumbSticks.rightX = sticks.rightX;
+        state.thumbSticks.rightY = sticks.rightY;
+    }
+
+    state.triggers.left  = std::max( state.triggers.left, m_State.triggers.left );
+    state.triggers.right = std::max( state.triggers.right, m_State.triggers.right );
+}
+
+void VirtualGamepad::updateStick( StickState& stick, const TouchRegionMap& regions, float& x, float& y ) noexcept
+{
+    const VirtualStick& settings = stick.settings;
+
+    float touchX, touchY;
+    if ( settings.region == INVALID_REGION || !regions.getTouchPosition( settings.region, touchX, touchY ) )
+    {
+        stick.active = false;
+        return;
+    }
+
+    if ( !stick.active )
+    {
+        if ( settings.mode == StickMode::Floating )
+        {
+            stick.centerX = touchX;
+            stick.centerY = touchY;
+        }
+        else
+        {
+            const TouchRect rect = regions.getRect( settings.region );
+            stick.centerX        = ( rect.left + rect.right ) * 0.5f;
+            stick.centerY        = ( rect.top + rect.bottom ) * 0.5f;
+        }
+
+        stick.active = true;
+    }
+
+    if ( settings.radius <= 0.0f )
+        return;
+
+    // Touch coordinates grow downwards, thumbsticks grow upwards.
+    const float dx       = ( touchX - stick.centerX ) / settings.radius;
+    const float dy       = ( stick.centerY - touchY ) / settings.radius;
+    const float distance = std::sqrt( dx * dx + dy * dy );
+
+    if ( distance <= settings.deadZone || distance == 0.0f )
+        return;
+
+    // Rescale the range outside of the dead zone to [0...1].
+    const float deadZone = std::clamp( settings.deadZone, 0.0f, 0.99f );
+    const float scale    = ( std::min( distance, 1.0f ) - deadZone ) / ( 1.0f - deadZone ) / distance;
+
+    x = dx * scale;
+    y = dy * scale;
+}
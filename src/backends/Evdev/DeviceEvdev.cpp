@@ -0,0 +1,592 @@
+#include <input/EventQueue.hpp>
+#include <input/Evdev.hpp>
+#include <input/Profiler.hpp>
+
+#include <dirent.h>
+#include <fcntl.h>
+#include <sys/epoll.h>
+#include <sys/eventfd.h>
+#include <sys/inotify.h>
+#include <sys/ioctl.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <atomic>
+#include <cerrno>
+#include <climits>
+#include <cstring>
+#include <ctime>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+using namespace input;
+
+namespace
+{
+// The epoll user data of the wake-up eventfd and the inotify descriptor (the device identifiers are non-negative).
+constexpr uint64_t WAKE_KEY    = ~0ull;
+constexpr uint64_t INOTIFY_KEY = ~0ull - 1;
+
+constexpr size_t BITS_PER_LONG = sizeof( unsigned long ) * CHAR_BIT;
+
+// A bit array in the layout of the EVIOCGBIT and EVIOCGKEY ioctls.
+template<size_t Count>
+using BitArray = std::array<unsigned long, ( Count + BITS_PER_LONG - 1 ) / BITS_PER_LONG>;
+
+template<size_t Count>
+bool testBit( const BitArray<Count>& bits, unsigned int bit ) noexcept
+{
+    return ( bits[bit / BITS_PER_LONG] >> ( bit % BITS_PER_LONG ) & 1 ) != 0;
+}
+
+template<size_t Count>
+void setBit( BitArray<Count>& bits, unsigned int bit, bool value ) noexcept
+{
+    const unsigned long mask = 1ul << ( bit % BITS_PER_LONG );
+    bits[bit / BITS_PER_LONG] = value ? bits[bit / BITS_PER_LONG] | mask : bits[bit / BITS_PER_LONG] & ~mask;
+}
+
+bool isDeviceNode( const char* name ) noexcept
+{
+    return std::strncmp( name, "event", 5 ) == 0;
+}
+}  // namespace
+
+class DeviceEvdev
+{
+public:
+    static DeviceEvdev& get()
+    {
+        static DeviceEvdev instance;
+        return instance;
+    }
+
+    // Open the devices of the default directory, unless a directory was already set with setDirectory.
+    void start()
+    {
+        std::scoped_lock lock( m_Mutex );
+
+        if ( !m_Started )
+            openDirectory();
+    }
+
+    int add( int fd, const Evdev::DeviceInfo& info )
+    {
+        std::scoped_lock lock( m_Mutex );
+        return addDevice( fd, info, {} );
+    }
+
+    void remove( int device )
+    {
+        std::scoped_lock lock( m_Mutex );
+        removeDevice( device );
+    }
+
+    void setDirectory( std::string_view directory )
+    {
+        std::scoped_lock lock( m_Mutex );
+
+        closeDirectory();
+        m_Directory = directory;
+        openDirectory();
+    }
+
+    DeviceEvdev( const DeviceEvdev& )            = delete;
+    DeviceEvdev( DeviceEvdev&& )                 = delete;
+    DeviceEvdev& operator=( const DeviceEvdev& ) = delete;
+    DeviceEvdev& operator=( DeviceEvdev&& )      = delete;
+
+private:
+    struct Device
+    {
+        int                              id;
+        int                              fd;
+        std::string                      path;         ///< Empty if the device was added with Evdev::addDevice.
+        Evdev::DeviceInfo                info;
+        std::vector<input_event>         frame;        ///< The events since the last SYN_REPORT.
+        BitArray<KEY_CNT>                keys {};      ///< The reported key states (to resynchronize after SYN_DROPPED).
+        std::array<int32_t, ABS_MT_SLOT> abs {};       ///< The reported values of the single-touch absolute axes.
+        input_event                      partial {};   ///< An incomplete record of a stream.
+        size_t                           partialSize = 0;
+        bool                             dropped     = false;  ///< The kernel buffer overflowed, skip to the next SYN_REPORT.
+        bool                             needsSync   = true;   ///< Query the current state on the reader thread.
+    };
+
+    DeviceEvdev()
+    {
+        // Construct the device singletons first, so that they are destroyed after the reader thread is stopped.
+        Evdev::detail::disconnectKeyboard( -1 );
+        Evdev::detail::disconnectMouse( -1 );
+        Evdev::detail::disconnectGamepad( -1 );
+        Evdev::detail::disconnectTouch( -1 );
+
+        m_Epoll   = epoll_create1( EPOLL_CLOEXEC );
+        m_Wake    = eventfd( 0, EFD_NONBLOCK | EFD_CLOEXEC );
+        m_Inotify = inotify_init1( IN_NONBLOCK | IN_CLOEXEC );
+
+        watch( m_Wake, WAKE_KEY );
+        watch( m_Inotify, INOTIFY_KEY );
+
+        m_Thread = std::thread( [this] { run(); } );
+    }
+
+    ~DeviceEvdev()
+    {
+        m_Stop = true;
+        wake();
+        m_Thread.join();
+
+        for ( auto& device: m_Devices )
+            close( device.fd );
+
+        close( m_Inotify );
+        close( m_Wake );
+        close( m_Epoll );
+    }
+
+    bool watch( int fd, uint64_t key ) const noexcept
+    {
+        epoll_event event {};
+        event.events   = EPOLLIN;
+        event.data.u64 = key;
+
+        return epoll_ctl( m_Epoll, EPOLL_CTL_ADD, fd, &event ) == 0;
+    }
+
+    void wake() const noexcept
+    {
+        const uint64_t value = 1;
+        [[maybe_unused]] auto result = write( m_Wake, &value, sizeof( value ) );
+    }
+
+    void run()
+    {
+        std::array<epoll_event, 16> ready {};
+
+        while ( !m_Stop )
+        {
+            const int count = epoll_wait( m_Epoll, ready.data(), static_cast<int>( ready.size() ), -1 );
+            if ( count < 0 )
+            {
+                if ( errno == EINTR )
+                    continue;
+
+                return;
+            }
+
+            std::scoped_lock lock( m_Mutex );
+
+            for ( int i = 0; i < count; ++i )
+            {
+                const uint64_t key = ready[i].data.u64;
+                if ( key == WAKE_KEY )
+                {
+                    uint64_t value;
+                    [[maybe_unused]] auto result = read( m_Wake, &value, sizeof( value ) );
+                }
+                else if ( key == INOTIFY_KEY )
+                {
+                    readNotifications();
+                }
+                else
+                {
+                    readDevice( static_cast<int>( key ) );
+                }
+            }
+
+            // The devices that were added since the last wake-up report their current state from this thread,
+            // because the events must be pushed by a single producer.
+            for ( auto& device: m_Devices )
+            {
+                if ( device.needsSync )
+                {
+                    input_event report {};
+                    report.type = EV_SYN;
+                    report.code = SYN_REPORT;
+                    setTime( report, getEventTime() );
+                    synchronize( device, report );
+                }
+            }
+        }
+    }
+
+    static void setTime( input_event& event, uint64_t time ) noexcept
+    {
+        event.input_event_sec  = static_cast<decltype( event.input_event_sec )>( time / 1'000'000'000 );
+        event.input_event_usec = static_cast<decltype( event.input_event_usec )>( time % 1'000'000'000 / 1'000 );
+    }
+
+    Device* findDevice( int id ) noexcept
+    {
+        auto it = std::ranges::find_if( m_Devices, [id]( const Device& d ) { return d.id == id; } );
+        return it != m_Devices.end() ? &*it : nullptr;
+    }
+
+    int addDevice( int fd, const Evdev::DeviceInfo& info, std::string path )
+    {
+        const int flags = fcntl( fd, F_GETFL );
+        if ( flags < 0 || fcntl( fd, F_SETFL, flags | O_NONBLOCK ) < 0 || !watch( fd, static_cast<uint64_t>( m_NextId ) ) )
+        {
+            close( fd );
+            return -1;
+        }
+
+        Device& device = m_Devices.emplace_back();
+        device.id      = m_NextId++;
+        device.fd      = fd;
+        device.path    = std::move( path );
+        device.info    = info;
+        device.abs.fill( INT32_MIN );  // Report the initial value of every axis.
+
+        if ( info.keyboard )
+            Evdev::detail::connectKeyboard( device.id );
+        if ( info.mouse )
+            Evdev::detail::connectMouse( device.id );
+        if ( info.gamepad )
+            Evdev::detail::connectGamepad( device.id, fd, info );
+        if ( info.touch )
+            Evdev::detail::connectTouch( device.id, fd, info );
+
+        wake();
+
+        return device.id;
+    }
+
+    void removeDevice( int id )
+    {
+        auto it = std::ranges::find_if( m_Devices, [id]( const Device& d ) { return d.id == id; } );
+        if ( it == m_Devices.end() )
+            return;
+
+        epoll_ctl( m_Epoll, EPOLL_CTL_DEL, it->fd, nullptr );
+
+        if ( it->info.keyboard )
+            Evdev::detail::disconnectKeyboard( id );
+        if ( it->info.mouse )
+            Evdev::detail::disconnectMouse( id );
+        if ( it->info.gamepad )
+            Evdev::detail::disconnectGamepad( id );
+        if ( it->info.touch )
+            Evdev::detail::disconnectTouch( id );
+
+        close( it->fd );
+        m_Devices.erase( it );
+    }
+
+    void openDevice( const std::string& path )
+    {
+        if ( std::ranges::any_of( m_Devices, [&]( const Device& d ) { return d.path == path; } ) )
+            return;
+
+        // Gamepads must be writable for the force feedback.
+        int fd = open( path.c_str(), O_RDWR | O_NONBLOCK | O_CLOEXEC );
+        if ( fd < 0 )
+            fd = open( path.c_str(), O_RDONLY | O_NONBLOCK | O_CLOEXEC );
+        if ( fd < 0 )
+            return;
+
+        Evdev::DeviceInfo info;
+        if ( !Evdev::queryDevice( fd, info ) || !( info.keyboard || info.mouse || info.gamepad || info.touch ) )
+        {
+            close( fd );
+            return;
+        }
+
+        // Use the clock of getEventTime for the timestamps (the default is CLOCK_REALTIME).
+        int clock = CLOCK_MONOTONIC;
+        ioctl( fd, EVIOCSCLOCKID, &clock );
+
+        addDevice( fd, info, path );
+    }
+
+    void openDirectory()
+    {
+        m_Started = true;
+
+        if ( m_Directory.empty() )
+            return;
+
+        m_Watch = inotify_add_watch( m_Inotify, m_Directory.c_str(), IN_CREATE | IN_ATTRIB | IN_DELETE );
+
+        if ( DIR* dir = opendir( m_Directory.c_str() ) )
+        {
+            while ( const dirent* entry = readdir( dir ) )
+            {
+                if ( isDeviceNode( entry->d_name ) )
+                    openDevice( m_Directory + '/' + entry->d_name );
+            }
+
+            closedir( dir );
+        }
+    }
+
+    void closeDirectory()
+    {
+        if ( m_Watch >= 0 )
+        {
+            inotify_rm_watch( m_Inotify, m_Watch );
+            m_Watch = -1;
+        }
+
+        std::vector<int> ids;
+        for ( auto& device: m_Devices )
+        {
+            if ( !device.path.empty() )
+                ids.push_back( device.id );
+        }
+
+        for ( int id: ids )
+            removeDevice( id );
+    }
+
+    void readNotifications()
+    {
+        alignas( inotify_event ) char buffer[4096];
+
+        ssize_t size;
+        while ( ( size = read( m_Inotify, buffer, sizeof( buffer ) ) ) > 0 )
+        {
+            for ( ssize_t offset = 0; offset < size; )
+            {
+                const auto* event = reinterpret_cast<const inotify_event*>( buffer + offset );
+                offset += static_cast<ssize_t>( sizeof( inotify_event ) + event->len );
+
+                if ( event->wd != m_Watch || event->len == 0 || !isDeviceNode( event->name ) )
+                    continue;
+
+                const std::string path = m_Directory + '/' + event->name;
+                if ( event->mask & IN_DELETE )
+                {
+                    auto it = std::ranges::find_if( m_Devices, [&]( const Device& d ) { return d.path == path; } );
+                    if ( it != m_Devices.end() )
+                        removeDevice( it->id );
+                }
+                else
+                {
+                    // The permissions of a new node are set after it is created (IN_ATTRIB), so both are tried.
+                    openDevice( path );
+                }
+            }
+        }
+    }
+
+    void readDevice( int id )
+    {
+        Device* device = findDevice( id );
+        if ( !device )
+            return;
+
+        std::array<input_event, 64> buffer;
+        auto*                       bytes = reinterpret_cast<char*>( buffer.data() );
+
+        for ( ;; )
+        {
+            // A stream (such as a pipe) can split a record, the rest is read with the next records.
+            std::memcpy( bytes, &device->partial, device->partialSize );
+
+            const ssize_t size = read( device->fd, bytes + device->partialSize, sizeof( buffer ) - device->partialSize );
+            if ( size < 0 && ( errno == EAGAIN || errno == EINTR ) )
+                return;
+
+            if ( size <= 0 )
+            {
+                // The end of the stream, or the device was unplugged (ENODEV).
+                removeDevice( id );
+                return;
+            }
+
+            const size_t total = device->partialSize + static_cast<size_t>( size );
+            const size_t count = total / sizeof( input_event );
+
+            device->partialSize = total % sizeof( input_event );
+            std::memcpy( &device->partial, bytes + count * sizeof( input_event ), device->partialSize );
+
+            for ( size_t i = 0; i < count; ++i )
+                process( *device, buffer[i] );
+        }
+    }
+
+    void process( Device& device, const input_event& event )
+    {
+        if ( event.type == EV_SYN && event.code == SYN_DROPPED )
+        {
+            device.dropped = true;
+            device.frame.clear();
+        }
+        else if ( event.type == EV_SYN && event.code == SYN_REPORT )
+        {
+            if ( device.dropped )
+            {
+                device.dropped = false;
+                synchronize( device, event );
+            }
+            else
+            {
+                device.frame.push_back( event );
+                dispatch( device );
+            }
+        }
+        else if ( !device.dropped )
+        {
+            device.frame.push_back( event );
+        }
+    }
+
+    // Report the events of a frame (ending with SYN_REPORT) to the devices.
+    void dispatch( Device& device )
+    {
+        for ( const auto& event: device.frame )
+        {
+            if ( event.type == EV_KEY && event.code < KEY_CNT && event.value != 2 )
+                setBit<KEY_CNT>( device.keys, event.code, event.value != 0 );
+            else if ( event.type == EV_ABS && event.code < ABS_MT_SLOT )
+                device.abs[event.code] = event.value;
+        }
+
+        const std::span<const input_event> events( device.frame );
+
+        if ( device.info.keyboard )
+            Evdev::detail::applyKeyboardEvents( device.id, events );
+        if ( device.info.mouse )
+            Evdev::detail::applyMouseEvents( device.id, events );
+        if ( device.info.gamepad )
+            Evdev::detail::applyGamepadEvents( device.id, events );
+        if ( device.info.touch )
+            Evdev::detail::applyTouchEvents( device.id, events );
+
+        device.frame.clear();
+    }
+
+    // Query the current key and axis states of a device node and report the changes as a single frame.
+    // The multi-touch slots are not queried: the contacts are updated with their next events.
+    void synchronize( Device& device, const input_event& report )
+    {
+        device.needsSync = false;
+        device.frame.clear();
+
+        BitArray<KEY_CNT> keys {};
+        if ( ioctl( device.fd, EVIOCGKEY( sizeof( keys ) ), keys.data() ) < 0 )
+            return;  // Not a device node (for example, a pipe), so the state cannot be queried.
+
+        input_event event = report;
+        event.type        = EV_KEY;
+
+        for ( unsigned int code = 0; code < KEY_CNT; ++code )
+        {
+            if ( testBit<KEY_CNT>( keys, code ) != testBit<KEY_CNT>( device.keys, code ) )
+            {
+                event.code  = static_cast<uint16_t>( code );
+                event.value = testBit<KEY_CNT>( keys, code ) ? 1 : 0;
+                device.frame.push_back( event );
+            }
+        }
+
+        event.type = EV_ABS;
+
+        for ( unsigned int axis = 0; axis < ABS_MT_SLOT; ++axis )
+        {
+            const Evdev::AbsRange& range = device.info.absRanges[axis];
+            input_absinfo          info {};
+
+            if ( range.minimum != range.maximum && ioctl( device.fd, EVIOCGABS( axis ), &info ) == 0 && info.value != device.abs[axis] )
+            {
+                event.code  = static_cast<uint16_t>( axis );
+                event.value = info.value;
+                device.frame.push_back( event );
+            }
+        }
+
+        device.frame.push_back( report );
+        dispatch( device );
+    }
+
+    int                 m_Epoll   = -1;
+    int                 m_Wake    = -1;
+    int                 m_Inotify = -1;
+    int                 m_Watch   = -1;
+    int                 m_NextId  = 0;
+    bool                m_Started = false;
+    std::atomic<bool>   m_Stop { false };
+    std::string         m_Directory = "/dev/input";
+    std::vector<Device> m_Devices;
+    std::thread         m_Thread;
+    mutable Mutex       m_Mutex;
+};
+
+bool Evdev::queryDevice( int fd, DeviceInfo& info )
+{
+    int version = 0;
+    if ( ioctl( fd, EVIOCGVERSION, &version ) < 0 )
+        return false;
+
+    char name[256] = {};
+    ioctl( fd, EVIOCGNAME( sizeof( name ) - 1 ), name );
+
+    BitArray<KEY_CNT>        keys {};
+    BitArray<REL_CNT>        rel {};
+    BitArray<ABS_CNT>        abs {};
+    BitArray<INPUT_PROP_CNT> properties {};
+
+    ioctl( fd, EVIOCGBIT( EV_KEY, sizeof( keys ) ), keys.data() );
+    ioctl( fd, EVIOCGBIT( EV_REL, sizeof( rel ) ), rel.data() );
+    ioctl( fd, EVIOCGBIT( EV_ABS, sizeof( abs ) ), abs.data() );
+    ioctl( fd, EVIOCGPROP( sizeof( properties ) ), properties.data() );
+
+    info      = {};
+    info.name = name;
+
+    for ( unsigned int axis = 0; axis < ABS_CNT; ++axis )
+    {
+        input_absinfo absInfo {};
+        if ( testBit<ABS_CNT>( abs, axis ) && ioctl( fd, EVIOCGABS( axis ), &absInfo ) == 0 )
+            info.absRanges[axis] = { absInfo.minimum, absInfo.maximum };
+    }
+
+    info.keyboard = testBit<KEY_CNT>( keys, KEY_A ) && testBit<KEY_CNT>( keys, KEY_Z ) && testBit<KEY_CNT>( keys, KEY_SPACE );
+    info.mouse    = testBit<REL_CNT>( rel, REL_X ) && testBit<REL_CNT>( rel, REL_Y ) && testBit<KEY_CNT>( keys, BTN_LEFT );
+    info.gamepad  = testBit<KEY_CNT>( keys, BTN_GAMEPAD );
+    info.touch    = testBit<INPUT_PROP_CNT>( properties, INPUT_PROP_DIRECT ) && testBit<ABS_CNT>( abs, ABS_MT_SLOT ) &&
+                 testBit<ABS_CNT>( abs, ABS_MT_POSITION_X ) && testBit<ABS_CNT>( abs, ABS_MT_POSITION_Y );
+
+    return true;
+}
+
+int Evdev::addDevice( int fd, const DeviceInfo& info )
+{
+    return DeviceEvdev::get().add( fd, info );
+}
+
+void Evdev::removeDevice( int device )
+{
+    DeviceEvdev::get().remove( device );
+}
+
+void Evdev::setDeviceDirectory( std::string_view directory )
+{
+    DeviceEvdev::get().setDirectory( directory );
+}
+
+void Evdev::detail::startReader()
+{
+    static const bool started = ( DeviceEvdev::get().start(), true );
+    static_cast<void>( started );
+}
+
+uint64_t Evdev::detail::toTimestamp( const input_event& event ) noexcept
+{
+    return static_cast<uint64_t>( event.input_event_sec ) * 1'000'000'000 + static_cast<uint64_t>( event.input_event_usec ) * 1'000;
+}
+
+uint64_t input::getEventTime() noexcept
+{
+    timespec time {};
+    clock_gettime( CLOCK_MONOTONIC, &time );
+
+    return static_cast<uint64_t>( time.tv_sec ) * 1'000'000'000 + static_cast<uint64_t>( time.tv_nsec );
+}
+
+void input::beginFrame() noexcept
+{
+    // The devices are read by the reader thread.
+}
@@ -0,0 +1,406 @@
+#include <input/EventQueue.hpp>
+#include <input/Evdev.hpp>
+#include <input/Gamepad.hpp>
+#include <input/Profiler.hpp>
+
+#include <sys/ioctl.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <array>
+#include <mutex>
+
+using namespace input;
+
+constexpr float EvdevThumbDeadZone = 0.24f;  // Consistent with XboxOneThumbDeadZone
+
+namespace
+{
+// Map an evdev gamepad button to a Gamepad::Button (or Gamepad::Button::Count if the button is not supported).
+// The face buttons are mapped by their position (see the kernel's gamepad documentation).
+Gamepad::Button EvdevButtonToButton( unsigned int code ) noexcept
+{
+    switch ( code )
+    {
+    case BTN_SOUTH:
+        return Gamepad::Button::A;
+    case BTN_EAST:
+        return Gamepad::Button::B;
+    case BTN_WEST:
+        return Gamepad::Button::X;
+    case BTN_NORTH:
+        return Gamepad::Button::Y;
+    case BTN_THUMBL:
+        return Gamepad::Button::LeftStick;
+    case BTN_THUMBR:
+        return Gamepad::Button::RightStick;
+    case BTN_TL:
+        return Gamepad::Button::LeftShoulder;
+    case BTN_TR:
+        return Gamepad::Button::RightShoulder;
+    case BTN_SELECT:
+        return Gamepad::Button::Back;
+    case BTN_START:
+        return Gamepad::Button::Start;
+    case BTN_DPAD_UP:
+        return Gamepad::Button::DPadUp;
+    case BTN_DPAD_DOWN:
+        return Gamepad::Button::DPadDown;
+    case BTN_DPAD_LEFT:
+        return Gamepad::Button::DPadLeft;
+    case BTN_DPAD_RIGHT:
+        return Gamepad::Button::DPadRight;
+    default:
+        return Gamepad::Button::Count;
+    }
+}
+
+// Map [minimum...maximum] to [-1...1].
+float NormalizeStick( int32_t value, const Evdev::AbsRange& range ) noexcept
+{
+    if ( range.maximum <= range.minimum )
+        return 0.0f;
+
+    const float v = 2.0f * static_cast<float>( value - range.minimum ) / static_cast<float>( range.maximum - range.minimum ) - 1.0f;
+    return std::clamp( v, -1.0f, 1.0f );
+}
+
+// Map [minimum...maximum] to [0...1].
+float NormalizeTrigger( int32_t value, const Evdev::AbsRange& range ) noexcept
+{
+    if ( range.maximum <= range.minimum )
+        return 0.0f;
+
+    const float v = static_cast<float>( value - range.minimum ) / static_cast<float>( range.maximum - range.minimum );
+    return std::clamp( v, 0.0f, 1.0f );
+}
+
+bool HasAxis( const Evdev::DeviceInfo& info, int axis ) noexcept
+{
+    return info.absRanges[axis].maximum > info.absRanges[axis].minimum;
+}
+}  // namespace
+
+class GamepadEvdev
+{
+public:
+    static GamepadEvdev& get()
+    {
+        static GamepadEvdev instance;
+        return instance;
+    }
+
+    Gamepad::State getState( int player, Gamepad::DeadZone deadZoneMode ) const
+    {
+        std::scoped_lock lock( m_Mutex );
+
+        if ( player == Gamepad::MOST_RECENT_PLAYER )
+            player = m_MostRecentGamepad;
+
+        if ( player < 0 || player >= Gamepad::MAX_PLAYER_COUNT || m_Pads[player].device < 0 )
+            return {};
+
+        // The thumbsticks are stored raw, so the dead zone is applied here (the same as the other backends).
+        Gamepad::State state = m_Pads[player].state;
+
+        const Gamepad::ThumbSticks& raw = m_Pads[player].state.thumbSticks;
+        ApplyStickDeadZone( raw.leftX, raw.leftY, deadZoneMode, 1.0f, EvdevThumbDeadZone, state.thumbSticks.leftX, state.thumbSticks.leftY );
+        ApplyStickDeadZone( raw.rightX, raw.rightY, deadZoneMode, 1.0f, EvdevThumbDeadZone, state.thumbSticks.rightX, state.thumbSticks.rightY );
+
+        return state;
+    }
+
+    bool setVibration( int player, float leftMotor, float rightMotor, float /*leftTrigger*/, float /*rightTrigger*/ )
+    {
+        std::scoped_lock lock( m_Mutex );
+
+        if ( player == Gamepad::MOST_RECENT_PLAYER )
+            player = m_MostRecentGamepad;
+
+        if ( player < 0 || player >= Gamepad::MAX_PLAYER_COUNT || m_Pads[player].device < 0 )
+            return false;
+
+        Pad& pad = m_Pads[player];
+
+        // Upload (or update) a rumble effect, then play it. The strong motor is the low-frequency (left) motor.
+        ff_effect effect {};
+        effect.type                      = FF_RUMBLE;
+        effect.id                        = pad.effect;
+        effect.u.rumble.strong_magnitude = static_cast<uint16_t>( std::clamp( leftMotor, 0.0f, 1.0f ) * 0xFFFF );
+        effect.u.rumble.weak_magnitude   = static_cast<uint16_t>( std::clamp( rightMotor, 0.0f, 1.0f ) * 0xFFFF );
+        effect.replay.length             = 0xFFFF;
+
+        if ( ioctl( pad.fd, EVIOCSFF, &effect ) < 0 )
+            return false;  // No force feedback (or not a device node).
+
+        pad.effect = effect.id;
+
+        return play( pad, true );
+    }
+
+    void suspend()
+    {
+        std::scoped_lock lock( m_Mutex );
+        for ( auto& pad: m_Pads )
+        {
+            if ( pad.device >= 0 && pad.effect >= 0 )
+                play( pad, false );
+        }
+    }
+
+    void connect( int device, int fd, const Evdev::DeviceInfo& info )
+    {
+        std::scoped_lock lock( m_Mutex );
+
+        auto it = std::ranges::find_if( m_Pads, []( const Pad& p ) { return p.device < 0; } );
+        if ( it == m_Pads.end() )
+            return;  // All player slots are taken.
+
+        *it                 = {};
+        it->device          = device;
+        it->fd              = fd;
+        it->ranges          = info.absRanges;
+        it->state.connected = true;
+
+        // Gamepads without analog triggers report them as buttons.
+        it->digitalLeftTrigger  = !HasAxis( info, ABS_Z ) && !HasAxis( info, ABS_BRAKE );
+        it->digitalRightTrigger = !HasAxis( info, ABS_RZ ) && !HasAxis( info, ABS_GAS );
+
+        m_MostRecentGamepad = static_cast<int>( it - m_Pads.begin() );
+    }
+
+    void disconnect( int device )
+    {
+        std::scoped_lock lock( m_Mutex );
+
+        const int player = findPlayer( device );
+        if ( player < 0 )
+            return;
+
+        Pad& pad = m_Pads[player];
+        if ( pad.effect >= 0 )
+            ioctl( pad.fd, EVIOCRMFF, pad.effect );
+
+        pad = {};
+    }
+
+    void apply( int device, std::span<const input_event> events ) noexcept
+    {
+        std::scoped_lock lock( m_Mutex );
+
+        const int player = findPlayer( device );
+        if ( player < 0 )
+            return;
+
+        Pad& pad     = m_Pads[player];
+        bool changed = false;
+
+        for ( const auto& event: events )
+        {
+            INPUT_PROFILE_COUNT( GamepadWatchEvents );
+
+            const uint64_t timestamp = Evdev::detail::toTimestamp( event );
+
+            if ( event.type == EV_KEY && event.value != 2 )
+            {
+                if ( event.code == BTN_TL2 && pad.digitalLeftTrigger )
+                    changed |= setAxis( pad, player, GamepadAxis::LeftTrigger, event.value ? 1.0f : 0.0f, timestamp );
+                else if ( event.code == BTN_TR2 && pad.digitalRightTrigger )
+                    changed |= setAxis( pad, player, GamepadAxis::RightTrigger, event.value ? 1.0f : 0.0f, timestamp );
+                else
+                    changed |= setButton( pad, player, EvdevButtonToButton( event.code ), event.value != 0, timestamp );
+            }
+            else if ( event.type == EV_ABS && event.code < ABS_CNT )
+            {
+                const Evdev::AbsRange& range = pad.ranges[event.code];
+
+                switch ( event.code )
+                {
+                case ABS_X:
+                    changed |= setAxis( pad, player, GamepadAxis::LeftX, NormalizeStick( event.value, range ), timestamp );
+                    break;
+                case ABS_Y:  // The Y axis of evdev points down.
+                    changed |= setAxis( pad, player, GamepadAxis::LeftY, -NormalizeStick( event.value, range ), timestamp );
+                    break;
+                case ABS_RX:
+                    changed |= setAxis( pad, player, GamepadAxis::RightX, NormalizeStick( event.value, range ), timestamp );
+                    break;
+                case ABS_RY:
+                    changed |= setAxis( pad, player, GamepadAxis::RightY, -NormalizeStick( event.value, range ), timestamp );
+                    break;
+                case ABS_Z:
+                case ABS_BRAKE:
+                    changed |= setAxis( pad, player, GamepadAxis::LeftTrigger, NormalizeTrigger( event.value, range ), timestamp );
+                    break;
+                case ABS_RZ:
+                case ABS_GAS:
+                    changed |= setAxis( pad, player, GamepadAxis::RightTrigger, NormalizeTrigger( event.value, range ), timestamp );
+                    break;
+                case ABS_HAT0X:
+                    changed |= setButton( pad, player, Gamepad::Button::DPadLeft, event.value < 0, timestamp );
+                    changed |= setButton( pad, player, Gamepad::Button::DPadRight, event.value > 0, timestamp );
+                    break;
+                case ABS_HAT0Y:
+                    changed |= setButton( pad, player, Gamepad::Button::DPadUp, event.value < 0, timestamp );
+                    changed |= setButton( pad, player, Gamepad::Button::DPadDown, event.value > 0, timestamp );
+                    break;
+                default:
+                    break;
+                }
+            }
+            else if ( event.type == EV_SYN && event.code == SYN_REPORT && changed )
+            {
+                ++pad.state.packet;
+                m_MostRecentGamepad = player;
+                changed             = false;
+            }
+        }
+    }
+
+    GamepadEvdev( const GamepadEvdev& )            = delete;
+    GamepadEvdev( GamepadEvdev&& )                 = delete;
+    GamepadEvdev& operator=( const GamepadEvdev& ) = delete;
+    GamepadEvdev& operator=( GamepadEvdev&& )      = delete;
+
+private:
+    struct Pad
+    {
+        int                                                device = -1;  ///< -1 if the player slot is free.
+        int                                                fd     = -1;
+        int16_t                                            effect = -1;  ///< The uploaded rumble effect.
+        bool                                               digitalLeftTrigger  = false;
+        bool                                               digitalRightTrigger = false;
+        std::array<Evdev::AbsRange, Evdev::ABS_AXIS_COUNT> ranges {};
+        Gamepad::State                                     state {};  ///< The thumbsticks are raw.
+    };
+
+    GamepadEvdev()  = default;
+    ~GamepadEvdev() = default;
+
+    int findPlayer( int device ) const noexcept
+    {
+        for ( int i = 0; i < Gamepad::MAX_PLAYER_COUNT; ++i )
+        {
+            if ( m_Pads[i].device == device && device >= 0 )
+                return i;
+        }
+
+        return -1;
+    }
+
+    static bool play( const Pad& pad, bool start ) noexcept
+    {
+        input_event event {};
+        event.type  = EV_FF;
+        event.code  = static_cast<uint16_t>( pad.effect );
+        event.value = start ? 1 : 0;
+
+        return write( pad.fd, &event, sizeof( event ) ) == sizeof( event );
+    }
+
+    static bool setButton( Pad& pad, int player, Gamepad::Button button, bool down, uint64_t timestamp ) noexcept
+    {
+        if ( button >= Gamepad::Button::Count )
+            return false;
+
+        const uint32_t bit     = 1u << static_cast<uint32_t>( button );
+        const uint32_t buttons = PackGamepadButtons( pad.state );
+        if ( ( ( buttons & bit ) != 0 ) == down )
+            return false;
+
+        UnpackGamepadButtons( down ? buttons | bit : buttons & ~bit, pad.state );
+
+        Event e {};
+        e.type                 = down ? EventType::GamepadButtonDown : EventType::GamepadButtonUp;
+        e.timestamp            = timestamp;
+        e.gamepadButton.player = player;
+        e.gamepadButton.button = button;
+        EventQueue::get().push( e );
+
+        return true;
+    }
+
+    static bool setAxis( Pad& pad, int player, GamepadAxis axis, float value, uint64_t timestamp ) noexcept
+    {
+        float* target = nullptr;
+        switch ( axis )
+        {
+        case GamepadAxis::LeftX:
+            target = &pad.state.thumbSticks.leftX;
+            break;
+        case GamepadAxis::LeftY:
+            target = &pad.state.thumbSticks.leftY;
+            break;
+        case GamepadAxis::RightX:
+            target = &pad.state.thumbSticks.rightX;
+            break;
+        case GamepadAxis::RightY:
+            target = &pad.state.thumbSticks.rightY;
+            break;
+        case GamepadAxis::LeftTrigger:
+            target = &pad.state.triggers.left;
+            break;
+        case GamepadAxis::RightTrigger:
+            target = &pad.state.triggers.right;
+            break;
+        }
+
+        if ( *target == value )
+            return false;
+
+        *target = value;
+
+        Event e {};
+        e.type               = EventType::GamepadAxis;
+        e.timestamp          = timestamp;
+        e.gamepadAxis.player = player;
+        e.gamepadAxis.axis   = axis;
+        e.gamepadAxis.value  = value;
+        EventQueue::get().push( e );
+
+        return true;
+    }
+
+    std::array<Pad, Gamepad::MAX_PLAYER_COUNT> m_Pads              = {};
+    int                                        m_MostRecentGamepad = 0;
+    mutable Mutex                              m_Mutex;
+};
+
+// Bridge to Gamepad interface
+Gamepad::State Gamepad::getState( int playerIndex, DeadZone deadZoneMode )
+{
+    INPUT_PROFILE_SCOPE( GamepadGetState );
+
+    Evdev::detail::startReader();
+    return GamepadEvdev::get().getState( playerIndex, deadZoneMode );
+}
+
+bool Gamepad::setVibration( int playerIndex, float leftMotor, float rightMotor, float leftTrigger, float rightTrigger )
+{
+    return GamepadEvdev::get().setVibration( playerIndex, leftMotor, rightMotor, leftTrigger, rightTrigger );
+}
+
+void Gamepad::suspend() noexcept
+{
+    GamepadEvdev::get().suspend();
+}
+
+void Gamepad::resume() noexcept
+{
+    // The gamepads are found by the reader thread when they are plugged in, so there is nothing to scan.
+}
+
+void Evdev::detail::connectGamepad( int device, int fd, const DeviceInfo& info )
+{
+    GamepadEvdev::get().connect( device, fd, info );
+}
+
+void Evdev::detail::disconnectGamepad( int device )
+{
+    GamepadEvdev::get().disconnect( device );
+}
+
+void Evdev::detail::applyGamepadEvents( int device, std::span<const input_event> events ) noexcept
+{
+    GamepadEvdev::get().apply( device, events );
+}
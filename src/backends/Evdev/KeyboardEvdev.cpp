@@ -0,0 +1,488 @@
+#include <input/EventQueue.hpp>
+#include <input/Evdev.hpp>
+#include <input/Keyboard.hpp>
+#include <input/Profiler.hpp>
+
+#include <algorithm>
+#include <mutex>
+#include <vector>
+
+using namespace input;
+
+namespace
+{
+void KeyDown( int key, Keyboard::State& state ) noexcept
+{
+    if ( key < 0 || key > 0xfe )
+        return;
+
+    auto               ptr = reinterpret_cast<uint32_t*>( &state );
+    const unsigned int bf  = 1u << ( key & 0x1f );
+    ptr[( key >> 5 )] |= bf;
+}
+
+void KeyUp( int key, Keyboard::State& state ) noexcept
+{
+    if ( key < 0 || key > 0xfe )
+        return;
+
+    auto               ptr = reinterpret_cast<uint32_t*>( &state );
+    const unsigned int bf  = 1u << ( key & 0x1f );
+    ptr[( key >> 5 )] &= ~bf;
+}
+
+// Map an evdev key code to Keyboard::Keys enum value or VK code
+int EvdevKeyToVirtualKey( unsigned int code )
+{
+    using K = Keyboard::Key;
+    switch ( code )
+    {
+    case KEY_BACKSPACE:
+        return static_cast<int>( K::Back );
+    case KEY_TAB:
+        return static_cast<int>( K::Tab );
+    case KEY_ENTER:
+        return static_cast<int>( K::Enter );
+    case KEY_PAUSE:
+        return static_cast<int>( K::Pause );
+    case KEY_CAPSLOCK:
+        return static_cast<int>( K::CapsLock );
+    case KEY_ESC:
+        return static_cast<int>( K::Escape );
+    case KEY_SPACE:
+        return static_cast<int>( K::Space );
+    case KEY_PAGEUP:
+        return static_cast<int>( K::PageUp );
+    case KEY_PAGEDOWN:
+        return static_cast<int>( K::PageDown );
+    case KEY_END:
+        return static_cast<int>( K::End );
+    case KEY_HOME:
+        return static_cast<int>( K::Home );
+    case KEY_LEFT:
+        return static_cast<int>( K::Left );
+    case KEY_UP:
+        return static_cast<int>( K::Up );
+    case KEY_RIGHT:
+        return static_cast<int>( K::Right );
+    case KEY_DOWN:
+        return static_cast<int>( K::Down );
+    case KEY_SELECT:
+        return static_cast<int>( K::Select );
+    case KEY_PRINT:
+        return static_cast<int>( K::Print );
+    case KEY_SYSRQ:
+        return static_cast<int>( K::PrintScreen );
+    case KEY_INSERT:
+        return static_cast<int>( K::Insert );
+    case KEY_DELETE:
+        return static_cast<int>( K::Delete );
+    case KEY_HELP:
+        return static_cast<int>( K::Help );
+
+    case KEY_0:
+        return static_cast<int>( K::D0 );
+    case KEY_1:
+        return static_cast<int>( K::D1 );
+    case KEY_2:
+        return static_cast<int>( K::D2 );
+    case KEY_3:
+        return static_cast<int>( K::D3 );
+    case KEY_4:
+        return static_cast<int>( K::D4 );
+    case KEY_5:
+        return static_cast<int>( K::D5 );
+    case KEY_6:
+        return static_cast<int>( K::D6 );
+    case KEY_7:
+        return static_cast<int>( K::D7 );
+    case KEY_8:
+        return static_cast<int>( K::D8 );
+    case KEY_9:
+        return static_cast<int>( K::D9 );
+
+    case KEY_A:
+        return static_cast<int>( K::A );
+    case KEY_B:
+        return static_cast<int>( K::B );
+    case KEY_C:
+        return static_cast<int>( K::C );
+    case KEY_D:
+        return static_cast<int>( K::D );
+    case KEY_E:
+        return static_cast<int>( K::E );
+    case KEY_F:
+        return static_cast<int>( K::F );
+    case KEY_G:
+        return static_cast<int>( K::G );
+    case KEY_H:
+        return static_cast<int>( K::H );
+    case KEY_I:
+        return static_cast<int>( K::I );
+    case KEY_J:
+        return static_cast<int>( K::J );
+    case KEY_K:
+        return static_cast<int>( K::K );
+    case KEY_L:
+        return static_cast<int>( K::L );
+    case KEY_M:
+        return static_cast<int>( K::M );
+    case KEY_N:
+        return static_cast<int>( K::N );
+    case KEY_O:
+        return static_cast<int>( K::O );
+    case KEY_P:
+        return static_cast<int>( K::P );
+    case KEY_Q:
+        return static_cast<int>( K::Q );
+    case KEY_R:
+        return static_cast<int>( K::R );
+    case KEY_S:
+        return static_cast<int>( K::S );
+    case KEY_T:
+        return static_cast<int>( K::T );
+    case KEY_U:
+        return static_cast<int>( K::U );
+    case KEY_V:
+        return static_cast<int>( K::V );
+    case KEY_W:
+        return static_cast<int>( K::W );
+    case KEY_X:
+        return static_cast<int>( K::X );
+    case KEY_Y:
+        return static_cast<int>( K::Y );
+    case KEY_Z:
+        return static_cast<int>( K::Z );
+
+    case KEY_LEFTMETA:
+        return static_cast<int>( K::LeftSuper );
+    case KEY_RIGHTMETA:
+        return static_cast<int>( K::RightSuper );
+    case KEY_COMPOSE:
+        return static_cast<int>( K::Apps );
+    case KEY_SLEEP:
+        return static_cast<int>( K::Sleep );
+
+    case KEY_KP0:
+        return static_cast<int>( K::NumPad0 );
+    case KEY_KP1:
+        return static_cast<int>( K::NumPad1 );
+    case KEY_KP2:
+        return static_cast<int>( K::NumPad2 );
+    case KEY_KP3:
+        return static_cast<int>( K::NumPad3 );
+    case KEY_KP4:
+        return static_cast<int>( K::NumPad4 );
+    case KEY_KP5:
+        return static_cast<int>( K::NumPad5 );
+    case KEY_KP6:
+        return static_cast<int>( K::NumPad6 );
+    case KEY_KP7:
+        return static_cast<int>( K::NumPad7 );
+    case KEY_KP8:
+        return static_cast<int>( K::NumPad8 );
+    case KEY_KP9:
+        return static_cast<int>( K::NumPad9 );
+    case KEY_KPASTERISK:
+        return static_cast<int>( K::Multiply );
+    case KEY_KPPLUS:
+        return static_cast<int>( K::Add );
+    case KEY_KPENTER:
+        return static_cast<int>( K::Separator );
+    case KEY_KPMINUS:
+        return static_cast<int>( K::Subtract );
+    case KEY_KPDOT:
+        return static_cast<int>( K::Decimal );
+    case KEY_KPSLASH:
+        return static_cast<int>( K::Divide );
+
+    case KEY_F1:
+        return static_cast<int>( K::F1 );
+    case KEY_F2:
+        return static_cast<int>( K::F2 );
+    case KEY_F3:
+        return static_cast<int>( K::F3 );
+    case KEY_F4:
+        return static_cast<int>( K::F4 );
+    case KEY_F5:
+        return static_cast<int>( K::F5 );
+    case KEY_F6:
+        return static_cast<int>( K::F6 );
+    case KEY_F7:
+        return static_cast<int>( K::F7 );
+    case KEY_F8:
+        return static_cast<int>( K::F8 );
+    case KEY_F9:
+        return static_cast<int>( K::F9 );
+    case KEY_F10:
+        return static_cast<int>( K::F10 );
+    case KEY_F11:
+        return static_cast<int>( K::F11 );
+    case KEY_F12:
+        return static_cast<int>( K::F12 );
+    case KEY_F13:
+        return static_cast<int>( K::F13 );
+    case KEY_F14:
+        return static_cast<int>( K::F14 );
+    case KEY_F15:
+        return static_cast<int>( K::F15 );
+    case KEY_F16:
+        return static_cast<int>( K::F16 );
+    case KEY_F17:
+        return static_cast<int>( K::F17 );
+    case KEY_F18:
+        return static_cast<int>( K::F18 );
+    case KEY_F19:
+        return static_cast<int>( K::F19 );
+    case KEY_F20:
+        return static_cast<int>( K::F20 );
+    case KEY_F21:
+        return static_cast<int>( K::F21 );
+    case KEY_F22:
+        return static_cast<int>( K::F22 );
+    case KEY_F23:
+        return static_cast<int>( K::F23 );
+    case KEY_F24:
+        return static_cast<int>( K::F24 );
+
+    case KEY_NUMLOCK:
+        return static_cast<int>( K::NumLock );
+    case KEY_SCROLLLOCK:
+        return static_cast<int>( K::Scroll );
+
+    case KEY_LEFTSHIFT:
+        return static_cast<int>( K::LeftShift );
+    case KEY_RIGHTSHIFT:
+        return static_cast<int>( K::RightShift );
+    case KEY_LEFTCTRL:
+        return static_cast<int>( K::LeftControl );
+    case KEY_RIGHTCTRL:
+        return static_cast<int>( K::RightControl );
+    case KEY_LEFTALT:
+        return static_cast<int>( K::LeftAlt );
+    case KEY_RIGHTALT:
+        return static_cast<int>( K::RightAlt );
+
+    case KEY_BACK:
+        return static_cast<int>( K::BrowserBack );
+    case KEY_FORWARD:
+        return static_cast<int>( K::BrowserForward );
+    case KEY_REFRESH:
+        return static_cast<int>( K::BrowserRefresh );
+    case KEY_STOP:
+        return static_cast<int>( K::BrowserStop );
+    case KEY_SEARCH:
+        return static_cast<int>( K::BrowserSearch );
+    case KEY_BOOKMARKS:
+        return static_cast<int>( K::BrowserFavorites );
+    case KEY_HOMEPAGE:
+        return static_cast<int>( K::BrowserHome );
+    case KEY_MUTE:
+        return static_cast<int>( K::VolumeMute );
+    case KEY_VOLUMEDOWN:
+        return static_cast<int>( K::VolumeDown );
+    case KEY_VOLUMEUP:
+        return static_cast<int>( K::VolumeUp );
+    case KEY_NEXTSONG:
+        return static_cast<int>( K::MediaNextTrack );
+    case KEY_PREVIOUSSONG:
+        return static_cast<int>( K::MediaPreviousTrack );
+    case KEY_STOPCD:
+        return static_cast<int>( K::MediaStop );
+    case KEY_PLAYPAUSE:
+        return static_cast<int>( K::MediaPlayPause );
+    case KEY_MAIL:
+        return static_cast<int>( K::LaunchMail );
+    case KEY_MEDIA:
+        return static_cast<int>( K::SelectMedia );
+    case KEY_PROG1:
+        return static_cast<int>( K::LaunchApplication1 );
+    case KEY_PROG2:
+        return static_cast<int>( K::LaunchApplication2 );
+
+    case KEY_SEMICOLON:
+        return static_cast<int>( K::OemSemicolon );
+    case KEY_EQUAL:
+        return static_cast<int>( K::OemPlus );
+    case KEY_COMMA:
+        return static_cast<int>( K::OemComma );
+    case KEY_MINUS:
+        return static_cast<int>( K::OemMinus );
+    case KEY_DOT:
+        return static_cast<int>( K::OemPeriod );
+    case KEY_SLASH:
+        return static_cast<int>( K::OemQuestion );
+    case KEY_GRAVE:
+        return static_cast<int>( K::OemTilde );
+    case KEY_LEFTBRACE:
+        return static_cast<int>( K::OemOpenBrackets );
+    case KEY_BACKSLASH:
+        return static_cast<int>( K::OemPipe );
+    case KEY_RIGHTBRACE:
+        return static_cast<int>( K::OemCloseBrackets );
+    case KEY_APOSTROPHE:
+        return static_cast<int>( K::OemQuotes );
+    case KEY_102ND:
+        return static_cast<int>( K::OemBackslash );
+
+    case KEY_HANGEUL:
+        return static_cast<int>( K::KanaMode );
+    case KEY_HANJA:
+        return static_cast<int>( K::KanjiMode );
+
+    case KEY_MENU:
+        return static_cast<int>( K::Apps );
+    case KEY_CANCEL:
+        return static_cast<int>( K::Cancel );
+
+    default:
+        return static_cast<int>( K::None );
+    }
+}
+}  // namespace
+
+class KeyboardEvdev
+{
+public:
+    static KeyboardEvdev& get()
+    {
+        static KeyboardEvdev instance;
+        return instance;
+    }
+
+    Keyboard::State getState() const
+    {
+        std::scoped_lock lock( m_Mutex );
+
+        // The keys of all keyboards are combined.
+        Keyboard::State state {};
+        auto            ptr = reinterpret_cast<uint32_t*>( &state );
+
+        for ( auto& keyboard: m_Keyboards )
+        {
+            auto keys = reinterpret_cast<const uint32_t*>( &keyboard.state );
+            for ( size_t i = 0; i < sizeof( Keyboard::State ) / sizeof( uint32_t ); ++i )
+                ptr[i] |= keys[i];
+        }
+
+        state.AltKey     = state.LeftAlt || state.RightAlt;
+        state.ControlKey = state.LeftControl || state.RightControl;
+        state.ShiftKey   = state.LeftShift || state.RightShift;
+
+        return state;
+    }
+
+    void connect( int device )
+    {
+        std::scoped_lock lock( m_Mutex );
+        m_Keyboards.push_back( { device, {} } );
+    }
+
+    void disconnect( int device )
+    {
+        std::scoped_lock lock( m_Mutex );
+        std::erase_if( m_Keyboards, [device]( const Device& d ) { return d.id == device; } );
+    }
+
+    void apply( int device, std::span<const input_event> events ) noexcept
+    {
+        std::scoped_lock lock( m_Mutex );
+
+        auto it = std::ranges::find_if( m_Keyboards, [device]( const Device& d ) { return d.id == device; } );
+        if ( it == m_Keyboards.end() )
+            return;
+
+        for ( const auto& event: events )
+        {
+            // Key repeats (value 2) are not reported.
+            if ( event.type != EV_KEY || event.value == 2 )
+                continue;
+
+            INPUT_PROFILE_COUNT( KeyboardWatchEvents );
+
+            const int vk = EvdevKeyToVirtualKey( event.code );
+            if ( vk > 0 && vk <= 0xfe )
+            {
+                if ( event.value )
+                    KeyDown( vk, it->state );
+                else
+                    KeyUp( vk, it->state );
+
+                Event e {};
+                e.type      = event.value ? EventType::KeyDown : EventType::KeyUp;
+                e.timestamp = Evdev::detail::toTimestamp( event );
+                e.key.key   = static_cast<Keyboard::Key>( vk );
+                EventQueue::get().push( e );
+            }
+        }
+    }
+
+    void reset() noexcept
+    {
+        std::scoped_lock lock( m_Mutex );
+
+        for ( auto& keyboard: m_Keyboards )
+            keyboard.state = {};
+    }
+
+    bool isConnected() const
+    {
+        std::scoped_lock lock( m_Mutex );
+        return !m_Keyboards.empty();
+    }
+
+    KeyboardEvdev( const KeyboardEvdev& )            = delete;
+    KeyboardEvdev( KeyboardEvdev&& )                 = delete;
+    KeyboardEvdev& operator=( const KeyboardEvdev& ) = delete;
+    KeyboardEvdev& operator=( KeyboardEvdev&& )      = delete;
+
+private:
+    struct Device
+    {
+        int             id;
+        Keyboard::State state;
+    };
+
+    KeyboardEvdev()  = default;
+    ~KeyboardEvdev() = default;
+
+    std::vector<Device> m_Keyboards;
+    mutable Mutex       m_Mutex;
+};
+
+namespace input::Keyboard
+{
+State getState()
+{
+    INPUT_PROFILE_SCOPE( KeyboardGetState );
+
+    Evdev::detail::startReader();
+    return KeyboardEvdev::get().getState();
+}
+
+void reset()
+{
+    KeyboardEvdev::get().reset();
+}
+
+bool isConnected()
+{
+    Evdev::detail::startReader();
+    return KeyboardEvdev::get().isConnected();
+}
+}  // namespace input::Keyboard
+
+void Evdev::detail::connectKeyboard( int device )
+{
+    KeyboardEvdev::get().connect( device );
+}
+
+void Evdev::detail::disconnectKeyboard( int device )
+{
+    KeyboardEvdev::get().disconnect( device );
+}
+
+void Evdev::detail::applyKeyboardEvents( int device, std::span<const input_event> events ) noexcept
+{
+    KeyboardEvdev::get().apply( device, events );
+}
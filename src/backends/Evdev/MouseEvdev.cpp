@@ -0,0 +1,367 @@
+#include <input/EventQueue.hpp>
+#include <input/Evdev.hpp>
+#include <input/Mouse.hpp>
+#include <input/Profiler.hpp>
+
+#include <algorithm>
+#include <atomic>
+#include <mutex>
+#include <vector>
+
+using namespace input;
+
+class MouseEvdev
+{
+public:
+    static MouseEvdev& get()
+    {
+        static MouseEvdev instance;
+        return instance;
+    }
+
+    Mouse::State getState() const
+    {
+        std::scoped_lock lock( m_Mutex );
+
+        const uint8_t buttons = getButtons();
+
+        Mouse::State state {};
+        state.positionMode = m_Mode;
+        state.leftButton   = ( buttons & buttonBit( Mouse::Button::Left ) ) != 0;
+        state.middleButton = ( buttons & buttonBit( Mouse::Button::Middle ) ) != 0;
+        state.rightButton  = ( buttons & buttonBit( Mouse::Button::Right ) ) != 0;
+        state.xButton1     = ( buttons & buttonBit( Mouse::Button::XButton1 ) ) != 0;
+        state.xButton2     = ( buttons & buttonBit( Mouse::Button::XButton2 ) ) != 0;
+
+        if ( m_Mode == Mouse::Mode::Absolute )
+        {
+            state.x = m_X;
+            state.y = m_Y;
+        }
+        else  // Relative mode
+        {
+            state.x = m_RelativeX;
+            state.y = m_RelativeY;
+        }
+
+        state.scrollWheelValue = m_ScrollWheelValue;
+
+        return state;
+    }
+
+    void connect( int device )
+    {
+        std::scoped_lock lock( m_Mutex );
+        m_Mice.push_back( { device } );
+    }
+
+    void disconnect( int device )
+    {
+        std::scoped_lock lock( m_Mutex );
+        std::erase_if( m_Mice, [device]( const Device& d ) { return d.id == device; } );
+    }
+
+    void apply( int device, std::span<const input_event> events ) noexcept
+    {
+        std::scoped_lock lock( m_Mutex );
+
+        auto it = std::ranges::find_if( m_Mice, [device]( const Device& d ) { return d.id == device; } );
+        if ( it == m_Mice.end() )
+            return;
+
+        float   deltaX = 0.0f;
+        float   deltaY = 0.0f;
+        int32_t wheel  = 0;
+
+        for ( const auto& event: events )
+        {
+            INPUT_PROFILE_COUNT( MouseWatchEvents );
+
+            switch ( event.type )
+            {
+            case EV_REL:
+                switch ( event.code )
+                {
+                case REL_X:
+                    deltaX += static_cast<float>( event.value );
+                    break;
+                case REL_Y:
+                    deltaY += static_cast<float>( event.value );
+                    break;
+                case REL_WHEEL:
+                    // The high-resolution wheel reports the same motion in 120ths of a notch.
+                    if ( !it->highResolutionWheel )
+                        wheel += event.value * 120;
+                    break;
+                case REL_WHEEL_HI_RES:
+                    it->highResolutionWheel = true;
+                    wheel += event.value;
+                    break;
+                default:
+                    break;
+                }
+                break;
+            case EV_KEY:
+            {
+                Event e {};
+                if ( event.value != 2 && getButton( event.code, e.mouseButton.button ) )
+                {
+                    const uint8_t bit = buttonBit( e.mouseButton.button );
+                    it->buttons       = event.value ? it->buttons | bit : it->buttons & ~bit;
+
+                    e.type          = event.value ? EventType::MouseButtonDown : EventType::MouseButtonUp;
+                    e.timestamp     = Evdev::detail::toTimestamp( event );
+                    e.mouseButton.x = m_X;
+                    e.mouseButton.y = m_Y;
+                    EventQueue::get().push( e );
+                }
+            }
+            break;
+            case EV_SYN:
+                if ( event.code != SYN_REPORT )
+                    break;
+
+                if ( deltaX != 0.0f || deltaY != 0.0f )
+                {
+                    // The raw motion counts of the device, without pointer acceleration.
+                    m_X += deltaX;
+                    m_Y += deltaY;
+
+                    if ( m_Mode == Mouse::Mode::Relative )
+                    {
+                        m_AccumulateX += deltaX;
+                        m_AccumulateY += deltaY;
+                    }
+
+                    m_Motion.add( { Evdev::detail::toTimestamp( event ), m_X, m_Y, deltaX, deltaY, getButtons() } );
+
+                    Event e {};
+                    e.type               = EventType::MouseMotion;
+                    e.timestamp          = Evdev::detail::toTimestamp( event );
+                    e.mouseMotion.x      = m_X;
+                    e.mouseMotion.y      = m_Y;
+                    e.mouseMotion.deltaX = deltaX;
+                    e.mouseMotion.deltaY = deltaY;
+                    EventQueue::get().push( e );
+                }
+
+                if ( wheel != 0 )
+                {
+                    m_ScrollWheelValue += wheel;
+
+                    Event e {};
+                    e.type             = EventType::MouseWheel;
+                    e.timestamp        = Evdev::detail::toTimestamp( event );
+                    e.mouseWheel.delta = wheel;
+                    EventQueue::get().push( e );
+                }
+                break;
+            default:
+                break;
+            }
+        }
+    }
+
+    void resetScrollWheelValue() noexcept
+    {
+        std::scoped_lock lock( m_Mutex );
+        m_ScrollWheelValue = 0;
+    }
+
+    void setMode( Mouse::Mode mode )
+    {
+        std::scoped_lock lock( m_Mutex );
+        if ( m_Mode == mode )
+            return;
+
+        m_Mode = mode;
+        if ( mode == Mouse::Mode::Relative )
+        {
+            m_AccumulateX = m_RelativeX = 0;
+            m_AccumulateY = m_RelativeY = 0;
+        }
+    }
+
+    void resetRelativeMotion() noexcept
+    {
+        std::scoped_lock lock( m_Mutex );
+        m_Motion.endFrame();
+
+        if ( m_Mode == Mouse::Mode::Relative )
+        {
+            m_RelativeX = m_AccumulateX;
+            m_RelativeY = m_AccumulateY;
+
+            m_AccumulateX = 0.0f;
+            m_AccumulateY = 0.0f;
+        }
+    }
+
+    std::span<const Mouse::MotionSample> getMotionHistory() const noexcept
+    {
+        std::scoped_lock lock( m_Mutex );
+        return m_Motion.getSamples();
+    }
+
+    uint32_t getDroppedMotionSamples() const noexcept
+    {
+        std::scoped_lock lock( m_Mutex );
+        return m_Motion.getDroppedCount();
+    }
+
+    bool isConnected() const
+    {
+        std::scoped_lock lock( m_Mutex );
+        return !m_Mice.empty();
+    }
+
+    bool isVisible() const noexcept
+    {
+        return m_Visible;
+    }
+
+    void setVisible( bool visible ) noexcept
+    {
+        m_Visible = visible;
+    }
+
+    MouseEvdev( const MouseEvdev& )            = delete;
+    MouseEvdev( MouseEvdev&& )                 = delete;
+    MouseEvdev& operator=( const MouseEvdev& ) = delete;
+    MouseEvdev& operator=( MouseEvdev&& )      = delete;
+
+private:
+    struct Device
+    {
+        int     id;
+        uint8_t buttons             = 0;  ///< Bit n is Mouse::Button n.
+        bool    highResolutionWheel = false;
+    };
+
+    MouseEvdev()  = default;
+    ~MouseEvdev() = default;
+
+    static uint8_t buttonBit( Mouse::Button button ) noexcept
+    {
+        return static_cast<uint8_t>( 1u << static_cast<int>( button ) );
+    }
+
+    static bool getButton( unsigned int code, Mouse::Button& button ) noexcept
+    {
+        switch ( code )
+        {
+        case BTN_LEFT:
+            button = Mouse::Button::Left;
+            return true;
+        case BTN_MIDDLE:
+            button = Mouse::Button::Middle;
+            return true;
+        case BTN_RIGHT:
+            button = Mouse::Button::Right;
+            return true;
+        case BTN_SIDE:
+            button = Mouse::Button::XButton1;
+            return true;
+        case BTN_EXTRA:
+            button = Mouse::Button::XButton2;
+            return true;
+        default:
+            return false;
+        }
+    }
+
+    // The buttons of all mice are combined.
+    uint8_t getButtons() const noexcept
+    {
+        uint8_t buttons = 0;
+        for ( auto& mouse: m_Mice )
+            buttons |= mouse.buttons;
+
+        return buttons;
+    }
+
+    // There is no window (and no cursor), so the absolute position is the sum of the motion counts.
+    float                m_X                = 0.0f;
+    float                m_Y                = 0.0f;
+    float                m_AccumulateX      = 0.0f;
+    float                m_AccumulateY      = 0.0f;
+    float                m_RelativeX        = 0.0f;
+    float                m_RelativeY        = 0.0f;
+    int64_t              m_ScrollWheelValue = 0;
+    Mouse::Mode          m_Mode             = Mouse::Mode::Absolute;
+    std::atomic<bool>    m_Visible { true };
+    std::vector<Device>  m_Mice;
+    Mouse::MotionHistory m_Motion;
+    mutable Mutex        m_Mutex;
+};
+
+namespace input::Mouse
+{
+State getState()
+{
+    INPUT_PROFILE_SCOPE( MouseGetState );
+
+    Evdev::detail::startReader();
+    return MouseEvdev::get().getState();
+}
+
+void resetScrollWheelValue() noexcept
+{
+    MouseEvdev::get().resetScrollWheelValue();
+}
+
+void setMode( Mode mode )
+{
+    MouseEvdev::get().setMode( mode );
+}
+
+void resetRelativeMotion() noexcept
+{
+    MouseEvdev::get().resetRelativeMotion();
+}
+
+std::span<const MotionSample> getMotionHistory() noexcept
+{
+    return MouseEvdev::get().getMotionHistory();
+}
+
+uint32_t getDroppedMotionSamples() noexcept
+{
+    return MouseEvdev::get().getDroppedMotionSamples();
+}
+
+bool isConnected()
+{
+    Evdev::detail::startReader();
+    return MouseEvdev::get().isConnected();
+}
+
+bool isVisible() noexcept
+{
+    return MouseEvdev::get().isVisible();
+}
+
+void setVisible( bool visible )
+{
+    MouseEvdev::get().setVisible( visible );
+}
+
+void setWindow( void* /*window*/ )
+{}
+
+}  // namespace input::Mouse
+
+void Evdev::detail::connectMouse( int device )
+{
+    MouseEvdev::get().connect( device );
+}
+
+void Evdev::detail::disconnectMouse( int device )
+{
+    MouseEvdev::get().disconnect( device );
+}
+
+void Evdev::detail::applyMouseEvents( int device, std::span<const input_event> events ) noexcept
+{
+    MouseEvdev::get().apply( device, events );
+}
@@ -0,0 +1,324 @@
+#include <input/EventQueue.hpp>
+#include <input/Evdev.hpp>
+#include <input/Profiler.hpp>
+#include <input/Touch.hpp>
+
+#include <sys/ioctl.h>
+
+#include <algorithm>
+#include <mutex>
+#include <vector>
+
+using namespace input;
+
+namespace
+{
+// The maximum number of multi-touch slots of a device.
+constexpr int MAX_SLOT_COUNT = 64;
+
+// Map [minimum...maximum] to [0...1].
+float Normalize( int32_t value, const Evdev::AbsRange& range ) noexcept
+{
+    if ( range.maximum <= range.minimum )
+        return 0.0f;
+
+    const float v = static_cast<float>( value - range.minimum ) / static_cast<float>( range.maximum - range.minimum );
+    return std::clamp( v, 0.0f, 1.0f );
+}
+}  // namespace
+
+class TouchEvdev
+{
+public:
+    static TouchEvdev& get()
+    {
+        static TouchEvdev instance;
+        return instance;
+    }
+
+    Touch::State getState() const
+    {
+        std::scoped_lock lock( m_Mutex );
+
+        Touch::State state {};
+        state.touches = m_Touches;
+
+        return state;
+    }
+
+    void endFrame()
+    {
+        std::scoped_lock lock( m_Mutex );
+
+        // Remove touches that ended in the previous frame
+        erase_if( m_Touches,
+                  []( const Touch::TouchPoint& t ) {
+                      return t.phase == Touch::Phase::Ended || t.phase == Touch::Phase::Cancelled;
+                  } );
+
+        // Mark remaining touches as stationary (they will be updated to Moved if motion events occur)
+        for ( auto& touch: m_Touches )
+        {
+            if ( touch.phase != Touch::Phase::Began )
+            {
+                touch.phase = Touch::Phase::Stationary;
+            }
+        }
+    }
+
+    void connect( int device, int fd, const Evdev::DeviceInfo& info )
+    {
+        std::scoped_lock lock( m_Mutex );
+
+        Device& d = m_Devices.emplace_back();
+        d.id            = device;
+        d.x             = info.absRanges[ABS_MT_POSITION_X];
+        d.y             = info.absRanges[ABS_MT_POSITION_Y];
+        d.touchPressure = info.absRanges[ABS_MT_PRESSURE];
+        d.slots.resize( std::clamp( info.absRanges[ABS_MT_SLOT].maximum + 1, 1, MAX_SLOT_COUNT ) );
+
+        // A device node reports the slot that was selected last (a stream starts with slot 0).
+        input_absinfo slot {};
+        if ( ioctl( fd, EVIOCGABS( ABS_MT_SLOT ), &slot ) == 0 )
+            d.slot = slot.value;
+    }
+
+    void disconnect( int device )
+    {
+        std::scoped_lock lock( m_Mutex );
+
+        // The contacts of the device are cancelled.
+        for ( auto& touch: m_Touches )
+        {
+            if ( touch.id >> 32 == static_cast<uint64_t>( device ) )
+                touch.phase = Touch::Phase::Cancelled;
+        }
+
+        std::erase_if( m_Devices, [device]( const Device& d ) { return d.id == device; } );
+    }
+
+    // Multi-touch protocol B: ABS_MT_SLOT selects the slot that the following events change, ABS_MT_TRACKING_ID
+    // assigns a new contact to the slot (or -1 to lift it), and SYN_REPORT completes the changes of all slots.
+    void apply( int device, std::span<const input_event> events ) noexcept
+    {
+        std::scoped_lock lock( m_Mutex );
+
+        auto it = std::ranges::find_if( m_Devices, [device]( const Device& d ) { return d.id == device; } );
+        if ( it == m_Devices.end() )
+            return;
+
+        Device& d = *it;
+
+        for ( const auto& event: events )
+        {
+            INPUT_PROFILE_COUNT( TouchWatchEvents );
+
+            if ( event.type == EV_SYN && event.code == SYN_REPORT )
+            {
+                report( d, Evdev::detail::toTimestamp( event ) );
+                continue;
+            }
+
+            if ( event.type != EV_ABS )
+                continue;
+
+            if ( event.code == ABS_MT_SLOT )
+            {
+                d.slot = event.value;
+                continue;
+            }
+
+            if ( d.slot < 0 || d.slot >= static_cast<int>( d.slots.size() ) )
+                continue;
+
+            Slot& slot = d.slots[d.slot];
+            switch ( event.code )
+            {
+            case ABS_MT_TRACKING_ID:
+                slot.trackingId = event.value;
+                break;
+            case ABS_MT_POSITION_X:
+                slot.x       = event.value;
+                slot.changed = true;
+                break;
+            case ABS_MT_POSITION_Y:
+                slot.y       = event.value;
+                slot.changed = true;
+                break;
+            case ABS_MT_PRESSURE:
+                slot.pressure = event.value;
+                slot.changed  = true;
+                break;
+            default:
+                break;
+            }
+        }
+    }
+
+    bool isSupported() const
+    {
+        std::scoped_lock lock( m_Mutex );
+        return !m_Devices.empty();
+    }
+
+    int getDeviceCount() const
+    {
+        std::scoped_lock lock( m_Mutex );
+        return static_cast<int>( m_Devices.size() );
+    }
+
+    TouchEvdev( const TouchEvdev& )            = delete;
+    TouchEvdev( TouchEvdev&& )                 = delete;
+    TouchEvdev& operator=( const TouchEvdev& ) = delete;
+    TouchEvdev& operator=( TouchEvdev&& )      = delete;
+
+private:
+    struct Slot
+    {
+        int32_t trackingId = -1;  ///< The contact of the slot (-1 if there is none).
+        int32_t contact    = -1;  ///< The contact that was reported with the last SYN_REPORT.
+        int32_t x          = 0;
+        int32_t y          = 0;
+        int32_t pressure   = 0;
+        bool    changed    = false;
+    };
+
+    struct Device
+    {
+        int               id;
+        int               slot = 0;
+        Evdev::AbsRange   x;
+        Evdev::AbsRange   y;
+        Evdev::AbsRange   touchPressure;
+        std::vector<Slot> slots;
+    };
+
+    TouchEvdev()  = default;
+    ~TouchEvdev() = default;
+
+    // The identifiers of the contacts are only unique on a device.
+    static uint64_t touchId( const Device& d, int32_t contact ) noexcept
+    {
+        return static_cast<uint64_t>( d.id ) << 32 | static_cast<uint32_t>( contact );
+    }
+
+    void report( Device& d, uint64_t timestamp ) noexcept
+    {
+        for ( auto& slot: d.slots )
+        {
+            if ( slot.contact != slot.trackingId )
+            {
+                // A slot can be lifted and reused by a new contact in the same frame.
+                if ( slot.contact >= 0 )
+                    push( EventType::TouchUp, d, slot, slot.contact, timestamp );
+                if ( slot.trackingId >= 0 )
+                    push( EventType::TouchDown, d, slot, slot.trackingId, timestamp );
+
+                slot.contact = slot.trackingId;
+            }
+            else if ( slot.changed && slot.contact >= 0 )
+            {
+                push( EventType::TouchMotion, d, slot, slot.contact, timestamp );
+            }
+
+            slot.changed = false;
+        }
+    }
+
+    void push( EventType type, const Device& d, const Slot& slot, int32_t contact, uint64_t timestamp ) noexcept
+    {
+        const uint64_t id       = touchId( d, contact );
+        const float    x        = Normalize( slot.x, d.x );
+        const float    y        = Normalize( slot.y, d.y );
+        const float    pressure = d.touchPressure.maximum > d.touchPressure.minimum ? Normalize( slot.pressure, d.touchPressure ) : 1.0f;
+
+        if ( type == EventType::TouchDown )
+        {
+            Touch::TouchPoint touch;
+            touch.id        = id;
+            touch.timestamp = timestamp;
+            touch.x         = x;
+            touch.y         = y;
+            touch.pressure  = pressure;
+            touch.phase     = Touch::Phase::Began;
+            m_Touches.push_back( touch );
+        }
+        else if ( auto it = std::ranges::find_if( m_Touches, [&]( const Touch::TouchPoint& t ) { return t.id == id; } ); it != m_Touches.end() )
+        {
+            it->x = x;
+            it->y = y;
+
+            if ( type == EventType::TouchMotion )
+            {
+                it->timestamp = timestamp;
+                it->pressure  = pressure;
+                it->phase     = Touch::Phase::Moved;
+            }
+            else
+            {
+                // Keep the touch for one more frame so it can be detected as Released.
+                // It will be removed when endFrame is called.
+                it->pressure = 0.0f;
+                it->phase    = Touch::Phase::Ended;
+            }
+        }
+
+        Event e {};
+        e.type           = type;
+        e.timestamp      = timestamp;
+        e.touch.id       = static_cast<int64_t>( id );
+        e.touch.x        = x;
+        e.touch.y        = y;
+        e.touch.pressure = type == EventType::TouchUp ? 0.0f : pressure;
+        EventQueue::get().push( e );
+    }
+
+    std::vector<Device> m_Devices;
+    Touch::TouchList    m_Touches;
+    mutable Mutex       m_Mutex;
+};
+
+namespace input::Touch
+{
+
+State getState()
+{
+    INPUT_PROFILE_SCOPE( TouchGetState );
+
+    Evdev::detail::startReader();
+    return TouchEvdev::get().getState();
+}
+
+void endFrame()
+{
+    TouchEvdev::get().endFrame();
+}
+
+bool isSupported()
+{
+    Evdev::detail::startReader();
+    return TouchEvdev::get().isSupported();
+}
+
+int getDeviceCount()
+{
+    Evdev::detail::startReader();
+    return TouchEvdev::get().getDeviceCount();
+}
+
+}  // namespace input::Touch
+
+void Evdev::detail::connectTouch( int device, int fd, const DeviceInfo& info )
+{
+    TouchEvdev::get().connect( device, fd, info );
+}
+
+void Evdev::detail::disconnectTouch( int device )
+{
+    TouchEvdev::get().disconnect( device );
+}
+
+void Evdev::detail::applyTouchEvents( int device, std::span<const input_event> events ) noexcept
+{
+    TouchEvdev::get().apply( device, events );
+}
@@ -1,4 +1,5 @@
 #include <input/Gamepad.hpp>
+#include <input/Profiler.hpp>
 
 #include <GameInput.h>
 #include <wrl.h>
@@ -245,6 +246,8 @@ private:
 
 Gamepad::State Gamepad::getState( int playerIndex, DeadZone deadZoneMode )
 {
+    INPUT_PROFILE_SCOPE( GamepadGetState );
+
     return GamepadGDK::get().getState( playerIndex, deadZoneMode );
 }
 
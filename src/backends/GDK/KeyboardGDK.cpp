@@ -1,8 +1,11 @@
+#include <input/EventQueue.hpp>
 #include <input/Keyboard.hpp>
+#include <input/Profiler.hpp>
 
 #include <GameInput.h>
 #include <wrl.h>
 
+#include <chrono>
 #include <format>
 #include <iostream>
 #include <stdexcept>
@@ -194,6 +197,8 @@ namespace input::Keyboard
 {
 State getState()
 {
+    INPUT_PROFILE_SCOPE( KeyboardGetState );
+
     return KeyboardGDK::get().getState();
 }
 
@@ -207,6 +212,18 @@ bool isConnected()
 
 }  // namespace input::Keyboard
 
+uint64_t input::getEventTime() noexcept
+{
+    // The GDK backend does not generate events, so use the same clock as the touch timestamps.
+    using namespace std::chrono;
+    return duration_cast<nanoseconds>( steady_clock::now().time_since_epoch() ).count();
+}
+
+void input::beginFrame() noexcept
+{
+    // The device states are read in getState.
+}
+
 void Keyboard_ProcessMessage( UINT message, WPARAM wParam, LPARAM lParam )  // NOLINT(misc-use-internal-linkage)
 {
     // GameInput for Keyboard doesn't require Win32 messages, but this simplifies integration.
@@ -1,4 +1,5 @@
 #include <input/Mouse.hpp>
+#include <input/Profiler.hpp>
 
 #include <GameInput.h>
 #include <wrl.h>
@@ -463,6 +464,8 @@ namespace input::Mouse
 {
 State getState()
 {
+    INPUT_PROFILE_SCOPE( MouseGetState );
+
     return MouseGDK::get().getState();
 }
 
@@ -481,6 +484,17 @@ void resetRelativeMotion() noexcept
     MouseGDK::get().resetRelativeMotion();
 }
 
+std::span<const MotionSample> getMotionHistory() noexcept
+{
+    // The motion history is not recorded by this backend.
+    return {};
+}
+
+uint32_t getDroppedMotionSamples() noexcept
+{
+    return 0;
+}
+
 bool isConnected()
 {
     return MouseGDK::get().isConnected();
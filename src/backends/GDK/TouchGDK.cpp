@@ -1,13 +1,15 @@
+#include <input/Profiler.hpp>
 #include <input/Touch.hpp>
 
 #include <GameInput.h>
 #include <wrl.h>
 
+#include <algorithm>
 #include <chrono>
 #include <format>
 #include <iostream>
+#include <span>
 #include <stdexcept>
-#include <vector>
 
 using namespace input;
 using namespace Microsoft::WRL;
@@ -45,10 +47,10 @@ public:
             uint32_t touchCount = reading->GetTouchCount();
             if ( touchCount > 0 )
             {
-                std::vector<GameInputTouchState> touchStates( touchCount );
-                touchCount = reading->GetTouchState( touchCount, touchStates.data() );
+                GameInputTouchState touchStates[Touch::MAX_TOUCH_COUNT];
+                touchCount = reading->GetTouchState( std::min<uint32_t>( touchCount, Touch::MAX_TOUCH_COUNT ), touchStates );
 
-                for ( const GameInputTouchState& touchState: touchStates )
+                for ( const GameInputTouchState& touchState: std::span { touchStates, touchCount } )
                 {
                     // Check to see if we are already tracking this touch point.
                     auto it = std::ranges::find_if( m_Touches, [&]( const Touch::TouchPoint& t ) {
@@ -93,10 +95,10 @@ public:
     void endFrame()
     {
         // Remove ended touches
-        std::erase_if( m_Touches,
-                       []( const Touch::TouchPoint& t ) {
-                           return t.phase == Touch::Phase::Ended || t.phase == Touch::Phase::Cancelled;
-                       } );
+        erase_if( m_Touches,
+                  []( const Touch::TouchPoint& t ) {
+                      return t.phase == Touch::Phase::Ended || t.phase == Touch::Phase::Cancelled;
+                  } );
 
         // Update phase for touches that haven't changed
         for ( auto& touch: m_Touches )
@@ -180,7 +182,7 @@ private:
     ComPtr<IGameInput>             m_GameInput;
     GameInputCallbackToken         m_CallbackToken {};
     uint32_t                       m_Connected = 0;
-    std::vector<Touch::TouchPoint> m_Touches;
+    Touch::TouchList               m_Touches;
 };
 
 namespace input::Touch
@@ -188,6 +190,8 @@ namespace input::Touch
 
 State getState()
 {
+    INPUT_PROFILE_SCOPE( TouchGetState );
+
     return TouchGDK::get().getState();
 }
 
@@ -1,4 +1,5 @@
 #include <input/Gamepad.hpp>
+#include <input/Profiler.hpp>
 
 #include <GLFW/glfw3.h>
 
@@ -120,6 +121,8 @@ private:
 
 Gamepad::State Gamepad::getState( int playerIndex, DeadZone deadZoneMode )
 {
+    INPUT_PROFILE_SCOPE( GamepadGetState );
+
     return GamepadGLFW::get().getState( playerIndex, deadZoneMode );
 }
 
@@ -1,4 +1,6 @@
+#include <input/EventQueue.hpp>
 #include <input/Keyboard.hpp>
+#include <input/Profiler.hpp>
 #include <GLFW/glfw3.h>
 #include <mutex>
 
@@ -215,7 +217,7 @@ private:
     KeyboardGLFW() = default;
     ~KeyboardGLFW() = default;
 
-    mutable std::mutex m_Mutex;
+    mutable Mutex m_Mutex;
     Keyboard::State m_State{};
 };
 
@@ -238,12 +240,24 @@ void Keyboard_Callback(GLFWwindow* /*window*/, int key, int /*scancode*/, int ac
         KeyUp(vk, impl.m_State);
     }
     // GLFW_REPEAT is ignored for state
+
+    if (action == GLFW_PRESS || action == GLFW_RELEASE)
+    {
+        // GLFW does not timestamp events, so use the time of the callback.
+        Event e{};
+        e.type      = action == GLFW_PRESS ? EventType::KeyDown : EventType::KeyUp;
+        e.timestamp = getEventTime();
+        e.key.key   = static_cast<Keyboard::Key>(vk);
+        EventQueue::get().push(e);
+    }
 }
 
 namespace input::Keyboard
 {
 State getState()
 {
+    INPUT_PROFILE_SCOPE(KeyboardGetState);
+
     return KeyboardGLFW::get().getState();
 }
 
@@ -257,3 +271,17 @@ bool isConnected()
     return KeyboardGLFW::isConnected();
 }
 }  // namespace input::Keyboard
+
+uint64_t input::getEventTime() noexcept
+{
+    const uint64_t value     = glfwGetTimerValue();
+    const uint64_t frequency = glfwGetTimerFrequency();
+
+    // Convert the whole seconds separately so that the result does not overflow.
+    return value / frequency * 1000000000ull + value % frequency * 1000000000ull / frequency;
+}
+
+void input::beginFrame() noexcept
+{
+    // The events are received by the GLFW callbacks.
+}
@@ -1,4 +1,6 @@
+#include <input/EventQueue.hpp>
 #include <input/Mouse.hpp>
+#include <input/Profiler.hpp>
 
 #include <GLFW/glfw3.h>
 
@@ -76,6 +78,8 @@ public:
     void resetRelativeMotion() noexcept
     {
         std::scoped_lock lock( m_Mutex );
+        m_Motion.endFrame();
+
         if ( m_Mode == Mouse::Mode::Relative )
         {
             m_RelativeX = 0;
@@ -83,6 +87,18 @@ public:
         }
     }
 
+    std::span<const Mouse::MotionSample> getMotionHistory() const noexcept
+    {
+        std::scoped_lock lock( m_Mutex );
+        return m_Motion.getSamples();
+    }
+
+    uint32_t getDroppedMotionSamples() const noexcept
+    {
+        std::scoped_lock lock( m_Mutex );
+        return m_Motion.getDroppedCount();
+    }
+
     static bool isConnected()
     {
         return true;
@@ -117,15 +133,28 @@ private:
     MouseGLFW()  = default;
     ~MouseGLFW() = default;
 
-    mutable std::mutex m_Mutex;
+    uint8_t getButtons() const noexcept
+    {
+        uint8_t result = 0;
+        result |= m_State.leftButton ? 1u << static_cast<int>( Mouse::Button::Left ) : 0u;
+        result |= m_State.rightButton ? 1u << static_cast<int>( Mouse::Button::Right ) : 0u;
+        result |= m_State.middleButton ? 1u << static_cast<int>( Mouse::Button::Middle ) : 0u;
+        result |= m_State.xButton1 ? 1u << static_cast<int>( Mouse::Button::XButton1 ) : 0u;
+        result |= m_State.xButton2 ? 1u << static_cast<int>( Mouse::Button::XButton2 ) : 0u;
+
+        return result;
+    }
+
+    mutable Mutex m_Mutex;
 
-    Mouse::Mode  m_Mode      = Mouse::Mode::Absolute;
-    float        m_RelativeX = 0.0f;
-    float        m_RelativeY = 0.0f;
-    double       m_LastX     = 0.0f;
-    double       m_LastY     = 0.0f;
-    GLFWwindow*  m_Window    = nullptr;
-    Mouse::State m_State {};
+    Mouse::Mode          m_Mode      = Mouse::Mode::Absolute;
+    float                m_RelativeX = 0.0f;
+    float                m_RelativeY = 0.0f;
+    double               m_LastX     = 0.0f;
+    double               m_LastY     = 0.0f;
+    GLFWwindow*          m_Window    = nullptr;
+    Mouse::State         m_State {};
+    Mouse::MotionHistory m_Motion;
 };
 
 // GLFW scroll callback function (outside the class)
@@ -134,6 +163,12 @@ void Mouse_ScrollCallback( GLFWwindow* /*window*/, double /*xoffset*/, double yo
     auto&            impl = MouseGLFW::get();
     std::scoped_lock lock( impl.m_Mutex );
     impl.m_State.scrollWheelValue += static_cast<int>( yoffset * 120 );  // 120 is Win32/DirectX standard
+
+    Event e {};
+    e.type             = EventType::MouseWheel;
+    e.timestamp        = getEventTime();
+    e.mouseWheel.delta = static_cast<int32_t>( yoffset * 120 );
+    EventQueue::get().push( e );
 }
 
 // GLFW cursor position callback function (outside the class)
@@ -152,6 +187,21 @@ void Mouse_CursorPosCallback( GLFWwindow* /*window*/, double x, double y )
         impl.m_State.y = static_cast<float>( y );
     }
 
+    // GLFW does not timestamp events, so use the time of the callback.
+    const Mouse::MotionSample sample { getEventTime(),
+                                       static_cast<float>( x ),
+                                       static_cast<float>( y ),
+                                       static_cast<float>( x - impl.m_LastX ),
+                                       static_cast<float>( y - impl.m_LastY ),
+                                       impl.getButtons() };
+    impl.m_Motion.add( sample );
+
+    Event e {};
+    e.type        = EventType::MouseMotion;
+    e.timestamp   = sample.timestamp;
+    e.mouseMotion = { sample.x, sample.y, sample.deltaX, sample.deltaY };
+    EventQueue::get().push( e );
+
     impl.m_LastX = x;
     impl.m_LastY = y;
 }
@@ -162,27 +212,39 @@ void Mouse_ButtonCallback( GLFWwindow* /*window*/, int button, int action, int /
     auto&            impl = MouseGLFW::get();
     std::scoped_lock lock( impl.m_Mutex );
     bool             pressed = ( action == GLFW_PRESS );
+    Event            e {};
 
     switch ( button )
     {
     case GLFW_MOUSE_BUTTON_LEFT:
         impl.m_State.leftButton = pressed;
+        e.mouseButton.button    = Mouse::Button::Left;
         break;
     case GLFW_MOUSE_BUTTON_RIGHT:
         impl.m_State.rightButton = pressed;
+        e.mouseButton.button     = Mouse::Button::Right;
         break;
     case GLFW_MOUSE_BUTTON_MIDDLE:
         impl.m_State.middleButton = pressed;
+        e.mouseButton.button      = Mouse::Button::Middle;
         break;
     case GLFW_MOUSE_BUTTON_4:
         impl.m_State.xButton1 = pressed;
+        e.mouseButton.button  = Mouse::Button::XButton1;
         break;
     case GLFW_MOUSE_BUTTON_5:
         impl.m_State.xButton2 = pressed;
+        e.mouseButton.button  = Mouse::Button::XButton2;
         break;
     default:
-        break;
+        return;
     }
+
+    e.type          = pressed ? EventType::MouseButtonDown : EventType::MouseButtonUp;
+    e.timestamp     = getEventTime();
+    e.mouseButton.x = static_cast<float>( impl.m_LastX );
+    e.mouseButton.y = static_cast<float>( impl.m_LastY );
+    EventQueue::get().push( e );
 }
 
 namespace input::Mouse
@@ -190,6 +252,8 @@ namespace input::Mouse
 // Bridge to Mouse interface
 State getState()
 {
+    INPUT_PROFILE_SCOPE( MouseGetState );
+
     return MouseGLFW::get().getState();
 }
 
@@ -208,6 +272,16 @@ void resetRelativeMotion() noexcept
     MouseGLFW::get().resetRelativeMotion();
 }
 
+std::span<const MotionSample> getMotionHistory() noexcept
+{
+    return MouseGLFW::get().getMotionHistory();
+}
+
+uint32_t getDroppedMotionSamples() noexcept
+{
+    return MouseGLFW::get().getDroppedMotionSamples();
+}
+
 bool isConnected()
 {
     return MouseGLFW::isConnected();
@@ -1,3 +1,4 @@
+#include <input/Profiler.hpp>
 #include <input/Touch.hpp>
 
 using namespace input;
@@ -17,6 +18,8 @@ namespace input::Touch
 
 State getState()
 {
+    INPUT_PROFILE_SCOPE( TouchGetState );
+
     // Return empty state - no touch support
     State state {};
     return state;
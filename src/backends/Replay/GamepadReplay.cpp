@@ -0,0 +1,34 @@
+#include <input/Gamepad.hpp>
+#include <input/Profiler.hpp>
+#include <input/Replay.hpp>
+
+using namespace input;
+
+constexpr float ReplayThumbDeadZone = 0.24f;  // Consistent with XboxOneThumbDeadZone
+
+// Bridge to Gamepad interface
+Gamepad::State Gamepad::getState( int playerIndex, DeadZone deadZoneMode )
+{
+    INPUT_PROFILE_SCOPE( GamepadGetState );
+
+    // The thumbsticks are recorded raw, so the dead zone is applied here (the same as the other backends).
+    Gamepad::State state = Replay::detail::getGamepadState( playerIndex );
+
+    const Gamepad::ThumbSticks raw = state.thumbSticks;
+    ApplyStickDeadZone( raw.leftX, raw.leftY, deadZoneMode, 1.0f, ReplayThumbDeadZone, state.thumbSticks.leftX, state.thumbSticks.leftY );
+    ApplyStickDeadZone( raw.rightX, raw.rightY, deadZoneMode, 1.0f, ReplayThumbDeadZone, state.thumbSticks.rightX, state.thumbSticks.rightY );
+
+    return state;
+}
+
+bool Gamepad::setVibration( int playerIndex, float /*leftMotor*/, float /*rightMotor*/, float /*leftTrigger*/, float /*rightTrigger*/ )
+{
+    // The replayed gamepads do not vibrate, but report success if the gamepad is connected.
+    return Replay::detail::getGamepadState( playerIndex ).connected;
+}
+
+void Gamepad::suspend() noexcept
+{}
+
+void Gamepad::resume() noexcept
+{}
@@ -0,0 +1,26 @@
+#include <input/Keyboard.hpp>
+#include <input/Profiler.hpp>
+#include <input/Replay.hpp>
+
+using namespace input;
+
+namespace input::Keyboard
+{
+State getState()
+{
+    INPUT_PROFILE_SCOPE( KeyboardGetState );
+
+    return Replay::detail::getKeyboardState();
+}
+
+void reset()
+{
+    // The keys are set by the recording.
+}
+
+bool isConnected()
+{
+    return Replay::detail::isPlaying();
+}
+
+}  // namespace input::Keyboard
@@ -0,0 +1,126 @@
+#include <input/Mouse.hpp>
+#include <input/Profiler.hpp>
+#include <input/Replay.hpp>
+
+#include <atomic>
+#include <mutex>
+
+using namespace input;
+
+// The mouse state is replayed from the recording. Only the motion history (which is not recorded) is
+// rebuilt from the replayed motion events.
+class MouseReplay
+{
+public:
+    static MouseReplay& get()
+    {
+        static MouseReplay instance;
+        return instance;
+    }
+
+    void addMotionSample( const Mouse::MotionSample& sample ) noexcept
+    {
+        std::scoped_lock lock( m_Mutex );
+        m_Motion.add( sample );
+    }
+
+    void resetRelativeMotion() noexcept
+    {
+        std::scoped_lock lock( m_Mutex );
+        m_Motion.endFrame();
+    }
+
+    std::span<const Mouse::MotionSample> getMotionHistory() const noexcept
+    {
+        std::scoped_lock lock( m_Mutex );
+        return m_Motion.getSamples();
+    }
+
+    uint32_t getDroppedMotionSamples() const noexcept
+    {
+        std::scoped_lock lock( m_Mutex );
+        return m_Motion.getDroppedCount();
+    }
+
+    bool isVisible() const noexcept
+    {
+        return m_Visible;
+    }
+
+    void setVisible( bool visible ) noexcept
+    {
+        m_Visible = visible;
+    }
+
+    MouseReplay( const MouseReplay& )            = delete;
+    MouseReplay( MouseReplay&& )                 = delete;
+    MouseReplay& operator=( const MouseReplay& ) = delete;
+    MouseReplay& operator=( MouseReplay&& )      = delete;
+
+private:
+    MouseReplay()  = default;
+    ~MouseReplay() = default;
+
+    std::atomic<bool>    m_Visible { true };
+    Mouse::MotionHistory m_Motion;
+    mutable Mutex        m_Mutex;
+};
+
+namespace input::Mouse
+{
+State getState()
+{
+    INPUT_PROFILE_SCOPE( MouseGetState );
+
+    return Replay::detail::getMouseState();
+}
+
+void resetScrollWheelValue() noexcept
+{
+    // The scroll wheel value is set by the recording.
+}
+
+void setMode( Mode /*mode*/ )
+{
+    // The position mode is set by the recording.
+}
+
+void resetRelativeMotion() noexcept
+{
+    MouseReplay::get().resetRelativeMotion();
+}
+
+std::span<const MotionSample> getMotionHistory() noexcept
+{
+    return MouseReplay::get().getMotionHistory();
+}
+
+uint32_t getDroppedMotionSamples() noexcept
+{
+    return MouseReplay::get().getDroppedMotionSamples();
+}
+
+bool isConnected()
+{
+    return Replay::detail::isPlaying();
+}
+
+bool isVisible() noexcept
+{
+    return MouseReplay::get().isVisible();
+}
+
+void setVisible( bool visible )
+{
+    MouseReplay::get().setVisible( visible );
+}
+
+void setWindow( void* /*window*/ )
+{}
+
+}  // namespace input::Mouse
+
+void Replay::detail::addMotionSample( const Mouse::MotionSample& sample ) noexcept
+{
+    MouseReplay::get().addMotionSample( sample );
+}
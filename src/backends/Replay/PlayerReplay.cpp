@@ -0,0 +1,277 @@
+#include <input/EventQueue.hpp>
+#include <input/Profiler.hpp>
+#include <input/Recording.hpp>
+#include <input/Replay.hpp>
+
+#include <algorithm>
+#include <atomic>
+#include <mutex>
+
+using namespace input;
+
+class PlayerReplay
+{
+public:
+    static PlayerReplay& get()
+    {
+        static PlayerReplay instance;
+        return instance;
+    }
+
+    bool open( const std::string& path )
+    {
+        std::scoped_lock lock( m_Mutex );
+
+        m_Frame             = {};
+        m_FrameIndex        = 0;
+        m_MostRecentGamepad = 0;
+
+        return m_Reader.open( path );
+    }
+
+    void close()
+    {
+        std::scoped_lock lock( m_Mutex );
+
+        m_Reader.close();
+        m_Frame      = {};
+        m_FrameIndex = 0;
+    }
+
+    uint64_t getFrameCount() const
+    {
+        std::scoped_lock lock( m_Mutex );
+        return m_Reader.getFrameCount();
+    }
+
+    uint64_t getFrameIndex() const
+    {
+        std::scoped_lock lock( m_Mutex );
+        return m_FrameIndex;
+    }
+
+    bool seek( uint64_t frame )
+    {
+        std::scoped_lock lock( m_Mutex );
+
+        if ( !m_Reader.isOpen() || frame > m_Reader.getFrameCount() )
+            return false;
+
+        m_FrameIndex = frame;
+        return true;
+    }
+
+    bool isFinished() const
+    {
+        std::scoped_lock lock( m_Mutex );
+        return m_FrameIndex >= m_Reader.getFrameCount();
+    }
+
+    bool isPlaying() const
+    {
+        std::scoped_lock lock( m_Mutex );
+        return m_Reader.isOpen();
+    }
+
+    Keyboard::State getKeyboardState() const
+    {
+        std::scoped_lock lock( m_Mutex );
+        return m_Frame.keyboard;
+    }
+
+    Mouse::State getMouseState() const
+    {
+        std::scoped_lock lock( m_Mutex );
+        return m_Frame.mouse;
+    }
+
+    Gamepad::State getGamepadState( int player ) const
+    {
+        std::scoped_lock lock( m_Mutex );
+
+        if ( player == Gamepad::MOST_RECENT_PLAYER )
+            player = m_MostRecentGamepad;
+
+        if ( player < 0 || player >= Gamepad::MAX_PLAYER_COUNT )
+            return {};
+
+        return m_Frame.gamepads[player];
+    }
+
+    Touch::State getTouchState() const
+    {
+        std::scoped_lock lock( m_Mutex );
+        return m_Frame.touch;
+    }
+
+    // Not locked, because the event queue reads the clock (with the latency probe) while advance holds the lock.
+    uint64_t getTime() const noexcept
+    {
+        return m_Time.load( std::memory_order_relaxed );
+    }
+
+    // Read the next frame and add its events to the event queue.
+    void advance()
+    {
+        std::scoped_lock lock( m_Mutex );
+
+        // The buttons of the previous frame are the buttons before the events of this frame.
+        const Mouse::State& mouse   = m_Frame.mouse;
+        uint8_t             buttons = ( mouse.leftButton ? buttonBit( Mouse::Button::Left ) : 0 ) | ( mouse.rightButton ? buttonBit( Mouse::Button::Right ) : 0 ) |
+                          ( mouse.middleButton ? buttonBit( Mouse::Button::Middle ) : 0 ) | ( mouse.xButton1 ? buttonBit( Mouse::Button::XButton1 ) : 0 ) |
+                          ( mouse.xButton2 ? buttonBit( Mouse::Button::XButton2 ) : 0 );
+
+        Gamepad::State gamepads[Gamepad::MAX_PLAYER_COUNT];
+        std::ranges::copy( m_Frame.gamepads, gamepads );
+
+        if ( m_FrameIndex >= m_Reader.getFrameCount() || !m_Reader.read( m_FrameIndex, m_Frame ) )
+        {
+            // The devices are released after the last frame (or if the file is corrupt).
+            m_Frame      = {};
+            m_FrameIndex = m_Reader.getFrameCount();
+            return;
+        }
+
+        ++m_FrameIndex;
+        m_Time.store( m_Frame.timestamp, std::memory_order_relaxed );
+
+        // The most recent gamepad is the last one that was connected or reported a new packet (or an event).
+        for ( int i = 0; i < Gamepad::MAX_PLAYER_COUNT; ++i )
+        {
+            const Gamepad::State& gamepad = m_Frame.gamepads[i];
+            if ( gamepad.connected && ( !gamepads[i].connected || gamepad.packet != gamepads[i].packet ) )
+                m_MostRecentGamepad = i;
+        }
+
+        // The motion history is not recorded, so the samples are rebuilt from the motion events (with the
+        // buttons that were down at each event).
+
+        EventQueue& queue = EventQueue::get();
+        for ( auto& event: m_Frame.events )
+        {
+            if ( event.type == EventType::MouseButtonDown || event.type == EventType::MouseButtonUp )
+            {
+                const uint8_t bit = buttonBit( event.mouseButton.button );
+                buttons           = event.type == EventType::MouseButtonDown ? buttons | bit : buttons & ~bit;
+            }
+            else if ( event.type == EventType::MouseMotion )
+            {
+                Replay::detail::addMotionSample( { event.timestamp, event.mouseMotion.x, event.mouseMotion.y, event.mouseMotion.deltaX, event.mouseMotion.deltaY, buttons } );
+            }
+            else if ( event.type == EventType::GamepadButtonDown || event.type == EventType::GamepadButtonUp )
+            {
+                setMostRecentGamepad( event.gamepadButton.player );
+            }
+            else if ( event.type == EventType::GamepadAxis )
+            {
+                setMostRecentGamepad( event.gamepadAxis.player );
+            }
+
+            queue.push( event );
+        }
+    }
+
+    PlayerReplay( const PlayerReplay& )            = delete;
+    PlayerReplay( PlayerReplay&& )                 = delete;
+    PlayerReplay& operator=( const PlayerReplay& ) = delete;
+    PlayerReplay& operator=( PlayerReplay&& )      = delete;
+
+private:
+    PlayerReplay()  = default;
+    ~PlayerReplay() = default;
+
+    void setMostRecentGamepad( int player ) noexcept
+    {
+        if ( player >= 0 && player < Gamepad::MAX_PLAYER_COUNT && m_Frame.gamepads[player].connected )
+            m_MostRecentGamepad = player;
+    }
+
+    static uint8_t buttonBit( Mouse::Button button ) noexcept
+    {
+        return static_cast<uint8_t>( 1u << static_cast<int>( button ) );
+    }
+
+    RecordingReader m_Reader;
+    RecordedFrame   m_Frame;
+    uint64_t        m_FrameIndex        = 0;  ///< The frame that is read by the next call to advance.
+    int             m_MostRecentGamepad = 0;
+    mutable Mutex   m_Mutex;
+
+    // The timestamp of the replayed frame (the clock of getEventTime). It is not reset after the last frame,
+    // so the clock does not go back.
+    std::atomic<uint64_t> m_Time { 0 };
+};
+
+namespace input::Replay
+{
+
+bool open( const std::string& path )
+{
+    return PlayerReplay::get().open( path );
+}
+
+void close()
+{
+    PlayerReplay::get().close();
+}
+
+uint64_t getFrameCount()
+{
+    return PlayerReplay::get().getFrameCount();
+}
+
+uint64_t getFrameIndex()
+{
+    return PlayerReplay::get().getFrameIndex();
+}
+
+bool seek( uint64_t frame )
+{
+    return PlayerReplay::get().seek( frame );
+}
+
+bool isFinished()
+{
+    return PlayerReplay::get().isFinished();
+}
+
+}  // namespace input::Replay
+
+Keyboard::State Replay::detail::getKeyboardState() noexcept
+{
+    return PlayerReplay::get().getKeyboardState();
+}
+
+Mouse::State Replay::detail::getMouseState() noexcept
+{
+    return PlayerReplay::get().getMouseState();
+}
+
+Gamepad::State Replay::detail::getGamepadState( int player ) noexcept
+{
+    return PlayerReplay::get().getGamepadState( player );
+}
+
+Touch::State Replay::detail::getTouchState() noexcept
+{
+    return PlayerReplay::get().getTouchState();
+}
+
+bool Replay::detail::isPlaying() noexcept
+{
+    return PlayerReplay::get().isPlaying();
+}
+
+void input::beginFrame() noexcept
+{
+    // Input::update calls beginFrame before Mouse::resetRelativeMotion, so the motion samples of the frame are
+    // added before the motion history of the frame is completed.
+    PlayerReplay::get().advance();
+}
+
+uint64_t input::getEventTime() noexcept
+{
+    // The clock is the recorded time of the replayed frame, so everything that is timed with it in Input::update
+    // (for example, the gestures) sees the same times as in the recorded run.
+    return PlayerReplay::get().getTime();
+}
@@ -0,0 +1,32 @@
+#include <input/Profiler.hpp>
+#include <input/Replay.hpp>
+#include <input/Touch.hpp>
+
+using namespace input;
+
+namespace input::Touch
+{
+
+State getState()
+{
+    INPUT_PROFILE_SCOPE( TouchGetState );
+
+    return Replay::detail::getTouchState();
+}
+
+void endFrame()
+{
+    // The touch points are set by the recording.
+}
+
+bool isSupported()
+{
+    return Replay::detail::isPlaying();
+}
+
+int getDeviceCount()
+{
+    return Replay::detail::isPlaying() ? 1 : 0;
+}
+
+}  // namespace input::Touch
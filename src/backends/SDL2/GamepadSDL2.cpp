@@ -1,4 +1,6 @@
+#include <input/EventQueue.hpp>
 #include <input/Gamepad.hpp>
+#include <input/Profiler.hpp>
 
 #include <SDL.h>
 
@@ -9,6 +11,47 @@ using namespace input;
 
 constexpr float SDLThumbDeadZone = 0.24f;  // Consistent with XboxOneThumbDeadZone
 
+namespace
+{
+// Map an SDL game controller button to a Gamepad::Button (or Gamepad::Button::Count if the button is not supported).
+Gamepad::Button SDLButtonToButton( Uint8 button ) noexcept
+{
+    switch ( button )
+    {
+    case SDL_CONTROLLER_BUTTON_A:
+        return Gamepad::Button::A;
+    case SDL_CONTROLLER_BUTTON_B:
+        return Gamepad::Button::B;
+    case SDL_CONTROLLER_BUTTON_X:
+        return Gamepad::Button::X;
+    case SDL_CONTROLLER_BUTTON_Y:
+        return Gamepad::Button::Y;
+    case SDL_CONTROLLER_BUTTON_LEFTSTICK:
+        return Gamepad::Button::LeftStick;
+    case SDL_CONTROLLER_BUTTON_RIGHTSTICK:
+        return Gamepad::Button::RightStick;
+    case SDL_CONTROLLER_BUTTON_LEFTSHOULDER:
+        return Gamepad::Button::LeftShoulder;
+    case SDL_CONTROLLER_BUTTON_RIGHTSHOULDER:
+        return Gamepad::Button::RightShoulder;
+    case SDL_CONTROLLER_BUTTON_BACK:
+        return Gamepad::Button::Back;
+    case SDL_CONTROLLER_BUTTON_START:
+        return Gamepad::Button::Start;
+    case SDL_CONTROLLER_BUTTON_DPAD_UP:
+        return Gamepad::Button::DPadUp;
+    case SDL_CONTROLLER_BUTTON_DPAD_DOWN:
+        return Gamepad::Button::DPadDown;
+    case SDL_CONTROLLER_BUTTON_DPAD_LEFT:
+        return Gamepad::Button::DPadLeft;
+    case SDL_CONTROLLER_BUTTON_DPAD_RIGHT:
+        return Gamepad::Button::DPadRight;
+    default:
+        return Gamepad::Button::Count;
+    }
+}
+}  // namespace
+
 class GamepadSDL2
 {
 public:
@@ -134,6 +177,8 @@ public:
 private:
     static int SDLEventWatch( void* userdata, SDL_Event* event )
     {
+        INPUT_PROFILE_COUNT( GamepadWatchEvents );
+
         auto* self = static_cast<GamepadSDL2*>( userdata );
 
         if ( event->type == SDL_CONTROLLERDEVICEADDED )
@@ -161,6 +206,33 @@ private:
                 }
             }
         }
+        else if ( event->type == SDL_CONTROLLERBUTTONDOWN || event->type == SDL_CONTROLLERBUTTONUP )
+        {
+            // SDL2 event timestamps are in milliseconds.
+            Event e {};
+            e.type                 = event->type == SDL_CONTROLLERBUTTONDOWN ? EventType::GamepadButtonDown : EventType::GamepadButtonUp;
+            e.timestamp            = static_cast<uint64_t>( event->cbutton.timestamp ) * 1000000;
+            e.gamepadButton.player = self->findPlayer( event->cbutton.which );
+            e.gamepadButton.button = SDLButtonToButton( event->cbutton.button );
+
+            if ( e.gamepadButton.player >= 0 && e.gamepadButton.button != Gamepad::Button::Count )
+                EventQueue::get().push( e );
+        }
+        else if ( event->type == SDL_CONTROLLERAXISMOTION )
+        {
+            Event e {};
+            e.type               = EventType::GamepadAxis;
+            e.timestamp          = static_cast<uint64_t>( event->caxis.timestamp ) * 1000000;
+            e.gamepadAxis.player = self->findPlayer( event->caxis.which );
+            e.gamepadAxis.value  = static_cast<float>( event->caxis.value ) / 32767.0f;
+
+            // The axes of SDL_GameControllerAxis are in the same order as GamepadAxis.
+            if ( e.gamepadAxis.player >= 0 && event->caxis.axis <= SDL_CONTROLLER_AXIS_TRIGGERRIGHT )
+            {
+                e.gamepadAxis.axis = static_cast<GamepadAxis>( event->caxis.axis );
+                EventQueue::get().push( e );
+            }
+        }
         else if ( event->type == SDL_CONTROLLERDEVICEREMOVED )
         {
             std::scoped_lock lock( self->m_Mutex );
@@ -179,6 +251,20 @@ private:
         return 0;
     }
 
+    // Find the player slot of a game controller, or -1 if the controller is not open.
+    int findPlayer( SDL_JoystickID joyId ) const
+    {
+        std::scoped_lock lock( m_Mutex );
+
+        for ( int i = 0; i < Gamepad::MAX_PLAYER_COUNT; ++i )
+        {
+            if ( m_Controllers[i] && SDL_JoystickInstanceID( SDL_GameControllerGetJoystick( m_Controllers[i] ) ) == joyId )
+                return i;
+        }
+
+        return -1;
+    }
+
     GamepadSDL2()
     {
         if ( SDL_WasInit( SDL_INIT_GAMECONTROLLER ) == 0 )
@@ -218,12 +304,14 @@ private:
 
     std::array<SDL_GameController*, Gamepad::MAX_PLAYER_COUNT> m_Controllers       = {};
     int                                                        m_MostRecentGamepad = 0;
-    mutable std::mutex                                         m_Mutex;
+    mutable Mutex                                              m_Mutex;
 };
 
 // Bridge to Gamepad interface
 Gamepad::State Gamepad::getState( int playerIndex, DeadZone deadZoneMode )
 {
+    INPUT_PROFILE_SCOPE( GamepadGetState );
+
     return GamepadSDL2::get().getState( playerIndex, deadZoneMode );
 }
 
@@ -1,4 +1,6 @@
+#include <input/EventQueue.hpp>
 #include <input/Keyboard.hpp>
+#include <input/Profiler.hpp>
 
 #include <SDL.h>
 
@@ -427,16 +429,47 @@ public:
     KeyboardSDL2& operator=( KeyboardSDL2&& )      = delete;
 
 private:
-    KeyboardSDL2()  = default;
-    ~KeyboardSDL2() = default;
+    static int SDLEventWatch( void* /*userdata*/, SDL_Event* event )
+    {
+        INPUT_PROFILE_COUNT( KeyboardWatchEvents );
+
+        // Key repeats are not reported.
+        if ( ( event->type == SDL_KEYDOWN || event->type == SDL_KEYUP ) && !event->key.repeat )
+        {
+            const int vk = SDLScancodeToVirtualKey( event->key.keysym.scancode );
+            if ( vk > 0 && vk <= 0xfe )
+            {
+                // SDL2 event timestamps are in milliseconds.
+                Event e {};
+                e.type      = event->type == SDL_KEYDOWN ? EventType::KeyDown : EventType::KeyUp;
+                e.timestamp = static_cast<uint64_t>( event->key.timestamp ) * 1000000;
+                e.key.key   = static_cast<Keyboard::Key>( vk );
+                EventQueue::get().push( e );
+            }
+        }
+
+        return 0;
+    }
+
+    KeyboardSDL2()
+    {
+        SDL_AddEventWatch( &SDLEventWatch, this );
+    }
 
-    mutable std::mutex m_Mutex;
+    ~KeyboardSDL2()
+    {
+        SDL_DelEventWatch( &SDLEventWatch, this );
+    }
+
+    mutable Mutex m_Mutex;
 };
 
 namespace input::Keyboard
 {
 State getState()
 {
+    INPUT_PROFILE_SCOPE( KeyboardGetState );
+
     return KeyboardSDL2::get().getState();
 }
 
@@ -448,3 +481,14 @@ bool isConnected()
     return KeyboardSDL2::get().isConnected();
 }
 }  // namespace input::Keyboard
+
+uint64_t input::getEventTime() noexcept
+{
+    // The timestamps of the SDL2 events are in milliseconds.
+    return static_cast<uint64_t>( SDL_GetTicks64() ) * 1000000;
+}
+
+void input::beginFrame() noexcept
+{
+    // The events are received by the SDL event watches.
+}
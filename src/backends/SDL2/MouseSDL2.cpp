@@ -1,4 +1,6 @@
+#include <input/EventQueue.hpp>
 #include <input/Mouse.hpp>
+#include <input/Profiler.hpp>
 
 #include <SDL.h>
 
@@ -85,6 +87,8 @@ public:
     void resetRelativeMotion() noexcept
     {
         std::scoped_lock lock( m_Mutex );
+        m_Motion.endFrame();
+
         if ( m_Mode == Mouse::Mode::Relative )
         {
             m_RelativeX = 0;
@@ -92,6 +96,18 @@ public:
         }
     }
 
+    std::span<const Mouse::MotionSample> getMotionHistory() const noexcept
+    {
+        std::scoped_lock lock( m_Mutex );
+        return m_Motion.getSamples();
+    }
+
+    uint32_t getDroppedMotionSamples() const noexcept
+    {
+        std::scoped_lock lock( m_Mutex );
+        return m_Motion.getDroppedCount();
+    }
+
     bool isConnected() const
     {
         // SDL2 always has a mouse device
@@ -120,8 +136,46 @@ public:
     MouseSDL2& operator=( MouseSDL2&& )      = delete;
 
 private:
+    static uint8_t getButtons( Uint32 buttons ) noexcept
+    {
+        uint8_t result = 0;
+        result |= ( buttons & SDL_BUTTON_LMASK ) ? 1u << static_cast<int>( Mouse::Button::Left ) : 0u;
+        result |= ( buttons & SDL_BUTTON_RMASK ) ? 1u << static_cast<int>( Mouse::Button::Right ) : 0u;
+        result |= ( buttons & SDL_BUTTON_MMASK ) ? 1u << static_cast<int>( Mouse::Button::Middle ) : 0u;
+        result |= ( buttons & SDL_BUTTON_X1MASK ) ? 1u << static_cast<int>( Mouse::Button::XButton1 ) : 0u;
+        result |= ( buttons & SDL_BUTTON_X2MASK ) ? 1u << static_cast<int>( Mouse::Button::XButton2 ) : 0u;
+
+        return result;
+    }
+
+    static bool getButton( Uint8 sdlButton, Mouse::Button& button ) noexcept
+    {
+        switch ( sdlButton )
+        {
+        case SDL_BUTTON_LEFT:
+            button = Mouse::Button::Left;
+            return true;
+        case SDL_BUTTON_MIDDLE:
+            button = Mouse::Button::Middle;
+            return true;
+        case SDL_BUTTON_RIGHT:
+            button = Mouse::Button::Right;
+            return true;
+        case SDL_BUTTON_X1:
+            button = Mouse::Button::XButton1;
+            return true;
+        case SDL_BUTTON_X2:
+            button = Mouse::Button::XButton2;
+            return true;
+        default:
+            return false;
+        }
+    }
+
     static int SDLEventWatch( void* userdata, SDL_Event* event )
     {
+        INPUT_PROFILE_COUNT( MouseWatchEvents );
+
         auto* self = static_cast<MouseSDL2*>( userdata );
 
         if ( event->type == SDL_MOUSEWHEEL )
@@ -129,13 +183,50 @@ private:
             std::scoped_lock lock( self->m_Mutex );
 
             self->m_ScrollWheelValue += event->wheel.y * 120;  // 120 is Win32/DirectX standard
+
+            // SDL2 event timestamps are in milliseconds.
+            Event e {};
+            e.type             = EventType::MouseWheel;
+            e.timestamp        = static_cast<uint64_t>( event->wheel.timestamp ) * 1000000;
+            e.mouseWheel.delta = event->wheel.y * 120;
+            EventQueue::get().push( e );
         }
-        else if ( event->type == SDL_MOUSEMOTION && self->m_Mode == Mouse::Mode::Relative )
+        else if ( event->type == SDL_MOUSEMOTION )
         {
             std::scoped_lock lock( self->m_Mutex );
 
-            self->m_RelativeX += event->motion.xrel;
-            self->m_RelativeY += event->motion.yrel;
+            if ( self->m_Mode == Mouse::Mode::Relative )
+            {
+                self->m_RelativeX += event->motion.xrel;
+                self->m_RelativeY += event->motion.yrel;
+            }
+
+            // SDL2 event timestamps are in milliseconds.
+            const Mouse::MotionSample sample { static_cast<uint64_t>( event->motion.timestamp ) * 1000000,
+                                               static_cast<float>( event->motion.x ),
+                                               static_cast<float>( event->motion.y ),
+                                               static_cast<float>( event->motion.xrel ),
+                                               static_cast<float>( event->motion.yrel ),
+                                               getButtons( event->motion.state ) };
+            self->m_Motion.add( sample );
+
+            Event e {};
+            e.type        = EventType::MouseMotion;
+            e.timestamp   = sample.timestamp;
+            e.mouseMotion = { sample.x, sample.y, sample.deltaX, sample.deltaY };
+            EventQueue::get().push( e );
+        }
+        else if ( event->type == SDL_MOUSEBUTTONDOWN || event->type == SDL_MOUSEBUTTONUP )
+        {
+            Event e {};
+            if ( getButton( event->button.button, e.mouseButton.button ) )
+            {
+                e.type          = event->type == SDL_MOUSEBUTTONDOWN ? EventType::MouseButtonDown : EventType::MouseButtonUp;
+                e.timestamp     = static_cast<uint64_t>( event->button.timestamp ) * 1000000;
+                e.mouseButton.x = static_cast<float>( event->button.x );
+                e.mouseButton.y = static_cast<float>( event->button.y );
+                EventQueue::get().push( e );
+            }
         }
         return 0;
     }
@@ -151,17 +242,20 @@ private:
         SDL_DelEventWatch( &SDLEventWatch, this );
     }
 
-    Mouse::Mode        m_Mode             = Mouse::Mode::Absolute;
-    int                m_ScrollWheelValue = 0;
-    int                m_RelativeX        = 0;
-    int                m_RelativeY        = 0;
-    mutable std::mutex m_Mutex;
+    Mouse::Mode          m_Mode             = Mouse::Mode::Absolute;
+    int                  m_ScrollWheelValue = 0;
+    int                  m_RelativeX        = 0;
+    int                  m_RelativeY        = 0;
+    Mouse::MotionHistory m_Motion;
+    mutable Mutex        m_Mutex;
 };
 
 namespace input::Mouse
 {
 State getState()
 {
+    INPUT_PROFILE_SCOPE( MouseGetState );
+
     return MouseSDL2::get().getState();
 }
 
@@ -180,6 +274,16 @@ void resetRelativeMotion() noexcept
     MouseSDL2::get().resetRelativeMotion();
 }
 
+std::span<const MotionSample> getMotionHistory() noexcept
+{
+    return MouseSDL2::get().getMotionHistory();
+}
+
+uint32_t getDroppedMotionSamples() noexcept
+{
+    return MouseSDL2::get().getDroppedMotionSamples();
+}
+
 bool isConnected()
 {
     return MouseSDL2::get().isConnected();
@@ -1,3 +1,5 @@
+#include <input/EventQueue.hpp>
+#include <input/Profiler.hpp>
 #include <input/Touch.hpp>
 
 #include <SDL2/SDL_events.h>
@@ -32,10 +34,10 @@ public:
         std::scoped_lock lock( m_Mutex );
 
         // Remove touches that ended in the previous frame
-        std::erase_if( m_Touches,
-                       []( const Touch::TouchPoint& t ) {
-                           return t.phase == Touch::Phase::Ended || t.phase == Touch::Phase::Cancelled;
-                       } );
+        erase_if( m_Touches,
+                  []( const Touch::TouchPoint& t ) {
+                      return t.phase == Touch::Phase::Ended || t.phase == Touch::Phase::Cancelled;
+                  } );
 
         // Mark remaining touches as stationary (they will be updated to Moved if motion events occur)
         for ( auto& touch: m_Touches )
@@ -65,9 +67,14 @@ public:
 private:
     static int SDLEventWatch( void* userdata, SDL_Event* event )
     {
+        INPUT_PROFILE_COUNT( TouchWatchEvents );
+
         auto*            self = static_cast<TouchSDL2*>( userdata );
         std::scoped_lock lock( self->m_Mutex );
 
+        if ( event->type == SDL_FINGERDOWN || event->type == SDL_FINGERMOTION || event->type == SDL_FINGERUP )
+            pushEvent( event->tfinger );
+
         switch ( event->type )
         {
         case SDL_FINGERDOWN:
@@ -120,6 +127,32 @@ private:
         return 1;  // SDL2 returns int instead of bool
     }
 
+    static void pushEvent( const SDL_TouchFingerEvent& finger ) noexcept
+    {
+        Event e {};
+        e.timestamp      = static_cast<uint64_t>( finger.timestamp ) * 1000000;  // SDL2 event timestamps are in milliseconds.
+        e.touch.id       = static_cast<int64_t>( finger.fingerId );
+        e.touch.x        = finger.x;
+        e.touch.y        = finger.y;
+        e.touch.pressure = finger.pressure;
+
+        switch ( finger.type )
+        {
+        case SDL_FINGERDOWN:
+            e.type = EventType::TouchDown;
+            break;
+        case SDL_FINGERUP:
+            e.type           = EventType::TouchUp;
+            e.touch.pressure = 0.0f;
+            break;
+        default:
+            e.type = EventType::TouchMotion;
+            break;
+        }
+
+        EventQueue::get().push( e );
+    }
+
     TouchSDL2()
     {
         SDL_AddEventWatch( &TouchSDL2::SDLEventWatch, this );
@@ -130,8 +163,8 @@ private:
         SDL_DelEventWatch( &TouchSDL2::SDLEventWatch, this );
     }
 
-    mutable std::mutex             m_Mutex;
-    std::vector<Touch::TouchPoint> m_Touches;
+    mutable Mutex                  m_Mutex;
+    Touch::TouchList               m_Touches;
 
     friend class TouchSDL2Updater;
 };
@@ -141,6 +174,8 @@ namespace input::Touch
 
 State getState()
 {
+    INPUT_PROFILE_SCOPE( TouchGetState );
+
     return TouchSDL2::get().getState();
 }
 
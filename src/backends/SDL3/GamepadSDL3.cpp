@@ -1,4 +1,6 @@
+#include <input/EventQueue.hpp>
 #include <input/Gamepad.hpp>
+#include <input/Profiler.hpp>
 
 #include <SDL3/SDL_events.h>
 #include <SDL3/SDL_gamepad.h>
@@ -12,6 +14,47 @@ using namespace input;
 
 constexpr float SDLThumbDeadZone          = 0.24f;  // Consistent with XboxOneThumbDeadZone
 
+namespace
+{
+// Map an SDL gamepad button to a Gamepad::Button (or Gamepad::Button::Count if the button is not supported).
+Gamepad::Button SDLButtonToButton( Uint8 button ) noexcept
+{
+    switch ( button )
+    {
+    case SDL_GAMEPAD_BUTTON_SOUTH:
+        return Gamepad::Button::A;
+    case SDL_GAMEPAD_BUTTON_EAST:
+        return Gamepad::Button::B;
+    case SDL_GAMEPAD_BUTTON_WEST:
+        return Gamepad::Button::X;
+    case SDL_GAMEPAD_BUTTON_NORTH:
+        return Gamepad::Button::Y;
+    case SDL_GAMEPAD_BUTTON_LEFT_STICK:
+        return Gamepad::Button::LeftStick;
+    case SDL_GAMEPAD_BUTTON_RIGHT_STICK:
+        return Gamepad::Button::RightStick;
+    case SDL_GAMEPAD_BUTTON_LEFT_SHOULDER:
+        return Gamepad::Button::LeftShoulder;
+    case SDL_GAMEPAD_BUTTON_RIGHT_SHOULDER:
+        return Gamepad::Button::RightShoulder;
+    case SDL_GAMEPAD_BUTTON_BACK:
+        return Gamepad::Button::Back;
+    case SDL_GAMEPAD_BUTTON_START:
+        return Gamepad::Button::Start;
+    case SDL_GAMEPAD_BUTTON_DPAD_UP:
+        return Gamepad::Button::DPadUp;
+    case SDL_GAMEPAD_BUTTON_DPAD_DOWN:
+        return Gamepad::Button::DPadDown;
+    case SDL_GAMEPAD_BUTTON_DPAD_LEFT:
+        return Gamepad::Button::DPadLeft;
+    case SDL_GAMEPAD_BUTTON_DPAD_RIGHT:
+        return Gamepad::Button::DPadRight;
+    default:
+        return Gamepad::Button::Count;
+    }
+}
+}  // namespace
+
 class GamepadSDL3
 {
 public:
@@ -122,6 +165,8 @@ public:
 private:
     static bool SDLEventWatch( void* userdata, SDL_Event* event )
     {
+        INPUT_PROFILE_COUNT( GamepadWatchEvents );
+
         auto* self = static_cast<GamepadSDL3*>( userdata );
 
         switch ( event->type )
@@ -163,6 +208,35 @@ private:
             }
         }
         break;
+        case SDL_EVENT_GAMEPAD_BUTTON_DOWN:
+        case SDL_EVENT_GAMEPAD_BUTTON_UP:
+        {
+            Event e {};
+            e.type                 = event->type == SDL_EVENT_GAMEPAD_BUTTON_DOWN ? EventType::GamepadButtonDown : EventType::GamepadButtonUp;
+            e.timestamp            = event->gbutton.timestamp;
+            e.gamepadButton.player = self->findPlayer( event->gbutton.which );
+            e.gamepadButton.button = SDLButtonToButton( event->gbutton.button );
+
+            if ( e.gamepadButton.player >= 0 && e.gamepadButton.button != Gamepad::Button::Count )
+                EventQueue::get().push( e );
+        }
+        break;
+        case SDL_EVENT_GAMEPAD_AXIS_MOTION:
+        {
+            Event e {};
+            e.type               = EventType::GamepadAxis;
+            e.timestamp          = event->gaxis.timestamp;
+            e.gamepadAxis.player = self->findPlayer( event->gaxis.which );
+            e.gamepadAxis.value  = static_cast<float>( event->gaxis.value ) / 32767.0f;
+
+            // The axes of SDL_GamepadAxis are in the same order as GamepadAxis.
+            if ( e.gamepadAxis.player >= 0 && event->gaxis.axis <= SDL_GAMEPAD_AXIS_RIGHT_TRIGGER )
+            {
+                e.gamepadAxis.axis = static_cast<GamepadAxis>( event->gaxis.axis );
+                EventQueue::get().push( e );
+            }
+        }
+        break;
         case SDL_EVENT_GAMEPAD_REMOVED:
         {
             std::scoped_lock lock( self->m_Mutex );
@@ -207,6 +281,20 @@ private:
         }
     }
 
+    // Find the player slot of a gamepad, or -1 if the gamepad is not open.
+    int findPlayer( SDL_JoystickID joyId ) const
+    {
+        std::scoped_lock lock( m_Mutex );
+
+        for ( int i = 0; i < Gamepad::MAX_PLAYER_COUNT; ++i )
+        {
+            if ( m_Gamepads[i] && SDL_GetGamepadID( m_Gamepads[i] ) == joyId )
+                return i;
+        }
+
+        return -1;
+    }
+
     void scanGamepads()
     {
         // SDL3: enumerate gamepads using SDL_GetGamepads
@@ -234,12 +322,14 @@ private:
 
     std::array<SDL_Gamepad*, Gamepad::MAX_PLAYER_COUNT> m_Gamepads          = {};
     int                                                 m_MostRecentGamepad = 0;
-    mutable std::mutex                                  m_Mutex;
+    mutable Mutex                                       m_Mutex;
 };
 
 // Bridge to Gamepad interface
 Gamepad::State Gamepad::getState( int playerIndex, Gamepad::DeadZone deadZoneMode )
 {
+    INPUT_PROFILE_SCOPE( GamepadGetState );
+
     return GamepadSDL3::get().getState( playerIndex, deadZoneMode );
 }
 
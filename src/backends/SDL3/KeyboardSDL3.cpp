@@ -1,6 +1,10 @@
+#include <input/EventQueue.hpp>
 #include <input/Keyboard.hpp>
+#include <input/Profiler.hpp>
 
+#include <SDL3/SDL_events.h>
 #include <SDL3/SDL_keyboard.h>
+#include <SDL3/SDL_timer.h>
 
 #include <mutex>
 
@@ -381,16 +385,46 @@ public:
     KeyboardSDL3& operator=( KeyboardSDL3&& )      = delete;
 
 private:
-    KeyboardSDL3()  = default;
-    ~KeyboardSDL3() = default;
+    static bool SDLEventWatch( void* /*userdata*/, SDL_Event* event )
+    {
+        INPUT_PROFILE_COUNT( KeyboardWatchEvents );
+
+        // Key repeats are not reported.
+        if ( ( event->type == SDL_EVENT_KEY_DOWN || event->type == SDL_EVENT_KEY_UP ) && !event->key.repeat )
+        {
+            const int vk = SDLScancodeToVirtualKey( event->key.scancode );
+            if ( vk > 0 && vk <= 0xfe )
+            {
+                Event e {};
+                e.type      = event->type == SDL_EVENT_KEY_DOWN ? EventType::KeyDown : EventType::KeyUp;
+                e.timestamp = event->key.timestamp;
+                e.key.key   = static_cast<Keyboard::Key>( vk );
+                EventQueue::get().push( e );
+            }
+        }
+
+        return true;
+    }
+
+    KeyboardSDL3()
+    {
+        SDL_AddEventWatch( &KeyboardSDL3::SDLEventWatch, this );
+    }
 
-    mutable std::mutex m_Mutex;
+    ~KeyboardSDL3()
+    {
+        SDL_RemoveEventWatch( &KeyboardSDL3::SDLEventWatch, this );
+    }
+
+    mutable Mutex m_Mutex;
 };
 
 namespace input::Keyboard
 {
 State getState()
 {
+    INPUT_PROFILE_SCOPE( KeyboardGetState );
+
     return KeyboardSDL3::get().getState();
 }
 
@@ -402,3 +436,13 @@ bool isConnected()
     return KeyboardSDL3::isConnected();
 }
 }  // namespace input::Keyboard
+
+uint64_t input::getEventTime() noexcept
+{
+    return SDL_GetTicksNS();
+}
+
+void input::beginFrame() noexcept
+{
+    // The events are received by the SDL event watches.
+}
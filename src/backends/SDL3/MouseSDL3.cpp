@@ -1,4 +1,6 @@
+#include <input/EventQueue.hpp>
 #include <input/Mouse.hpp>
+#include <input/Profiler.hpp>
 
 #include <SDL3/SDL_events.h>
 #include <SDL3/SDL_mouse.h>
@@ -87,6 +89,8 @@ public:
     void resetRelativeMotion() noexcept
     {
         std::scoped_lock lock( m_Mutex );
+        m_Motion.endFrame();
+
         if ( m_Mode == Mouse::Mode::Relative )
         {
             m_RelativeX = m_AccumulateX;
@@ -97,6 +101,18 @@ public:
         }
     }
 
+    std::span<const Mouse::MotionSample> getMotionHistory() const noexcept
+    {
+        std::scoped_lock lock( m_Mutex );
+        return m_Motion.getSamples();
+    }
+
+    uint32_t getDroppedMotionSamples() const noexcept
+    {
+        std::scoped_lock lock( m_Mutex );
+        return m_Motion.getDroppedCount();
+    }
+
     static bool isConnected()
     {
         return SDL_HasMouse();
@@ -126,8 +142,46 @@ public:
     MouseSDL3& operator=( MouseSDL3&& )      = delete;
 
 private:
+    static uint8_t getButtons( SDL_MouseButtonFlags buttons ) noexcept
+    {
+        uint8_t result = 0;
+        result |= ( buttons & SDL_BUTTON_LMASK ) ? 1u << static_cast<int>( Mouse::Button::Left ) : 0u;
+        result |= ( buttons & SDL_BUTTON_RMASK ) ? 1u << static_cast<int>( Mouse::Button::Right ) : 0u;
+        result |= ( buttons & SDL_BUTTON_MMASK ) ? 1u << static_cast<int>( Mouse::Button::Middle ) : 0u;
+        result |= ( buttons & SDL_BUTTON_X1MASK ) ? 1u << static_cast<int>( Mouse::Button::XButton1 ) : 0u;
+        result |= ( buttons & SDL_BUTTON_X2MASK ) ? 1u << static_cast<int>( Mouse::Button::XButton2 ) : 0u;
+
+        return result;
+    }
+
+    static bool getButton( Uint8 sdlButton, Mouse::Button& button ) noexcept
+    {
+        switch ( sdlButton )
+        {
+        case SDL_BUTTON_LEFT:
+            button = Mouse::Button::Left;
+            return true;
+        case SDL_BUTTON_MIDDLE:
+            button = Mouse::Button::Middle;
+            return true;
+        case SDL_BUTTON_RIGHT:
+            button = Mouse::Button::Right;
+            return true;
+        case SDL_BUTTON_X1:
+            button = Mouse::Button::XButton1;
+            return true;
+        case SDL_BUTTON_X2:
+            button = Mouse::Button::XButton2;
+            return true;
+        default:
+            return false;
+        }
+    }
+
     static bool SDLEventWatch( void* userdata, SDL_Event* event )
     {
+        INPUT_PROFILE_COUNT( MouseWatchEvents );
+
         auto* self = static_cast<MouseSDL3*>( userdata );
 
         switch ( event->type )
@@ -136,6 +190,12 @@ private:
         {
             std::scoped_lock lock( self->m_Mutex );
             self->m_ScrollWheelValue += event->wheel.y * 120;  // 120 is Win32/DirectX standard
+
+            Event e {};
+            e.type             = EventType::MouseWheel;
+            e.timestamp        = event->wheel.timestamp;
+            e.mouseWheel.delta = static_cast<int32_t>( event->wheel.y * 120 );
+            EventQueue::get().push( e );
         }
         break;
         case SDL_EVENT_MOUSE_MOTION:
@@ -146,6 +206,37 @@ private:
                 self->m_AccumulateX += event->motion.xrel;
                 self->m_AccumulateY += event->motion.yrel;
             }
+
+            // SDL3 event timestamps are in nanoseconds.
+            self->m_Motion.add( { event->motion.timestamp,
+                                  event->motion.x,
+                                  event->motion.y,
+                                  event->motion.xrel,
+                                  event->motion.yrel,
+                                  getButtons( event->motion.state ) } );
+
+            Event e {};
+            e.type               = EventType::MouseMotion;
+            e.timestamp          = event->motion.timestamp;
+            e.mouseMotion.x      = event->motion.x;
+            e.mouseMotion.y      = event->motion.y;
+            e.mouseMotion.deltaX = event->motion.xrel;
+            e.mouseMotion.deltaY = event->motion.yrel;
+            EventQueue::get().push( e );
+        }
+        break;
+        case SDL_EVENT_MOUSE_BUTTON_DOWN:
+        case SDL_EVENT_MOUSE_BUTTON_UP:
+        {
+            Event e {};
+            if ( getButton( event->button.button, e.mouseButton.button ) )
+            {
+                e.type          = event->type == SDL_EVENT_MOUSE_BUTTON_DOWN ? EventType::MouseButtonDown : EventType::MouseButtonUp;
+                e.timestamp     = event->button.timestamp;
+                e.mouseButton.x = event->button.x;
+                e.mouseButton.y = event->button.y;
+                EventQueue::get().push( e );
+            }
         }
         break;
         }
@@ -164,20 +255,23 @@ private:
         SDL_RemoveEventWatch( &MouseSDL3::SDLEventWatch, this );
     }
 
-    SDL_Window*        m_Window           = nullptr;
-    float              m_AccumulateX      = 0.0f;
-    float              m_AccumulateY      = 0.0f;
-    float              m_RelativeX        = 0.0f;
-    float              m_RelativeY        = 0.0f;
-    float              m_ScrollWheelValue = 0.0f;
-    Mouse::Mode        m_Mode             = Mouse::Mode::Absolute;
-    mutable std::mutex m_Mutex;
+    SDL_Window*          m_Window           = nullptr;
+    float                m_AccumulateX      = 0.0f;
+    float                m_AccumulateY      = 0.0f;
+    float                m_RelativeX        = 0.0f;
+    float                m_RelativeY        = 0.0f;
+    float                m_ScrollWheelValue = 0.0f;
+    Mouse::Mode          m_Mode             = Mouse::Mode::Absolute;
+    Mouse::MotionHistory m_Motion;
+    mutable Mutex        m_Mutex;
 };
 
 namespace input::Mouse
 {
 State getState()
 {
+    INPUT_PROFILE_SCOPE( MouseGetState );
+
     return MouseSDL3::get().getState();
 }
 
@@ -196,6 +290,16 @@ void resetRelativeMotion() noexcept
     MouseSDL3::get().resetRelativeMotion();
 }
 
+std::span<const MotionSample> getMotionHistory() noexcept
+{
+    return MouseSDL3::get().getMotionHistory();
+}
+
+uint32_t getDroppedMotionSamples() noexcept
+{
+    return MouseSDL3::get().getDroppedMotionSamples();
+}
+
 bool isConnected()
 {
     return MouseSDL3::isConnected();
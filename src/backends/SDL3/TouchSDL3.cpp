@@ -1,3 +1,5 @@
+#include <input/EventQueue.hpp>
+#include <input/Profiler.hpp>
 #include <input/Touch.hpp>
 
 #include <SDL3/SDL_events.h>
@@ -32,10 +34,10 @@ public:
         std::scoped_lock lock( m_Mutex );
 
         // Remove touches that ended in the previous frame
-        std::erase_if( m_Touches,
-                       []( const Touch::TouchPoint& t ) {
-                           return t.phase == Touch::Phase::Ended || t.phase == Touch::Phase::Cancelled;
-                       } );
+        erase_if( m_Touches,
+                  []( const Touch::TouchPoint& t ) {
+                      return t.phase == Touch::Phase::Ended || t.phase == Touch::Phase::Cancelled;
+                  } );
 
         // Mark remaining touches as stationary (they will be updated to Moved if motion events occur)
         for ( auto& touch: m_Touches )
@@ -69,8 +71,13 @@ public:
 private:
     static bool SDLEventWatch( void* userdata, SDL_Event* event )
     {
+        INPUT_PROFILE_COUNT( TouchWatchEvents );
+
         auto*            self = static_cast<TouchSDL3*>( userdata );
 
+        if ( event->type == SDL_EVENT_FINGER_DOWN || event->type == SDL_EVENT_FINGER_MOTION || event->type == SDL_EVENT_FINGER_UP )
+            pushEvent( event->tfinger );
+
         switch ( event->type )
         {
         case SDL_EVENT_FINGER_DOWN:
@@ -126,6 +133,32 @@ private:
         return true;
     }
 
+    static void pushEvent( const SDL_TouchFingerEvent& finger ) noexcept
+    {
+        Event e {};
+        e.timestamp      = finger.timestamp;  // SDL3 event timestamps are in nanoseconds.
+        e.touch.id       = static_cast<int64_t>( finger.fingerID );
+        e.touch.x        = finger.x;
+        e.touch.y        = finger.y;
+        e.touch.pressure = finger.pressure;
+
+        switch ( finger.type )
+        {
+        case SDL_EVENT_FINGER_DOWN:
+            e.type = EventType::TouchDown;
+            break;
+        case SDL_EVENT_FINGER_UP:
+            e.type           = EventType::TouchUp;
+            e.touch.pressure = 0.0f;
+            break;
+        default:
+            e.type = EventType::TouchMotion;
+            break;
+        }
+
+        EventQueue::get().push( e );
+    }
+
     TouchSDL3()
     {
         SDL_AddEventWatch( &TouchSDL3::SDLEventWatch, this );
@@ -136,8 +169,8 @@ private:
         SDL_RemoveEventWatch( &TouchSDL3::SDLEventWatch, this );
     }
 
-    mutable std::mutex             m_Mutex;
-    std::vector<Touch::TouchPoint> m_Touches;
+    mutable Mutex                  m_Mutex;
+    Touch::TouchList               m_Touches;
 
     friend class TouchSDL3Updater;
 };
@@ -147,6 +180,8 @@ namespace input::Touch
 
 State getState()
 {
+    INPUT_PROFILE_SCOPE( TouchGetState );
+
     return TouchSDL3::get().getState();
 }
 
@@ -0,0 +1,216 @@
+#include <input/EventQueue.hpp>
+#include <input/Gamepad.hpp>
+#include <input/Profiler.hpp>
+#include <input/Virtual.hpp>
+
+#include <array>
+#include <mutex>
+
+using namespace input;
+
+constexpr float VirtualThumbDeadZone = 0.24f;  // Consistent with XboxOneThumbDeadZone
+
+class GamepadVirtual
+{
+public:
+    static GamepadVirtual& get()
+    {
+        static GamepadVirtual instance;
+        return instance;
+    }
+
+    Gamepad::State getState( int player, Gamepad::DeadZone deadZoneMode ) const
+    {
+        std::scoped_lock lock( m_Mutex );
+
+        if ( player == Gamepad::MOST_RECENT_PLAYER )
+            player = m_MostRecentGamepad;
+
+        if ( player < 0 || player >= Gamepad::MAX_PLAYER_COUNT || !m_States[player].connected )
+            return {};
+
+        // The thumbsticks are stored raw, so the dead zone is applied here (the same as the other backends).
+        Gamepad::State state = m_States[player];
+
+        const Gamepad::ThumbSticks& raw = m_States[player].thumbSticks;
+        ApplyStickDeadZone( raw.leftX, raw.leftY, deadZoneMode, 1.0f, VirtualThumbDeadZone, state.thumbSticks.leftX, state.thumbSticks.leftY );
+        ApplyStickDeadZone( raw.rightX, raw.rightY, deadZoneMode, 1.0f, VirtualThumbDeadZone, state.thumbSticks.rightX, state.thumbSticks.rightY );
+
+        return state;
+    }
+
+    void connect( int player, bool connected ) noexcept
+    {
+        std::scoped_lock lock( m_Mutex );
+
+        if ( player < 0 || player >= Gamepad::MAX_PLAYER_COUNT )
+            return;
+
+        m_States[player]           = {};
+        m_States[player].connected = connected;
+
+        if ( connected )
+            m_MostRecentGamepad = player;
+    }
+
+    void setState( int player, const Gamepad::State& state ) noexcept
+    {
+        std::scoped_lock lock( m_Mutex );
+
+        if ( player < 0 || player >= Gamepad::MAX_PLAYER_COUNT )
+            return;
+
+        m_States[player] = state.connected ? state : Gamepad::State {};
+
+        if ( state.connected )
+            m_MostRecentGamepad = player;
+    }
+
+    bool apply( const Event& event ) noexcept
+    {
+        std::scoped_lock lock( m_Mutex );
+
+        // The player is the common initial member of the button and the axis events.
+        const int player = event.type == EventType::GamepadAxis ? event.gamepadAxis.player : event.gamepadButton.player;
+        if ( player < 0 || player >= Gamepad::MAX_PLAYER_COUNT || !m_States[player].connected )
+            return false;
+
+        Gamepad::State& state = m_States[player];
+
+        switch ( event.type )
+        {
+        case EventType::GamepadButtonDown:
+        case EventType::GamepadButtonUp:
+        {
+            if ( event.gamepadButton.button >= Gamepad::Button::Count )
+                return false;
+
+            const uint32_t bit     = 1u << static_cast<uint32_t>( event.gamepadButton.button );
+            const uint32_t buttons = PackGamepadButtons( state );
+            UnpackGamepadButtons( event.type == EventType::GamepadButtonDown ? buttons | bit : buttons & ~bit, state );
+            break;
+        }
+        case EventType::GamepadAxis:
+            setAxis( state, event.gamepadAxis.axis, event.gamepadAxis.value );
+            break;
+        default:
+            return false;
+        }
+
+        ++state.packet;
+        m_MostRecentGamepad = player;
+
+        return true;
+    }
+
+    void reset() noexcept
+    {
+        std::scoped_lock lock( m_Mutex );
+        m_States            = {};
+        m_MostRecentGamepad = 0;
+    }
+
+    GamepadVirtual( const GamepadVirtual& )            = delete;
+    GamepadVirtual( GamepadVirtual&& )                 = delete;
+    GamepadVirtual& operator=( const GamepadVirtual& ) = delete;
+    GamepadVirtual& operator=( GamepadVirtual&& )      = delete;
+
+private:
+    GamepadVirtual()  = default;
+    ~GamepadVirtual() = default;
+
+    static void setAxis( Gamepad::State& state, GamepadAxis axis, float value ) noexcept
+    {
+        switch ( axis )
+        {
+        case GamepadAxis::LeftX:
+            state.thumbSticks.leftX = value;
+            break;
+        case GamepadAxis::LeftY:
+            state.thumbSticks.leftY = value;
+            break;
+        case GamepadAxis::RightX:
+            state.thumbSticks.rightX = value;
+            break;
+        case GamepadAxis::RightY:
+            state.thumbSticks.rightY = value;
+            break;
+        case GamepadAxis::LeftTrigger:
+            state.triggers.left = value;
+            break;
+        case GamepadAxis::RightTrigger:
+            state.triggers.right = value;
+            break;
+        }
+    }
+
+    std::array<Gamepad::State, Gamepad::MAX_PLAYER_COUNT> m_States            = {};
+    int                                                   m_MostRecentGamepad = 0;
+    mutable Mutex                                         m_Mutex;
+};
+
+// Bridge to Gamepad interface
+Gamepad::State Gamepad::getState( int playerIndex, DeadZone deadZoneMode )
+{
+    INPUT_PROFILE_SCOPE( GamepadGetState );
+
+    return GamepadVirtual::get().getState( playerIndex, deadZoneMode );
+}
+
+bool Gamepad::setVibration( int playerIndex, float /*leftMotor*/, float /*rightMotor*/, float /*leftTrigger*/, float /*rightTrigger*/ )
+{
+    // The virtual gamepads do not vibrate, but report success if the gamepad is connected.
+    return GamepadVirtual::get().getState( playerIndex, DeadZone::None ).connected;
+}
+
+void Gamepad::suspend() noexcept
+{}
+
+void Gamepad::resume() noexcept
+{}
+
+bool Virtual::detail::applyGamepadEvent( const Event& event ) noexcept
+{
+    return GamepadVirtual::get().apply( event );
+}
+
+void Virtual::detail::resetGamepads() noexcept
+{
+    GamepadVirtual::get().reset();
+}
+
+void Virtual::connectGamepad( int player ) noexcept
+{
+    GamepadVirtual::get().connect( player, true );
+}
+
+void Virtual::disconnectGamepad( int player ) noexcept
+{
+    GamepadVirtual::get().connect( player, false );
+}
+
+void Virtual::setGamepadButton( int player, Gamepad::Button button, bool down ) noexcept
+{
+    Event e {};
+    e.type                 = down ? EventType::GamepadButtonDown : EventType::GamepadButtonUp;
+    e.timestamp            = getEventTime();
+    e.gamepadButton.player = player;
+    e.gamepadButton.button = button;
+    pushEvent( e );
+}
+
+void Virtual::setGamepadAxis( int player, GamepadAxis axis, float value ) noexcept
+{
+    Event e {};
+    e.type               = EventType::GamepadAxis;
+    e.timestamp          = getEventTime();
+    e.gamepadAxis.player = player;
+    e.gamepadAxis.axis   = axis;
+    e.gamepadAxis.value  = value;
+    pushEvent( e );
+}
+
+void Virtual::setGamepadState( int player, const Gamepad::State& state ) noexcept
+{
+    GamepadVirtual::get().setState( player, state );
+}
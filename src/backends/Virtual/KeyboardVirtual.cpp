@@ -0,0 +1,183 @@
+#include <input/EventQueue.hpp>
+#include <input/Keyboard.hpp>
+#include <input/Profiler.hpp>
+#include <input/Virtual.hpp>
+
+#include <atomic>
+#include <mutex>
+
+using namespace input;
+
+namespace
+{
+void KeyDown( int key, Keyboard::State& state ) noexcept
+{
+    if ( key < 0 || key > 0xfe )
+        return;
+
+    auto               ptr = reinterpret_cast<uint32_t*>( &state );
+    const unsigned int bf  = 1u << ( key & 0x1f );
+    ptr[( key >> 5 )] |= bf;
+}
+
+void KeyUp( int key, Keyboard::State& state ) noexcept
+{
+    if ( key < 0 || key > 0xfe )
+        return;
+
+    auto               ptr = reinterpret_cast<uint32_t*>( &state );
+    const unsigned int bf  = 1u << ( key & 0x1f );
+    ptr[( key >> 5 )] &= ~bf;
+}
+
+// The virtual clock of the events (see Virtual::setTime).
+std::atomic<uint64_t> g_Time { 0 };
+}  // namespace
+
+class KeyboardVirtual
+{
+public:
+    static KeyboardVirtual& get()
+    {
+        static KeyboardVirtual instance;
+        return instance;
+    }
+
+    Keyboard::State getState() const
+    {
+        std::scoped_lock lock( m_Mutex );
+
+        Keyboard::State state = m_State;
+        state.AltKey          = state.LeftAlt || state.RightAlt;
+        state.ControlKey      = state.LeftControl || state.RightControl;
+        state.ShiftKey        = state.LeftShift || state.RightShift;
+
+        return state;
+    }
+
+    void setKey( Keyboard::Key key, bool down ) noexcept
+    {
+        std::scoped_lock lock( m_Mutex );
+
+        if ( down )
+            KeyDown( static_cast<int>( key ), m_State );
+        else
+            KeyUp( static_cast<int>( key ), m_State );
+    }
+
+    void setState( const Keyboard::State& state ) noexcept
+    {
+        std::scoped_lock lock( m_Mutex );
+        m_State = state;
+    }
+
+    KeyboardVirtual( const KeyboardVirtual& )            = delete;
+    KeyboardVirtual( KeyboardVirtual&& )                 = delete;
+    KeyboardVirtual& operator=( const KeyboardVirtual& ) = delete;
+    KeyboardVirtual& operator=( KeyboardVirtual&& )      = delete;
+
+private:
+    KeyboardVirtual()  = default;
+    ~KeyboardVirtual() = default;
+
+    Keyboard::State m_State {};
+    mutable Mutex   m_Mutex;
+};
+
+namespace input::Keyboard
+{
+State getState()
+{
+    INPUT_PROFILE_SCOPE( KeyboardGetState );
+
+    return KeyboardVirtual::get().getState();
+}
+
+void reset()
+{
+    KeyboardVirtual::get().setState( {} );
+}
+
+bool isConnected()
+{
+    return true;
+}
+}  // namespace input::Keyboard
+
+void Virtual::detail::applyKeyboardEvent( const Event& event ) noexcept
+{
+    KeyboardVirtual::get().setKey( event.key.key, event.type == EventType::KeyDown );
+}
+
+bool Virtual::pushEvent( const Event& event ) noexcept
+{
+    switch ( event.type )
+    {
+    case EventType::KeyDown:
+    case EventType::KeyUp:
+        detail::applyKeyboardEvent( event );
+        break;
+    case EventType::MouseButtonDown:
+    case EventType::MouseButtonUp:
+    case EventType::MouseMotion:
+    case EventType::MouseWheel:
+        detail::applyMouseEvent( event );
+        break;
+    case EventType::GamepadButtonDown:
+    case EventType::GamepadButtonUp:
+    case EventType::GamepadAxis:
+        if ( !detail::applyGamepadEvent( event ) )
+            return false;
+        break;
+    case EventType::TouchDown:
+    case EventType::TouchMotion:
+    case EventType::TouchUp:
+        detail::applyTouchEvent( event );
+        break;
+    }
+
+    return EventQueue::get().push( event );
+}
+
+void Virtual::setKey( Keyboard::Key key, bool down ) noexcept
+{
+    Event e {};
+    e.type      = down ? EventType::KeyDown : EventType::KeyUp;
+    e.timestamp = getEventTime();
+    e.key.key   = key;
+    pushEvent( e );
+}
+
+void Virtual::setKeyboardState( const Keyboard::State& state ) noexcept
+{
+    KeyboardVirtual::get().setState( state );
+}
+
+void Virtual::setTime( uint64_t time ) noexcept
+{
+    g_Time.store( time, std::memory_order_relaxed );
+}
+
+void Virtual::advanceTime( uint64_t duration ) noexcept
+{
+    g_Time.fetch_add( duration, std::memory_order_relaxed );
+}
+
+void Virtual::reset() noexcept
+{
+    KeyboardVirtual::get().setState( {} );
+    detail::resetMouse();
+    detail::resetGamepads();
+    detail::resetTouches();
+    setTime( 0 );
+}
+
+uint64_t input::getEventTime() noexcept
+{
+    return g_Time.load( std::memory_order_relaxed );
+}
+
+void input::beginFrame() noexcept
+{
+    // The devices are only changed by the injection functions.
+}
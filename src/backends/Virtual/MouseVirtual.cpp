@@ -0,0 +1,310 @@
+#include <input/EventQueue.hpp>
+#include <input/Mouse.hpp>
+#include <input/Profiler.hpp>
+#include <input/Virtual.hpp>
+
+#include <atomic>
+#include <mutex>
+
+using namespace input;
+
+class MouseVirtual
+{
+public:
+    static MouseVirtual& get()
+    {
+        static MouseVirtual instance;
+        return instance;
+    }
+
+    Mouse::State getState() const
+    {
+        std::scoped_lock lock( m_Mutex );
+
+        Mouse::State state {};
+        state.positionMode = m_Mode;
+        state.leftButton   = isButtonDown( Mouse::Button::Left );
+        state.middleButton = isButtonDown( Mouse::Button::Middle );
+        state.rightButton  = isButtonDown( Mouse::Button::Right );
+        state.xButton1     = isButtonDown( Mouse::Button::XButton1 );
+        state.xButton2     = isButtonDown( Mouse::Button::XButton2 );
+
+        if ( m_Mode == Mouse::Mode::Absolute )
+        {
+            state.x = m_X;
+            state.y = m_Y;
+        }
+        else  // Relative mode
+        {
+            state.x = m_RelativeX;
+            state.y = m_RelativeY;
+        }
+
+        state.scrollWheelValue = m_ScrollWheelValue;
+
+        return state;
+    }
+
+    void setState( const Mouse::State& state ) noexcept
+    {
+        std::scoped_lock lock( m_Mutex );
+
+        m_Buttons = 0;
+        setButton( Mouse::Button::Left, state.leftButton );
+        setButton( Mouse::Button::Middle, state.middleButton );
+        setButton( Mouse::Button::Right, state.rightButton );
+        setButton( Mouse::Button::XButton1, state.xButton1 );
+        setButton( Mouse::Button::XButton2, state.xButton2 );
+
+        m_X                = state.x;
+        m_Y                = state.y;
+        m_ScrollWheelValue = state.scrollWheelValue;
+    }
+
+    void apply( const Event& event ) noexcept
+    {
+        std::scoped_lock lock( m_Mutex );
+
+        switch ( event.type )
+        {
+        case EventType::MouseButtonDown:
+        case EventType::MouseButtonUp:
+            setButton( event.mouseButton.button, event.type == EventType::MouseButtonDown );
+            break;
+        case EventType::MouseMotion:
+            m_X = event.mouseMotion.x;
+            m_Y = event.mouseMotion.y;
+
+            if ( m_Mode == Mouse::Mode::Relative )
+            {
+                m_AccumulateX += event.mouseMotion.deltaX;
+                m_AccumulateY += event.mouseMotion.deltaY;
+            }
+
+            m_Motion.add( { event.timestamp, event.mouseMotion.x, event.mouseMotion.y, event.mouseMotion.deltaX, event.mouseMotion.deltaY, m_Buttons } );
+            break;
+        case EventType::MouseWheel:
+            m_ScrollWheelValue += event.mouseWheel.delta;
+            break;
+        default:
+            break;
+        }
+    }
+
+    void getPosition( float& x, float& y ) const noexcept
+    {
+        std::scoped_lock lock( m_Mutex );
+        x = m_X;
+        y = m_Y;
+    }
+
+    void resetScrollWheelValue() noexcept
+    {
+        std::scoped_lock lock( m_Mutex );
+        m_ScrollWheelValue = 0;
+    }
+
+    void setMode( Mouse::Mode mode )
+    {
+        std::scoped_lock lock( m_Mutex );
+        if ( m_Mode == mode )
+            return;
+
+        m_Mode = mode;
+        if ( mode == Mouse::Mode::Relative )
+        {
+            m_AccumulateX = m_RelativeX = 0;
+            m_AccumulateY = m_RelativeY = 0;
+        }
+    }
+
+    void resetRelativeMotion() noexcept
+    {
+        std::scoped_lock lock( m_Mutex );
+        m_Motion.endFrame();
+
+        if ( m_Mode == Mouse::Mode::Relative )
+        {
+            m_RelativeX = m_AccumulateX;
+            m_RelativeY = m_AccumulateY;
+
+            m_AccumulateX = 0.0f;
+            m_AccumulateY = 0.0f;
+        }
+    }
+
+    std::span<const Mouse::MotionSample> getMotionHistory() const noexcept
+    {
+        std::scoped_lock lock( m_Mutex );
+        return m_Motion.getSamples();
+    }
+
+    uint32_t getDroppedMotionSamples() const noexcept
+    {
+        std::scoped_lock lock( m_Mutex );
+        return m_Motion.getDroppedCount();
+    }
+
+    bool isVisible() const noexcept
+    {
+        return m_Visible;
+    }
+
+    void setVisible( bool visible ) noexcept
+    {
+        m_Visible = visible;
+    }
+
+    void reset() noexcept
+    {
+        std::scoped_lock lock( m_Mutex );
+
+        m_Buttons          = 0;
+        m_X                = 0.0f;
+        m_Y                = 0.0f;
+        m_AccumulateX      = 0.0f;
+        m_AccumulateY      = 0.0f;
+        m_RelativeX        = 0.0f;
+        m_RelativeY        = 0.0f;
+        m_ScrollWheelValue = 0;
+        m_Mode             = Mouse::Mode::Absolute;
+        m_Motion           = {};
+        m_Visible          = true;
+    }
+
+    MouseVirtual( const MouseVirtual& )            = delete;
+    MouseVirtual( MouseVirtual&& )                 = delete;
+    MouseVirtual& operator=( const MouseVirtual& ) = delete;
+    MouseVirtual& operator=( MouseVirtual&& )      = delete;
+
+private:
+    MouseVirtual()  = default;
+    ~MouseVirtual() = default;
+
+    bool isButtonDown( Mouse::Button button ) const noexcept
+    {
+        return ( m_Buttons >> static_cast<int>( button ) & 1 ) != 0;
+    }
+
+    void setButton( Mouse::Button button, bool down ) noexcept
+    {
+        const auto bit = static_cast<uint8_t>( 1u << static_cast<int>( button ) );
+        m_Buttons      = down ? m_Buttons | bit : m_Buttons & ~bit;
+    }
+
+    uint8_t              m_Buttons          = 0;  ///< Bit n is Mouse::Button n.
+    float                m_X                = 0.0f;
+    float                m_Y                = 0.0f;
+    float                m_AccumulateX      = 0.0f;
+    float                m_AccumulateY      = 0.0f;
+    float                m_RelativeX        = 0.0f;
+    float                m_RelativeY        = 0.0f;
+    int64_t              m_ScrollWheelValue = 0;
+    Mouse::Mode          m_Mode             = Mouse::Mode::Absolute;
+    std::atomic<bool>    m_Visible { true };
+    Mouse::MotionHistory m_Motion;
+    mutable Mutex        m_Mutex;
+};
+
+namespace input::Mouse
+{
+State getState()
+{
+    INPUT_PROFILE_SCOPE( MouseGetState );
+
+    return MouseVirtual::get().getState();
+}
+
+void resetScrollWheelValue() noexcept
+{
+    MouseVirtual::get().resetScrollWheelValue();
+}
+
+void setMode( Mode mode )
+{
+    MouseVirtual::get().setMode( mode );
+}
+
+void resetRelativeMotion() noexcept
+{
+    MouseVirtual::get().resetRelativeMotion();
+}
+
+std::span<const MotionSample> getMotionHistory() noexcept
+{
+    return MouseVirtual::get().getMotionHistory();
+}
+
+uint32_t getDroppedMotionSamples() noexcept
+{
+    return MouseVirtual::get().getDroppedMotionSamples();
+}
+
+bool isConnected()
+{
+    return true;
+}
+
+bool isVisible() noexcept
+{
+    return MouseVirtual::get().isVisible();
+}
+
+void setVisible( bool visible )
+{
+    MouseVirtual::get().setVisible( visible );
+}
+
+void setWindow( void* /*window*/ )
+{}
+
+}  // namespace input::Mouse
+
+void Virtual::detail::applyMouseEvent( const Event& event ) noexcept
+{
+    MouseVirtual::get().apply( event );
+}
+
+void Virtual::detail::resetMouse() noexcept
+{
+    MouseVirtual::get().reset();
+}
+
+void Virtual::setMouseButton( Mouse::Button button, bool down ) noexcept
+{
+    Event e {};
+    e.type               = down ? EventType::MouseButtonDown : EventType::MouseButtonUp;
+    e.timestamp          = getEventTime();
+    e.mouseButton.button = button;
+    MouseVirtual::get().getPosition( e.mouseButton.x, e.mouseButton.y );
+    pushEvent( e );
+}
+
+void Virtual::moveMouse( float x, float y ) noexcept
+{
+    float previousX, previousY;
+    MouseVirtual::get().getPosition( previousX, previousY );
+
+    Event e {};
+    e.type               = EventType::MouseMotion;
+    e.timestamp          = getEventTime();
+    e.mouseMotion.x      = x;
+    e.mouseMotion.y      = y;
+    e.mouseMotion.deltaX = x - previousX;
+    e.mouseMotion.deltaY = y - previousY;
+    pushEvent( e );
+}
+
+void Virtual::scrollMouse( int32_t delta ) noexcept
+{
+    Event e {};
+    e.type             = EventType::MouseWheel;
+    e.timestamp        = getEventTime();
+    e.mouseWheel.delta = delta;
+    pushEvent( e );
+}
+
+void Virtual::setMouseState( const Mouse::State& state ) noexcept
+{
+    MouseVirtual::get().setState( state );
+}
@@ -0,0 +1,180 @@
+#include <input/EventQueue.hpp>
+#include <input/Profiler.hpp>
+#include <input/Touch.hpp>
+#include <input/Virtual.hpp>
+
+#include <algorithm>
+#include <mutex>
+
+using namespace input;
+
+class TouchVirtual
+{
+public:
+    static TouchVirtual& get()
+    {
+        static TouchVirtual instance;
+        return instance;
+    }
+
+    Touch::State getState() const
+    {
+        std::scoped_lock lock( m_Mutex );
+
+        Touch::State state {};
+        state.touches = m_Touches;
+
+        return state;
+    }
+
+    void endFrame()
+    {
+        std::scoped_lock lock( m_Mutex );
+
+        // Remove touches that ended in the previous frame
+        erase_if( m_Touches,
+                  []( const Touch::TouchPoint& t ) {
+                      return t.phase == Touch::Phase::Ended || t.phase == Touch::Phase::Cancelled;
+                  } );
+
+        // Mark remaining touches as stationary (they will be updated to Moved if motion events occur)
+        for ( auto& touch: m_Touches )
+        {
+            if ( touch.phase != Touch::Phase::Began )
+            {
+                touch.phase = Touch::Phase::Stationary;
+            }
+        }
+    }
+
+    void apply( const Event& event ) noexcept
+    {
+        std::scoped_lock lock( m_Mutex );
+
+        const auto id = static_cast<uint64_t>( event.touch.id );
+
+        if ( event.type == EventType::TouchDown )
+        {
+            Touch::TouchPoint touch;
+            touch.id        = id;
+            touch.timestamp = event.timestamp;
+            touch.x         = event.touch.x;
+            touch.y         = event.touch.y;
+            touch.pressure  = event.touch.pressure;
+            touch.phase     = Touch::Phase::Began;
+            m_Touches.push_back( touch );
+            return;
+        }
+
+        auto it = std::ranges::find_if( m_Touches, [&]( const Touch::TouchPoint& t ) { return t.id == id; } );
+        if ( it == m_Touches.end() )
+            return;
+
+        it->x = event.touch.x;
+        it->y = event.touch.y;
+
+        if ( event.type == EventType::TouchMotion )
+        {
+            it->timestamp = event.timestamp;
+            it->pressure  = event.touch.pressure;
+            it->phase     = Touch::Phase::Moved;
+        }
+        else if ( event.type == EventType::TouchUp )
+        {
+            // Keep the touch for one more frame so it can be detected as Released.
+            // It will be removed when endFrame is called.
+            it->pressure = 0.0f;
+            it->phase    = Touch::Phase::Ended;
+        }
+    }
+
+    void reset() noexcept
+    {
+        std::scoped_lock lock( m_Mutex );
+        m_Touches.clear();
+    }
+
+    TouchVirtual( const TouchVirtual& )            = delete;
+    TouchVirtual( TouchVirtual&& )                 = delete;
+    TouchVirtual& operator=( const TouchVirtual& ) = delete;
+    TouchVirtual& operator=( TouchVirtual&& )      = delete;
+
+private:
+    TouchVirtual()  = default;
+    ~TouchVirtual() = default;
+
+    mutable Mutex    m_Mutex;
+    Touch::TouchList m_Touches;
+};
+
+namespace input::Touch
+{
+
+State getState()
+{
+    INPUT_PROFILE_SCOPE( TouchGetState );
+
+    return TouchVirtual::get().getState();
+}
+
+void endFrame()
+{
+    TouchVirtual::get().endFrame();
+}
+
+bool isSupported()
+{
+    return true;
+}
+
+int getDeviceCount()
+{
+    return 1;
+}
+
+}  // namespace input::Touch
+
+void Virtual::detail::applyTouchEvent( const Event& event ) noexcept
+{
+    TouchVirtual::get().apply( event );
+}
+
+void Virtual::detail::resetTouches() noexcept
+{
+    TouchVirtual::get().reset();
+}
+
+void Virtual::touchDown( int64_t id, float x, float y, float pressure ) noexcept
+{
+    Event e {};
+    e.type           = EventType::TouchDown;
+    e.timestamp      = getEventTime();
+    e.touch.id       = id;
+    e.touch.x        = x;
+    e.touch.y        = y;
+    e.touch.pressure = pressure;
+    pushEvent( e );
+}
+
+void Virtual::touchMove( int64_t id, float x, float y, float pressure ) noexcept
+{
+    Event e {};
+    e.type           = EventType::TouchMotion;
+    e.timestamp      = getEventTime();
+    e.touch.id       = id;
+    e.touch.x        = x;
+    e.touch.y        = y;
+    e.touch.pressure = pressure;
+    pushEvent( e );
+}
+
+void Virtual::touchUp( int64_t id, float x, float y ) noexcept
+{
+    Event e {};
+    e.type      = EventType::TouchUp;
+    e.timestamp = getEventTime();
+    e.touch.id  = id;
+    e.touch.x   = x;
+    e.touch.y   = y;
+    pushEvent( e );
+}
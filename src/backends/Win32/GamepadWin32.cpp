@@ -1,4 +1,5 @@
 #include <input/Gamepad.hpp>
+#include <input/Profiler.hpp>
 
 #include <windows.gaming.input.h>
 #include <wrl.h>
@@ -381,6 +382,8 @@ private:
 
 Gamepad::State Gamepad::getState( int playerIndex, DeadZone deadZoneMode )
 {
+    INPUT_PROFILE_SCOPE( GamepadGetState );
+
     return GamepadWin32::get().getState( playerIndex, deadZoneMode );
 }
 
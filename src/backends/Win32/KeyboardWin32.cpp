@@ -1,8 +1,11 @@
+#include <input/EventQueue.hpp>
 #include <input/Keyboard.hpp>
+#include <input/Profiler.hpp>
 
 #define WIN32_LEAN_AND_MEAN
 #include <Windows.h>
 
+#include <chrono>
 #include <cstring>
 
 using namespace input;
@@ -167,6 +170,8 @@ namespace input::Keyboard
 {
 State getState()
 {
+    INPUT_PROFILE_SCOPE( KeyboardGetState );
+
     return KeyboardWin32::get().getState();
 }
 
@@ -181,3 +186,15 @@ bool isConnected()
 }
 
 }  // namespace input::Keyboard
+
+uint64_t input::getEventTime() noexcept
+{
+    // The Win32 backend does not generate events, so use the same clock as the touch timestamps.
+    using namespace std::chrono;
+    return duration_cast<nanoseconds>( steady_clock::now().time_since_epoch() ).count();
+}
+
+void input::beginFrame() noexcept
+{
+    // The device states are read in getState.
+}
@@ -1,4 +1,5 @@
 #include <input/Mouse.hpp>
+#include <input/Profiler.hpp>
 
 #define WIN32_LEAN_AND_MEAN
 #include <Windows.h>
@@ -496,6 +497,8 @@ namespace input::Mouse
 {
 State getState()
 {
+    INPUT_PROFILE_SCOPE( MouseGetState );
+
     return MouseWin32::get().getState();
 }
 
@@ -514,6 +517,17 @@ void resetRelativeMotion() noexcept
     MouseWin32::get().resetRelativeMotion();
 }
 
+std::span<const MotionSample> getMotionHistory() noexcept
+{
+    // The motion history is not recorded by this backend.
+    return {};
+}
+
+uint32_t getDroppedMotionSamples() noexcept
+{
+    return 0;
+}
+
 bool isConnected()
 {
     return MouseWin32::isConnected();
@@ -1,4 +1,5 @@
 #include <algorithm>
+#include <input/Profiler.hpp>
 #include <input/Touch.hpp>
 
 #define WIN32_LEAN_AND_MEAN
@@ -8,7 +9,6 @@
 #include <chrono>
 #include <mutex>
 #include <system_error>
-#include <vector>
 
 using namespace input;
 
@@ -68,12 +68,12 @@ public:
     {
         uint64_t timestamp = getTimestamp();
         // Remove ended touches
-        std::erase_if( m_Touches,
-                       [timestamp]( const Touch::TouchPoint& t ) {
-                           return t.phase == Touch::Phase::Ended ||
-                                  t.phase == Touch::Phase::Cancelled ||
-                                  ( t.phase == Touch::Phase::Stationary && ( timestamp - t.timestamp ) > 1000000000ull );  // Stale touch points.
-                       } );
+        erase_if( m_Touches,
+                  [timestamp]( const Touch::TouchPoint& t ) {
+                      return t.phase == Touch::Phase::Ended ||
+                             t.phase == Touch::Phase::Cancelled ||
+                             ( t.phase == Touch::Phase::Stationary && ( timestamp - t.timestamp ) > 1000000000ull );  // Stale touch points.
+                  } );
 
         // Update phase for touches that haven't changed
         for ( auto& touch: m_Touches )
@@ -128,8 +128,8 @@ private:
 
     friend void Touch_ProcessMessage( UINT message, WPARAM wParam, LPARAM lParam );
 
-    std::mutex                     m_Mutex;
-    std::vector<Touch::TouchPoint> m_Touches;
+    Mutex                          m_Mutex;
+    Touch::TouchList               m_Touches;
     HWND                           m_Window { nullptr };
 };
 
@@ -247,6 +247,8 @@ namespace input::Touch
 
 State getState()
 {
+    INPUT_PROFILE_SCOPE( TouchGetState );
+
     return TouchWin32::get().getState();
 }
 
@@ -0,0 +1,39 @@
+#pragma once
+
+#include <cstdio>
+
+namespace input::test
+{
+
+/// <summary>
+/// The number of checks that failed in the test executable.
+/// </summary>
+inline int g_FailureCount = 0;
+
+/// <summary>
+/// Print the number of failed checks.
+/// </summary>
+/// <returns>The exit code of the test executable (non-zero if a check failed).</returns>
+inline int reportFailures()
+{
+    if ( g_FailureCount > 0 )
+    {
+        std::printf( "%d checks failed.\n", g_FailureCount );
+        return 1;
+    }
+
+    std::printf( "All checks passed.\n" );
+    return 0;
+}
+
+}  // namespace input::test
+
+#define CHECK( expr )                                                                \
+    do                                                                               \
+    {                                                                                \
+        if ( !( expr ) )                                                             \
+        {                                                                            \
+            std::printf( "%s:%d: CHECK( %s ) failed\n", __FILE__, __LINE__, #expr ); \
+            ++input::test::g_FailureCount;                                           \
+        }                                                                            \
+    } while ( false )
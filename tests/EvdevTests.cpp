@@ -0,0 +1,250 @@
+// Tests of the Evdev backend that stream `input_event` records through pipes (no device nodes are opened).
+// Usage: evdev_tests (returns a non-zero exit code if a check fails)
+
+#include "Check.hpp"
+
+#include <input/Evdev.hpp>
+#include <input/Gamepad.hpp>
+#include <input/Keyboard.hpp>
+#include <input/Mouse.hpp>
+#include <input/Touch.hpp>
+
+#include <fcntl.h>
+#include <unistd.h>
+
+#include <chrono>
+#include <initializer_list>
+#include <thread>
+#include <vector>
+
+using namespace input;
+
+namespace
+{
+
+struct Code
+{
+    uint16_t type;
+    uint16_t code;
+    int32_t  value;
+};
+
+uint64_t g_Time = 1'000'000'000;
+
+// Add the read end of a pipe as a device.
+int addPipe( const Evdev::DeviceInfo& info, int& writeEnd )
+{
+    int fds[2];
+    if ( pipe2( fds, O_CLOEXEC ) != 0 )
+        return -1;
+
+    writeEnd = fds[1];
+    return Evdev::addDevice( fds[0], info );
+}
+
+// Write the records of a frame (terminated by SYN_REPORT). The frame is written in two parts that split a
+// record, so the reader has to join the records of a stream.
+void writeFrame( int fd, std::initializer_list<Code> codes )
+{
+    g_Time += 16'000'000;
+
+    std::vector<input_event> events;
+    for ( const Code& c: codes )
+    {
+        input_event& event     = events.emplace_back();
+        event.input_event_sec  = static_cast<decltype( event.input_event_sec )>( g_Time / 1'000'000'000 );
+        event.input_event_usec = static_cast<decltype( event.input_event_usec )>( g_Time % 1'000'000'000 / 1'000 );
+        event.type             = c.type;
+        event.code             = c.code;
+        event.value            = c.value;
+    }
+
+    input_event& report = events.emplace_back( events.front() );
+    report.type         = EV_SYN;
+    report.code         = SYN_REPORT;
+    report.value        = 0;
+
+    const auto*  bytes = reinterpret_cast<const char*>( events.data() );
+    const size_t size  = events.size() * sizeof( input_event );
+    const size_t split = sizeof( input_event ) / 2;
+
+    CHECK( write( fd, bytes, split ) == static_cast<ssize_t>( split ) );
+    CHECK( write( fd, bytes + split, size - split ) == static_cast<ssize_t>( size - split ) );
+}
+
+// The devices are read by a background thread, so wait until it has applied the records.
+template<typename Predicate>
+bool waitFor( Predicate predicate )
+{
+    const auto deadline = std::chrono::steady_clock::now() + std::chrono::seconds( 5 );
+    while ( !predicate() )
+    {
+        if ( std::chrono::steady_clock::now() > deadline )
+            return false;
+
+        std::this_thread::sleep_for( std::chrono::milliseconds( 1 ) );
+    }
+
+    return true;
+}
+
+void testKeyboard()
+{
+    Evdev::DeviceInfo info;
+    info.keyboard = true;
+
+    int fd = -1;
+    CHECK( addPipe( info, fd ) >= 0 );
+    CHECK( waitFor( [] { return Keyboard::isConnected(); } ) );
+
+    writeFrame( fd, { { EV_KEY, KEY_LEFTSHIFT, 1 }, { EV_KEY, KEY_A, 1 } } );
+    CHECK( waitFor( [] { return Keyboard::getState().isKeyDown( Keyboard::Key::A ); } ) );
+
+    Keyboard::State state = Keyboard::getState();
+    CHECK( state.LeftShift );
+    CHECK( state.ShiftKey );
+    CHECK( !state.B );
+
+    // A key repeat (value 2) does not change the state.
+    writeFrame( fd, { { EV_KEY, KEY_A, 2 }, { EV_KEY, KEY_A, 0 } } );
+    CHECK( waitFor( [] { return !Keyboard::getState().isKeyDown( Keyboard::Key::A ); } ) );
+    CHECK( Keyboard::getState().LeftShift );
+
+    // The device is removed at the end of the stream, with the keys that were still held.
+    close( fd );
+    CHECK( waitFor( [] { return !Keyboard::isConnected(); } ) );
+    CHECK( !Keyboard::getState().LeftShift );
+}
+
+void testMouse()
+{
+    Evdev::DeviceInfo info;
+    info.mouse = true;
+
+    int fd = -1;
+    CHECK( addPipe( info, fd ) >= 0 );
+    CHECK( waitFor( [] { return Mouse::isConnected(); } ) );
+
+    const Mouse::State initial = Mouse::getState();
+
+    // The position is the sum of the raw motion counts.
+    writeFrame( fd, { { EV_REL, REL_X, 10 }, { EV_REL, REL_Y, -5 } } );
+    writeFrame( fd, { { EV_REL, REL_X, 3 } } );
+    CHECK( waitFor( [&] { return Mouse::getState().x == initial.x + 13.0f; } ) );
+    CHECK( Mouse::getState().y == initial.y - 5.0f );
+
+    writeFrame( fd, { { EV_KEY, BTN_LEFT, 1 }, { EV_KEY, BTN_EXTRA, 1 } } );
+    CHECK( waitFor( [] { return Mouse::getState().leftButton; } ) );
+    CHECK( Mouse::getState().xButton2 );
+    CHECK( !Mouse::getState().rightButton );
+
+    writeFrame( fd, { { EV_REL, REL_WHEEL, -1 } } );
+    CHECK( waitFor( [&] { return Mouse::getState().scrollWheelValue == initial.scrollWheelValue - 120; } ) );
+
+    close( fd );
+    CHECK( waitFor( [] { return !Mouse::isConnected(); } ) );
+    CHECK( !Mouse::getState().leftButton );
+}
+
+void testGamepad()
+{
+    // The left trigger is analog, the right trigger is a button.
+    Evdev::DeviceInfo info;
+    info.gamepad          = true;
+    info.absRanges[ABS_X] = { 0, 255 };
+    info.absRanges[ABS_Y] = { 0, 255 };
+    info.absRanges[ABS_Z] = { 0, 255 };
+
+    int fd = -1;
+    CHECK( addPipe( info, fd ) >= 0 );
+    CHECK( waitFor( [] { return Gamepad::getState( 0 ).connected; } ) );
+
+    writeFrame( fd, { { EV_KEY, BTN_SOUTH, 1 }, { EV_ABS, ABS_HAT0X, -1 }, { EV_ABS, ABS_X, 255 }, { EV_ABS, ABS_Y, 0 } } );
+    CHECK( waitFor( [] { return Gamepad::getState( 0 ).buttons.a; } ) );
+
+    Gamepad::State state = Gamepad::getState( 0, Gamepad::DeadZone::None );
+    CHECK( state.dPad.left );
+    CHECK( !state.dPad.right );
+    CHECK( state.thumbSticks.leftX == 1.0f );
+    CHECK( state.thumbSticks.leftY == 1.0f );  // The Y axis of evdev points down.
+    CHECK( state.packet == 1 );
+
+    writeFrame( fd, { { EV_ABS, ABS_Z, 255 }, { EV_KEY, BTN_TR2, 1 }, { EV_KEY, BTN_SOUTH, 0 } } );
+    CHECK( waitFor( [] { return !Gamepad::getState( 0 ).buttons.a; } ) );
+
+    state = Gamepad::getState( 0 );
+    CHECK( state.triggers.left == 1.0f );
+    CHECK( state.triggers.right == 1.0f );
+    CHECK( state.packet == 2 );
+
+    close( fd );
+    CHECK( waitFor( [] { return !Gamepad::getState( 0 ).connected; } ) );
+}
+
+void testTouch()
+{
+    Evdev::DeviceInfo info;
+    info.touch                        = true;
+    info.absRanges[ABS_MT_SLOT]       = { 0, 9 };
+    info.absRanges[ABS_MT_POSITION_X] = { 0, 1000 };
+    info.absRanges[ABS_MT_POSITION_Y] = { 0, 500 };
+
+    int fd = -1;
+    CHECK( addPipe( info, fd ) >= 0 );
+    CHECK( waitFor( [] { return Touch::getDeviceCount() == 1; } ) );
+
+    // Multi-touch protocol B: two contacts in the slots 0 and 1.
+    writeFrame( fd, { { EV_ABS, ABS_MT_SLOT, 0 },
+                      { EV_ABS, ABS_MT_TRACKING_ID, 7 },
+                      { EV_ABS, ABS_MT_POSITION_X, 250 },
+                      { EV_ABS, ABS_MT_POSITION_Y, 100 },
+                      { EV_ABS, ABS_MT_SLOT, 1 },
+                      { EV_ABS, ABS_MT_TRACKING_ID, 8 },
+                      { EV_ABS, ABS_MT_POSITION_X, 1000 },
+                      { EV_ABS, ABS_MT_POSITION_Y, 500 } } );
+    CHECK( waitFor( [] { return Touch::getState().touches.size() == 2; } ) );
+
+    Touch::State state = Touch::getState();
+    CHECK( state.touches.size() == 2 && state.touches[0].id != state.touches[1].id );
+    CHECK( state.touches.size() == 2 && state.touches[0].x == 0.25f && state.touches[0].y == 0.2f );
+    CHECK( state.touches.size() == 2 && state.touches[1].x == 1.0f && state.touches[1].y == 1.0f );
+    CHECK( state.touches.size() == 2 && state.touches[0].phase == Touch::Phase::Began );
+    CHECK( state.touches.size() == 2 && state.touches[0].pressure == 1.0f );  // The device has no pressure axis.
+
+    // Slot 1 was selected last, so the motion of the first contact selects slot 0 again.
+    Touch::endFrame();
+    writeFrame( fd, { { EV_ABS, ABS_MT_SLOT, 0 }, { EV_ABS, ABS_MT_POSITION_X, 500 } } );
+    CHECK( waitFor( [] { return Touch::getState().touches[0].phase == Touch::Phase::Moved; } ) );
+    CHECK( Touch::getState().touches[0].x == 0.5f );
+
+    // Lift the second contact. It is reported as ended for one frame.
+    writeFrame( fd, { { EV_ABS, ABS_MT_SLOT, 1 }, { EV_ABS, ABS_MT_TRACKING_ID, -1 } } );
+    CHECK( waitFor( [] { return Touch::getState().touches[1].phase == Touch::Phase::Ended; } ) );
+
+    Touch::endFrame();
+    CHECK( Touch::getState().touches.size() == 1 );
+
+    // The remaining contact is cancelled when the device is removed.
+    close( fd );
+    CHECK( waitFor( [] { return Touch::getDeviceCount() == 0; } ) );
+    state = Touch::getState();
+    CHECK( state.touches.size() == 1 && state.touches[0].phase == Touch::Phase::Cancelled );
+
+    Touch::endFrame();
+    CHECK( Touch::getState().touches.empty() );
+}
+
+}  // namespace
+
+int main()
+{
+    // Only read the pipes, not the devices of the machine.
+    Evdev::setDeviceDirectory( "" );
+
+    testKeyboard();
+    testMouse();
+    testGamepad();
+    testTouch();
+
+    return test::reportFailures();
+}
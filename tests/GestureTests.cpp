@@ -0,0 +1,437 @@
+// Tests of the GestureRecognizer with synthetic touch states and explicit timestamps.
+// Usage: gesture_tests (returns a non-zero exit code if a check fails)
+
+#include "Check.hpp"
+
+#include <input/GestureRecognizer.hpp>
+
+#include <cmath>
+#include <cstdint>
+#include <span>
+
+using namespace input;
+
+namespace
+{
+
+constexpr uint64_t FRAME_TIME = 16;  // Milliseconds.
+
+bool near( float value, float expected, float tolerance = 1e-4f )
+{
+    return std::abs( value - expected ) <= tolerance;
+}
+
+/// <summary>
+/// A touch screen that updates a state tracker and a gesture recognizer, like InputContext::update.
+/// </summary>
+class TouchScreen
+{
+public:
+    void down( uint64_t id, float x, float y )
+    {
+        m_State.touches.push_back( { id, m_Time, x, y, 1.0f, Touch::Phase::Began } );
+    }
+
+    void move( uint64_t id, float x, float y )
+    {
+        for ( auto& touch: m_State.touches )
+        {
+            if ( touch.id == id )
+            {
+                touch.timestamp = m_Time;
+                touch.x         = x;
+                touch.y         = y;
+                touch.phase     = Touch::Phase::Moved;
+            }
+        }
+    }
+
+    void up( uint64_t id )
+    {
+        erase_if( m_State.touches, [&]( const Touch::TouchPoint& touch ) { return touch.id == id; } );
+    }
+
+    /// <summary>
+    /// Advance the time and update the recognizer.
+    /// </summary>
+    /// <returns>The gestures that were recognized in the update.</returns>
+    std::span<const GestureEvent> update( uint64_t milliseconds = FRAME_TIME )
+    {
+        m_Time += milliseconds * 1'000'000;
+        m_Tracker.update( m_State );
+        m_Gestures.update( m_Tracker, m_Time );
+
+        for ( auto& touch: m_State.touches )
+            touch.phase = Touch::Phase::Stationary;
+
+        return m_Gestures.getEvents();
+    }
+
+    const GestureRecognizer& getGestures() const noexcept
+    {
+        return m_Gestures;
+    }
+
+    size_t count( GestureType type ) const noexcept
+    {
+        size_t count = 0;
+        for ( const GestureEvent& event: m_Gestures.getEvents() )
+            count += event.type == type;
+
+        return count;
+    }
+
+    const GestureEvent* find( GestureType type ) const noexcept
+    {
+        for ( const GestureEvent& event: m_Gestures.getEvents() )
+        {
+            if ( event.type == type )
+                return &event;
+        }
+
+        return nullptr;
+    }
+
+private:
+    Touch::State      m_State;
+    TouchStateTracker m_Tracker;
+    GestureRecognizer m_Gestures;
+    uint64_t          m_Time = 1'000'000'000;
+};
+
+// Press and release a finger without moving it.
+void tap( TouchScreen& screen, uint64_t id, float x, float y, uint64_t duration = FRAME_TIME * 2 )
+{
+    screen.down( id, x, y );
+    screen.update();
+    screen.update( duration - FRAME_TIME );
+    screen.up( id );
+    screen.update();
+}
+
+void testTap()
+{
+    TouchScreen screen;
+
+    screen.down( 1, 0.5f, 0.5f );
+    CHECK( screen.update().empty() );
+    CHECK( screen.update().empty() );
+
+    screen.up( 1 );
+    screen.update();
+
+    const GestureEvent* event = screen.find( GestureType::Tap );
+    CHECK( event != nullptr );
+    CHECK( event && event->phase == GesturePhase::Ended && event->id == 1 );
+    CHECK( event && event->x == 0.5f && event->y == 0.5f );
+    CHECK( screen.count( GestureType::DoubleTap ) == 0 );
+}
+
+// A finger that is held longer than tapMaxDuration, or moves further than tapMaxDistance, does not tap.
+void testTapThresholds()
+{
+    TouchScreen screen;
+
+    tap( screen, 1, 0.5f, 0.5f, 300 );
+    CHECK( screen.count( GestureType::Tap ) == 0 );
+
+    screen.down( 2, 0.5f, 0.5f );
+    screen.update();
+    screen.move( 2, 0.53f, 0.5f );
+    screen.update();
+    screen.up( 2 );
+    screen.update();
+
+    CHECK( screen.count( GestureType::Tap ) == 0 );
+    CHECK( screen.count( GestureType::Swipe ) == 0 );
+}
+
+void testDoubleTap()
+{
+    TouchScreen screen;
+
+    tap( screen, 1, 0.5f, 0.5f );
+    CHECK( screen.count( GestureType::DoubleTap ) == 0 );
+
+    screen.update( 100 );
+    tap( screen, 2, 0.51f, 0.5f );
+
+    // The second tap reports both a tap and a double tap.
+    CHECK( screen.count( GestureType::Tap ) == 1 );
+    CHECK( screen.count( GestureType::DoubleTap ) == 1 );
+
+    const GestureEvent* event = screen.find( GestureType::DoubleTap );
+    CHECK( event && event->id == 2 && event->x == 0.51f );
+
+    // A third tap starts a new double tap.
+    tap( screen, 3, 0.5f, 0.5f );
+    CHECK( screen.count( GestureType::Tap ) == 1 );
+    CHECK( screen.count( GestureType::DoubleTap ) == 0 );
+}
+
+// A second tap that is released later than doubleTapMaxInterval, or further than doubleTapMaxDistance, is a new tap.
+void testDoubleTapThresholds()
+{
+    TouchScreen screen;
+
+    tap( screen, 1, 0.5f, 0.5f );
+    screen.update( 400 );
+    tap( screen, 2, 0.5f, 0.5f );
+
+    CHECK( screen.count( GestureType::Tap ) == 1 );
+    CHECK( screen.count( GestureType::DoubleTap ) == 0 );
+
+    screen.update( 400 );
+    tap( screen, 3, 0.5f, 0.5f );
+    tap( screen, 4, 0.6f, 0.5f );
+
+    CHECK( screen.count( GestureType::Tap ) == 1 );
+    CHECK( screen.count( GestureType::DoubleTap ) == 0 );
+}
+
+void testLongPress()
+{
+    TouchScreen screen;
+
+    screen.down( 1, 0.25f, 0.75f );
+    screen.update();
+    screen.update( 500 );
+
+    const GestureEvent* event = screen.find( GestureType::LongPress );
+    CHECK( event != nullptr );
+    CHECK( event && event->phase == GesturePhase::Ended && event->id == 1 );
+    CHECK( event && event->x == 0.25f && event->y == 0.75f );
+
+    screen.up( 1 );
+    screen.update();
+    screen.down( 2, 0.25f, 0.75f );
+    screen.update();
+
+    // The long press is reported once, in the update in which the finger has been held for longPressDuration.
+    for ( int i = 1; i <= 7; ++i )
+    {
+        screen.update( 100 );
+        CHECK( screen.count( GestureType::LongPress ) == ( i == 5 ? 1u : 0u ) );
+    }
+
+    // A long press is not a tap.
+    screen.up( 2 );
+    screen.update();
+    CHECK( screen.count( GestureType::Tap ) == 0 );
+    CHECK( screen.count( GestureType::LongPress ) == 0 );
+}
+
+// A finger that moves further than tapMaxDistance does not long press.
+void testLongPressThresholds()
+{
+    TouchScreen screen;
+
+    screen.down( 1, 0.5f, 0.5f );
+    screen.update();
+    screen.move( 1, 0.5f, 0.53f );
+    screen.update();
+    screen.move( 1, 0.5f, 0.5f );
+
+    for ( int i = 0; i < 8; ++i )
+    {
+        screen.update( 100 );
+        CHECK( screen.count( GestureType::LongPress ) == 0 );
+    }
+}
+
+void testSwipe()
+{
+    TouchScreen screen;
+
+    // Move 0.05 units every 16 milliseconds (3.125 units per second).
+    screen.down( 1, 0.2f, 0.5f );
+    screen.update();
+    for ( int i = 1; i <= 5; ++i )
+    {
+        screen.move( 1, 0.2f + 0.05f * static_cast<float>( i ), 0.5f );
+        CHECK( screen.update().empty() );
+    }
+
+    float velocityX, velocityY;
+    CHECK( screen.getGestures().getVelocity( 1, velocityX, velocityY ) );
+    CHECK( near( velocityX, 3.125f, 0.01f ) && velocityY == 0.0f );
+
+    // The release does not move the finger, so it does not slow it down.
+    screen.up( 1 );
+    screen.update();
+
+    const GestureEvent* event = screen.find( GestureType::Swipe );
+    CHECK( event != nullptr );
+    CHECK( event && event->phase == GesturePhase::Ended );
+    CHECK( event && near( event->deltaX, 0.25f ) && event->deltaY == 0.0f );
+    CHECK( event && near( event->velocityX, 3.125f, 0.01f ) && event->velocityY == 0.0f );
+    CHECK( event && near( event->x, 0.45f ) && event->y == 0.5f );
+    CHECK( screen.count( GestureType::Tap ) == 0 );
+}
+
+// A finger that moves less than swipeMinDistance, or slower than swipeMinVelocity, does not swipe.
+void testSwipeThresholds()
+{
+    TouchScreen screen;
+
+    screen.down( 1, 0.2f, 0.5f );
+    screen.update();
+    screen.move( 1, 0.28f, 0.5f );
+    screen.update();
+    screen.up( 1 );
+    screen.update();
+
+    CHECK( screen.count( GestureType::Swipe ) == 0 );
+
+    // Move 0.25 units in 2 seconds (0.125 units per second).
+    screen.down( 2, 0.2f, 0.5f );
+    screen.update();
+    for ( int i = 1; i <= 16; ++i )
+    {
+        screen.move( 2, 0.2f + 0.015625f * static_cast<float>( i ), 0.5f );
+        screen.update( 125 );
+    }
+    screen.up( 2 );
+    screen.update();
+
+    CHECK( screen.count( GestureType::Swipe ) == 0 );
+}
+
+void testPinch()
+{
+    TouchScreen screen;
+
+    screen.down( 1, 0.4f, 0.5f );
+    screen.down( 2, 0.6f, 0.5f );
+    screen.update();
+    CHECK( !screen.getGestures().isPinching() );
+    CHECK( screen.getGestures().getPinchScale() == 1.0f );
+
+    // The distance between the fingers grows from 0.2 to 0.3.
+    screen.move( 2, 0.7f, 0.5f );
+    screen.update();
+
+    const GestureEvent* event = screen.find( GestureType::Pinch );
+    CHECK( event != nullptr );
+    CHECK( event && event->phase == GesturePhase::Began && event->id == 1 );
+    CHECK( event && near( event->scale, 1.5f ) && near( event->x, 0.55f ) && event->y == 0.5f );
+    CHECK( screen.getGestures().isPinching() );
+    CHECK( near( screen.getGestures().getPinchScale(), 1.5f ) );
+    CHECK( screen.count( GestureType::Rotate ) == 0 );
+
+    screen.move( 1, 0.5f, 0.5f );
+    screen.update();
+
+    event = screen.find( GestureType::Pinch );
+    CHECK( event && event->phase == GesturePhase::Changed && near( event->scale, 1.0f ) );
+
+    // Releasing a finger ends the pinch, and the fingers of a pinch do not tap or swipe.
+    screen.up( 2 );
+    screen.update();
+
+    event = screen.find( GestureType::Pinch );
+    CHECK( event && event->phase == GesturePhase::Ended );
+    CHECK( !screen.getGestures().isPinching() );
+
+    screen.up( 1 );
+    CHECK( screen.update().empty() );
+}
+
+// The distance between the fingers must change by at least pinchMinDistance.
+void testPinchThresholds()
+{
+    TouchScreen screen;
+
+    screen.down( 1, 0.4f, 0.5f );
+    screen.down( 2, 0.6f, 0.5f );
+    screen.update();
+    screen.move( 2, 0.61f, 0.5f );
+    screen.update();
+
+    CHECK( screen.count( GestureType::Pinch ) == 0 );
+    CHECK( !screen.getGestures().isPinching() );
+    CHECK( screen.getGestures().getPinchScale() == 1.0f );
+}
+
+// Turn two fingers around the point between them (the distance between the fingers does not change).
+void turn( TouchScreen& screen, float angle )
+{
+    const float x = 0.1f * std::cos( angle );
+    const float y = 0.1f * std::sin( angle );
+
+    screen.move( 1, 0.5f - x, 0.5f - y );
+    screen.move( 2, 0.5f + x, 0.5f + y );
+    screen.update();
+}
+
+void testRotate()
+{
+    TouchScreen screen;
+
+    screen.down( 1, 0.4f, 0.5f );
+    screen.down( 2, 0.6f, 0.5f );
+    screen.update();
+
+    turn( screen, 0.3f );
+
+    const GestureEvent* event = screen.find( GestureType::Rotate );
+    CHECK( event != nullptr );
+    CHECK( event && event->phase == GesturePhase::Began && near( event->rotation, 0.3f ) );
+    CHECK( screen.getGestures().isRotating() );
+    CHECK( near( screen.getGestures().getRotation(), 0.3f ) );
+    CHECK( screen.count( GestureType::Pinch ) == 0 );
+
+    // The rotation accumulates past half a turn.
+    for ( int i = 1; i <= 10; ++i )
+        turn( screen, 0.3f + 0.3f * static_cast<float>( i ) );
+
+    CHECK( near( screen.getGestures().getRotation(), 3.3f, 1e-3f ) );
+
+    turn( screen, 3.6f );
+    event = screen.find( GestureType::Rotate );
+    CHECK( event && event->phase == GesturePhase::Changed && near( event->rotation, 3.6f, 1e-3f ) );
+
+    screen.up( 1 );
+    screen.update();
+
+    event = screen.find( GestureType::Rotate );
+    CHECK( event && event->phase == GesturePhase::Ended );
+    CHECK( !screen.getGestures().isRotating() );
+    CHECK( screen.getGestures().getRotation() == 0.0f );
+}
+
+// The angle between the fingers must change by at least rotateMinAngle.
+void testRotateThresholds()
+{
+    TouchScreen screen;
+
+    screen.down( 1, 0.4f, 0.5f );
+    screen.down( 2, 0.6f, 0.5f );
+    screen.update();
+
+    turn( screen, 0.05f );
+    turn( screen, -0.05f );
+
+    CHECK( screen.count( GestureType::Rotate ) == 0 );
+    CHECK( !screen.getGestures().isRotating() );
+}
+
+}  // namespace
+
+int main()
+{
+    testTap();
+    testTapThresholds();
+    testDoubleTap();
+    testDoubleTapThresholds();
+    testLongPress();
+    testLongPressThresholds();
+    testSwipe();
+    testSwipeThresholds();
+    testPinch();
+    testPinchThresholds();
+    testRotate();
+    testRotateThresholds();
+
+    return test::reportFailures();
+}
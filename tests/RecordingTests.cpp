@@ -0,0 +1,285 @@
+// Tests that the frames of a recording are read back bit for bit (in order, when seeking, and without an index).
+// Usage: recording_tests (returns a non-zero exit code if a check fails)
+
+#include "Check.hpp"
+
+#include <input/Recording.hpp>
+
+#include <algorithm>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <iterator>
+#include <string>
+#include <vector>
+
+using namespace input;
+
+namespace
+{
+
+constexpr uint64_t FRAME_COUNT       = 50;
+constexpr uint32_t KEYFRAME_INTERVAL = 4;
+
+// The offsets of the fields of the file header that are written when the recording is closed.
+constexpr size_t FRAME_COUNT_OFFSET  = 16;
+constexpr size_t INDEX_OFFSET_OFFSET = 24;
+
+// A deterministic pseudo-random number generator, so a failure can be reproduced.
+uint32_t g_Seed = 1;
+
+uint32_t nextRandom()
+{
+    g_Seed = g_Seed * 1664525u + 1013904223u;
+    return g_Seed >> 8;
+}
+
+float randomFloat()
+{
+    return static_cast<float>( nextRandom() % 20001 ) / 10000.0f - 1.0f;
+}
+
+Event makeEvent( EventType type, uint64_t timestamp )
+{
+    Event event {};
+    event.type      = type;
+    event.timestamp = timestamp;
+
+    switch ( type )
+    {
+    case EventType::KeyDown:
+    case EventType::KeyUp:
+        event.key.key = static_cast<Keyboard::Key>( nextRandom() % 256 );
+        break;
+    case EventType::MouseButtonDown:
+    case EventType::MouseButtonUp:
+        event.mouseButton = { static_cast<Mouse::Button>( nextRandom() % 5 ), randomFloat(), randomFloat() };
+        break;
+    case EventType::MouseMotion:
+        event.mouseMotion = { randomFloat(), randomFloat(), randomFloat(), randomFloat() };
+        break;
+    case EventType::MouseWheel:
+        event.mouseWheel.delta = static_cast<int32_t>( nextRandom() % 5 ) * 120 - 240;
+        break;
+    case EventType::GamepadButtonDown:
+    case EventType::GamepadButtonUp:
+        event.gamepadButton = { static_cast<int>( nextRandom() % Gamepad::MAX_PLAYER_COUNT ), static_cast<Gamepad::Button>( nextRandom() % static_cast<uint32_t>( Gamepad::Button::Count ) ) };
+        break;
+    case EventType::GamepadAxis:
+        event.gamepadAxis = { static_cast<int>( nextRandom() % Gamepad::MAX_PLAYER_COUNT ), static_cast<GamepadAxis>( nextRandom() % 6 ), randomFloat() };
+        break;
+    case EventType::TouchDown:
+    case EventType::TouchMotion:
+    case EventType::TouchUp:
+        event.touch = { static_cast<int64_t>( nextRandom() % 1000 ), randomFloat(), randomFloat(), randomFloat() };
+        break;
+    }
+
+    return event;
+}
+
+// Change a few values of the previous frame, so the frames between the keyframes are stored as deltas.
+void makeFrame( uint64_t index, RecordedFrame& frame )
+{
+    frame.timestamp = 1'000'000'000 + index * 16'666'667 + nextRandom() % 1000;
+
+    uint8_t keys[sizeof( Keyboard::State )];
+    std::memcpy( keys, &frame.keyboard, sizeof( keys ) );
+    keys[nextRandom() % sizeof( keys )] ^= static_cast<uint8_t>( 1 << nextRandom() % 8 );
+    std::memcpy( &frame.keyboard, keys, sizeof( keys ) );
+
+    frame.mouse.leftButton   = nextRandom() % 2 != 0;
+    frame.mouse.xButton2     = nextRandom() % 4 == 0;
+    frame.mouse.x            = randomFloat() * 1000.0f;
+    frame.mouse.y            = randomFloat() * 1000.0f;
+    frame.mouse.positionMode = index % 10 < 5 ? Mouse::Mode::Absolute : Mouse::Mode::Relative;
+
+    frame.mouse.scrollWheelValue += static_cast<int64_t>( nextRandom() % 3 ) * 120 - 120;
+
+    Gamepad::State& gamepad = frame.gamepads[index % Gamepad::MAX_PLAYER_COUNT];
+    gamepad.connected       = nextRandom() % 4 != 0;
+    gamepad.packet          = index;
+    UnpackGamepadButtons( nextRandom() & 0x3fff, gamepad );
+    gamepad.thumbSticks = { randomFloat(), randomFloat(), randomFloat(), randomFloat() };
+    gamepad.triggers    = { randomFloat() * 0.5f + 0.5f, randomFloat() * 0.5f + 0.5f };
+
+    frame.touch.touches.clear();
+    for ( uint32_t i = 0, count = nextRandom() % 4; i < count; ++i )
+        frame.touch.touches.push_back( { i + 1, frame.timestamp - i, randomFloat(), randomFloat(), 1.0f, static_cast<Touch::Phase>( nextRandom() % 5 ) } );
+
+    // The events are not sorted by time, so some differences to the previous event are negative.
+    frame.events.clear();
+    for ( uint32_t type = 0; type <= static_cast<uint32_t>( EventType::TouchUp ); ++type )
+    {
+        if ( nextRandom() % 3 == 0 )
+            frame.events.push_back( makeEvent( static_cast<EventType>( type ), frame.timestamp - nextRandom() % 16'000'000 ) );
+    }
+}
+
+void checkEvent( const Event& expected, const Event& actual )
+{
+    CHECK( actual.type == expected.type );
+    CHECK( actual.timestamp == expected.timestamp );
+
+    switch ( expected.type )
+    {
+    case EventType::KeyDown:
+    case EventType::KeyUp:
+        CHECK( actual.key.key == expected.key.key );
+        break;
+    case EventType::MouseButtonDown:
+    case EventType::MouseButtonUp:
+        CHECK( actual.mouseButton.button == expected.mouseButton.button );
+        CHECK( actual.mouseButton.x == expected.mouseButton.x );
+        CHECK( actual.mouseButton.y == expected.mouseButton.y );
+        break;
+    case EventType::MouseMotion:
+        CHECK( actual.mouseMotion.x == expected.mouseMotion.x );
+        CHECK( actual.mouseMotion.y == expected.mouseMotion.y );
+        CHECK( actual.mouseMotion.deltaX == expected.mouseMotion.deltaX );
+        CHECK( actual.mouseMotion.deltaY == expected.mouseMotion.deltaY );
+        break;
+    case EventType::MouseWheel:
+        CHECK( actual.mouseWheel.delta == expected.mouseWheel.delta );
+        break;
+    case EventType::GamepadButtonDown:
+    case EventType::GamepadButtonUp:
+        CHECK( actual.gamepadButton.player == expected.gamepadButton.player );
+        CHECK( actual.gamepadButton.button == expected.gamepadButton.button );
+        break;
+    case EventType::GamepadAxis:
+        CHECK( actual.gamepadAxis.player == expected.gamepadAxis.player );
+        CHECK( actual.gamepadAxis.axis == expected.gamepadAxis.axis );
+        CHECK( actual.gamepadAxis.value == expected.gamepadAxis.value );
+        break;
+    case EventType::TouchDown:
+    case EventType::TouchMotion:
+    case EventType::TouchUp:
+        CHECK( actual.touch.id == expected.touch.id );
+        CHECK( actual.touch.x == expected.touch.x );
+        CHECK( actual.touch.y == expected.touch.y );
+        CHECK( actual.touch.pressure == expected.touch.pressure );
+        break;
+    }
+}
+
+void checkFrame( const RecordedFrame& expected, const RecordedFrame& actual )
+{
+    CHECK( actual.timestamp == expected.timestamp );
+    CHECK( actual.keyboard == expected.keyboard );
+    CHECK( actual.mouse == expected.mouse );
+
+    for ( int player = 0; player < Gamepad::MAX_PLAYER_COUNT; ++player )
+    {
+        const Gamepad::State& e = expected.gamepads[player];
+        const Gamepad::State& a = actual.gamepads[player];
+
+        CHECK( a.connected == e.connected );
+        CHECK( a.packet == e.packet );
+        CHECK( PackGamepadButtons( a ) == PackGamepadButtons( e ) );
+        CHECK( std::memcmp( &a.thumbSticks, &e.thumbSticks, sizeof( e.thumbSticks ) ) == 0 );
+        CHECK( std::memcmp( &a.triggers, &e.triggers, sizeof( e.triggers ) ) == 0 );
+    }
+
+    CHECK( actual.touch == expected.touch );
+
+    CHECK( actual.events.size() == expected.events.size() );
+    for ( size_t i = 0; i < std::min( actual.events.size(), expected.events.size() ); ++i )
+        checkEvent( expected.events[i], actual.events[i] );
+}
+
+void checkRead( RecordingReader& reader, const std::vector<RecordedFrame>& frames, uint64_t index )
+{
+    RecordedFrame frame;
+    CHECK( reader.read( index, frame ) );
+    checkFrame( frames[index], frame );
+}
+
+std::vector<char> readFile( const std::filesystem::path& path )
+{
+    std::ifstream file( path, std::ios::binary );
+    return { std::istreambuf_iterator<char>( file ), std::istreambuf_iterator<char>() };
+}
+
+void writeFile( const std::filesystem::path& path, const std::vector<char>& data, size_t size )
+{
+    std::ofstream file( path, std::ios::binary | std::ios::trunc );
+    file.write( data.data(), static_cast<std::streamsize>( size ) );
+}
+
+void testRecording( const std::filesystem::path& directory )
+{
+    const std::filesystem::path path = directory / "input_recording_test.irec";
+
+    std::vector<RecordedFrame> frames( FRAME_COUNT );
+    RecordedFrame              frame;
+    for ( uint64_t i = 0; i < FRAME_COUNT; ++i )
+    {
+        makeFrame( i, frame );
+        frames[i] = frame;
+    }
+
+    RecordingWriter writer;
+    CHECK( writer.open( path.string(), KEYFRAME_INTERVAL ) );
+    for ( const RecordedFrame& f: frames )
+        writer.write( f );
+    CHECK( writer.getFrameCount() == FRAME_COUNT );
+    writer.close();
+
+    RecordingReader reader;
+    CHECK( reader.open( path.string() ) );
+    CHECK( reader.getFrameCount() == FRAME_COUNT );
+
+    // In order.
+    for ( uint64_t i = 0; i < FRAME_COUNT; ++i )
+        checkRead( reader, frames, i );
+
+    // Backwards (each read starts at an earlier keyframe), and forwards across keyframes.
+    for ( uint64_t i = FRAME_COUNT; i-- > 0; )
+        checkRead( reader, frames, i );
+
+    for ( uint64_t index: { 45u, 3u, 0u, 13u, 12u, 11u, 30u, 49u, 1u } )
+        checkRead( reader, frames, index );
+
+    CHECK( !reader.read( FRAME_COUNT, frame ) );
+    reader.close();
+
+    // A recording that was not closed has no frame count, no index offset, and no index.
+    std::vector<char> data = readFile( path );
+    uint64_t          indexOffset;
+    std::memcpy( &indexOffset, data.data() + INDEX_OFFSET_OFFSET, sizeof( indexOffset ) );
+    std::memset( data.data() + FRAME_COUNT_OFFSET, 0, sizeof( uint64_t ) * 2 );
+    CHECK( indexOffset > 0 && indexOffset < data.size() );
+
+    const std::filesystem::path unclosedPath = directory / "input_recording_test_unclosed.irec";
+    writeFile( unclosedPath, data, static_cast<size_t>( indexOffset ) );
+
+    CHECK( reader.open( unclosedPath.string() ) );
+    CHECK( reader.getFrameCount() == FRAME_COUNT );
+    for ( uint64_t i = 0; i < FRAME_COUNT; ++i )
+        checkRead( reader, frames, i );
+    checkRead( reader, frames, 6 );
+    reader.close();
+
+    // The last frame of a recording that was interrupted while it was written is incomplete, so it is ignored.
+    writeFile( unclosedPath, data, static_cast<size_t>( indexOffset ) - 3 );
+
+    CHECK( reader.open( unclosedPath.string() ) );
+    CHECK( reader.getFrameCount() == FRAME_COUNT - 1 );
+    for ( uint64_t i = FRAME_COUNT - 1; i-- > 0; )
+        checkRead( reader, frames, i );
+    CHECK( !reader.read( FRAME_COUNT - 1, frame ) );
+    reader.close();
+
+    std::filesystem::remove( path );
+    std::filesystem::remove( unclosedPath );
+}
+
+}  // namespace
+
+int main()
+{
+    testRecording( std::filesystem::temp_directory_path() );
+
+    return test::reportFailures();
+}
@@ -0,0 +1,154 @@
+// Tests of Input::update that inject input with the Virtual backend.
+// Usage: input_tests (returns a non-zero exit code if a check fails)
+
+#include "Check.hpp"
+
+#include <input/Input.hpp>
+#include <input/InputFrame.hpp>
+#include <input/Virtual.hpp>
+
+using namespace input;
+
+namespace
+{
+
+// Release all virtual devices and clear the edges of the previous test.
+void reset()
+{
+    Virtual::reset();
+    Input::update();
+    Input::update();
+}
+
+// A key that is pressed and released between two updates is reported as pressed and released.
+void testSubFrameKeyTap()
+{
+    reset();
+
+    Virtual::setKey( Keyboard::Key::Space, true );
+    Virtual::setKey( Keyboard::Key::Space, false );
+    Input::update();
+
+    CHECK( !Input::getKey( Keyboard::Key::Space ) );
+    CHECK( Input::getKeyDown( Keyboard::Key::Space ) );
+    CHECK( Input::getKeyUp( Keyboard::Key::Space ) );
+    CHECK( Input::getPressCount( Keyboard::Key::Space ) == 1 );
+
+    // The edges are only reported in the frame of the tap.
+    Input::update();
+
+    CHECK( !Input::getKeyDown( Keyboard::Key::Space ) );
+    CHECK( !Input::getKeyUp( Keyboard::Key::Space ) );
+    CHECK( Input::getPressCount( Keyboard::Key::Space ) == 0 );
+}
+
+void testSubFrameDoubleTap()
+{
+    reset();
+
+    for ( int i = 0; i < 2; ++i )
+    {
+        Virtual::setKey( Keyboard::Key::Enter, true );
+        Virtual::setKey( Keyboard::Key::Enter, false );
+    }
+    Input::update();
+
+    CHECK( Input::getKeyDown( Keyboard::Key::Enter ) );
+    CHECK( Input::getKeyUp( Keyboard::Key::Enter ) );
+    CHECK( Input::getPressCount( Keyboard::Key::Enter ) == 2 );
+}
+
+void testSubFrameMouseClick()
+{
+    reset();
+
+    Virtual::setMouseButton( Mouse::Button::Left, true );
+    Virtual::setMouseButton( Mouse::Button::Left, false );
+    Input::update();
+
+    CHECK( !Input::getMouseButton( Mouse::Button::Left ) );
+    CHECK( Input::getMouseButtonDown( Mouse::Button::Left ) );
+    CHECK( Input::getMouseButtonUp( Mouse::Button::Left ) );
+    CHECK( Input::getPressCount( Mouse::Button::Left ) == 1 );
+}
+
+// Gamepad button events that are shorter than a frame are counted like key events.
+void testSubFrameGamepadTap()
+{
+    reset();
+
+    Virtual::connectGamepad( 0 );
+    for ( int i = 0; i < 2; ++i )
+    {
+        Virtual::setGamepadButton( 0, Gamepad::Button::A, true );
+        Virtual::setGamepadButton( 0, Gamepad::Button::A, false );
+    }
+    Input::update();
+
+    CHECK( !Input::getButton( "joystick button 1" ) );
+    CHECK( Input::getButtonDown( "joystick button 1" ) );
+    CHECK( Input::getButtonUp( "joystick button 1" ) );
+    CHECK( Input::getPressCount( "joystick button 1" ) == 2 );
+
+    Input::update();
+
+    CHECK( !Input::getButtonDown( "joystick button 1" ) );
+    CHECK( !Input::getButtonUp( "joystick button 1" ) );
+    CHECK( Input::getPressCount( "joystick button 1" ) == 0 );
+}
+
+// A key that is held across the update is pressed once, and released in a later frame.
+void testHeldKey()
+{
+    reset();
+
+    Virtual::setKey( Keyboard::Key::A, true );
+    Input::update();
+
+    CHECK( Input::getKey( Keyboard::Key::A ) );
+    CHECK( Input::getKeyDown( Keyboard::Key::A ) );
+    CHECK( !Input::getKeyUp( Keyboard::Key::A ) );
+    CHECK( Input::getPressCount( Keyboard::Key::A ) == 1 );
+
+    Virtual::setKey( Keyboard::Key::A, false );
+    Input::update();
+
+    CHECK( !Input::getKey( Keyboard::Key::A ) );
+    CHECK( !Input::getKeyDown( Keyboard::Key::A ) );
+    CHECK( Input::getKeyUp( Keyboard::Key::A ) );
+}
+
+// The timestamps of the key events are kept for the frame in which the key changed.
+void testPressTime()
+{
+    reset();
+
+    Virtual::setTime( 1000 );
+    Virtual::setKey( Keyboard::Key::B, true );
+    Virtual::advanceTime( 500 );
+    Virtual::setKey( Keyboard::Key::B, false );
+    Input::update();
+
+    CHECK( Input::getFrame().keyboardState.getPressTime( Keyboard::Key::B ) == 1000 );
+    CHECK( Input::getFrame().keyboardState.getReleaseTime( Keyboard::Key::B ) == 1500 );
+    CHECK( Input::getFrame().keyboardState.getPressTime( Keyboard::Key::C ) == 0 );
+
+    Input::update();
+
+    CHECK( Input::getFrame().keyboardState.getPressTime( Keyboard::Key::B ) == 0 );
+    CHECK( Input::getFrame().keyboardState.getReleaseTime( Keyboard::Key::B ) == 0 );
+}
+
+}  // namespace
+
+int main()
+{
+    testSubFrameKeyTap();
+    testSubFrameDoubleTap();
+    testSubFrameMouseClick();
+    testSubFrameGamepadTap();
+    testHeldKey();
+    testPressTime();
+
+    return test::reportFailures();
+}